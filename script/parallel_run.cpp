@@ -1,276 +1,559 @@
 #include <bits/stdc++.h>
 #include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
-#include <dirent.h>
-#include <unistd.h>
-#include <stdlib.h>
+#include <sys/time.h>
 #include <sys/wait.h>
+#include <unistd.h>
 
 using namespace std;
 
+extern char **environ;
+
+/*
+  Benchmark runner.
+
+  Every job is started with posix_spawn in its own process group. The spawned
+  process is this binary in shim mode (--exec-limited), which applies the CPU
+  and address space limits with setrlimit and then execs the solver, so the
+  limits hold from the first instruction of the solver. Wall time, CPU time
+  and peak RSS are taken from the wait4 rusage of the solver process.
+
+  Output layout (in <output_path>):
+    <name>.txt     stdout of the solver, first line is the result (as read by collect.py)
+    <name>.err     stderr of the solver (removed when empty)
+    journal.tsv    one line per finished job, used to resume an interrupted sweep
+    results.csv    collect.py schema; rows are streamed as jobs finish and the file
+                   is rewritten in list order, with the summary rows, once the sweep ends
+*/
+
 const string default_instance_list_path = "../QF_NRA/list.txt";
 const string default_solver_path = "../binary_solvers/z3";
 const string default_output_path = "../self_data";
 
-const string time_limit = "1200";
-const string memory_limit = "30720";
-const int max_process_num = 120;
+const char *shim_flag = "--exec-limited";
 
-string getPath(const string &str) {
-    int start = -1, end = -1;
-    for (int i = str.length() - 1; i >= 0; i--) {
-        if (str[i] == '.' && end == -1) {
-            end = i;
-        }
-        if (str[i] == '/' && start == -1) {
-            start = i;
-            break;
-        }
+struct Config {
+    string instance_list_path = default_instance_list_path;
+    string solver_path = default_solver_path;
+    string output_path = default_output_path;
+    string previous_csv;                  // schedule longest expected first using these results
+    vector<string> solver_args = {"-st"};
+    unsigned time_limit = 1200;           // CPU seconds
+    unsigned wall_limit = 0;              // seconds, 0 = time_limit + 60
+    unsigned memory_limit = 30720;        // MB of address space
+    unsigned max_process_num = max(1u, thread::hardware_concurrency());
+};
+
+struct Job {
+    string path;          // path as written in the list
+    string full_path;     // path handed to the solver
+    string name;          // file name without extension
+    string family;        // first component of path
+    unsigned index;       // position in the list
+    double expected;      // expected run time used for scheduling
+};
+
+struct Result {
+    string result;
+    double wall = 0, cpu = 0;
+    long max_rss_kb = 0;
+    int exit_code = 0;    // exit status, or -signal
+    double time = 0, memory = 0, conflict = 0, decision = 0, stage = 0;
+};
+
+// -----------------------------------
+//
+// shim: apply limits and exec the solver
+//
+// -----------------------------------
+
+[[noreturn]] void run_shim(int argc, char **argv) {
+    // argv: self --exec-limited <cpu seconds> <memory MB> <solver> <args>...
+    if (argc < 5) {
+        cerr << "invalid shim invocation" << endl;
+        _exit(127);
     }
-    return str.substr(start + 1, end - start - 1);
+    rlim_t cpu = strtoull(argv[2], nullptr, 10);
+    rlim_t mem = strtoull(argv[3], nullptr, 10) << 20;
+    struct rlimit rl;
+    // SIGXCPU at the soft limit, SIGKILL one second later
+    rl.rlim_cur = cpu;
+    rl.rlim_max = cpu + 1;
+    if (setrlimit(RLIMIT_CPU, &rl) != 0)
+        perror("setrlimit(RLIMIT_CPU)");
+    rl.rlim_cur = rl.rlim_max = mem;
+    if (setrlimit(RLIMIT_AS, &rl) != 0)
+        perror("setrlimit(RLIMIT_AS)");
+    execv(argv[4], argv + 4);
+    perror("execv");
+    _exit(127);
 }
 
-class System_Comand_Helper {
-private:
-    string cmd;
-public:
-    bool run() {
-        // cout << "## cmd: " << cmd << endl;
-        if (system(cmd.c_str()) != 0) {
-            cout << "system error: " << cmd << endl;
-            // exit(1);
-            return false;
-        }
-        return true;
+// -----------------------------------
+//
+// instance list, previous results, journal
+//
+// -----------------------------------
+
+string dir_name(const string &path) {
+    size_t pos = path.find_last_of('/');
+    return pos == string::npos ? "." : path.substr(0, pos);
+}
+
+string join_path(const string &dir, const string &file) {
+    if (!file.empty() && file[0] == '/') return file;
+    if (dir.empty() || dir.back() == '/') return dir + file;
+    return dir + "/" + file;
+}
+
+// 20161105-Sturm-MBO/mbo_E10E24.smt2 -> (mbo_E10E24, 20161105-Sturm-MBO), as in collect.py
+pair<string, string> process_name(const string &path) {
+    size_t first = path.find('/');
+    string family = path.substr(0, first);
+    size_t last = path.find_last_of('/');
+    string file = last == string::npos ? path : path.substr(last + 1);
+    size_t dot = file.find_last_of('.');
+    return {dot == string::npos ? file : file.substr(0, dot), family};
+}
+
+vector<string> split(const string &line, char sep) {
+    vector<string> res;
+    string cur;
+    stringstream ss(line);
+    while (getline(ss, cur, sep))
+        res.push_back(cur);
+    if (!line.empty() && line.back() == sep)
+        res.push_back("");
+    return res;
+}
+
+void get_jobs(const Config &cfg, vector<Job> &jobs) {
+    ifstream ifs(cfg.instance_list_path);
+    if (!ifs) {
+        cout << "cannot open instance list: " << cfg.instance_list_path << endl;
+        exit(1);
+    }
+    string base = dir_name(cfg.instance_list_path);
+    string word;
+    while (ifs >> word) {
+        Job job;
+        job.path = word;
+        // entries are relative to the list file, as in QF_NRA/list.txt
+        job.full_path = access(word.c_str(), R_OK) == 0 ? word : join_path(base, word);
+        tie(job.name, job.family) = process_name(word);
+        job.index = jobs.size();
+        job.expected = cfg.time_limit;
+        jobs.push_back(job);
+    }
+}
+
+// Expected run time of every (family, benchmark) in a CSV produced by collect.py.
+// Unsolved instances are expected to run into the time limit.
+void load_previous_times(const Config &cfg, map<pair<string, string>, double> &times) {
+    ifstream ifs(cfg.previous_csv);
+    if (!ifs) {
+        cout << "cannot open previous results: " << cfg.previous_csv << endl;
+        exit(1);
+    }
+    string line;
+    getline(ifs, line); // header
+    while (getline(ifs, line)) {
+        vector<string> cols = split(line, ',');
+        if (cols.size() < 4 || cols[0].empty())
+            break; // summary rows
+        const string &res = cols[2];
+        double t = (res == "sat" || res == "unsat") ? atof(cols[3].c_str()) : cfg.time_limit;
+        times[{cols[1], cols[0]}] = t;
     }
-    void run_mkdir_cmd(const string &dir_path) {
-        cmd = "mkdir -p " + dir_path;
-        run();
+}
+
+void schedule_jobs(const Config &cfg, vector<Job> &jobs) {
+    if (cfg.previous_csv.empty()) {
+        mt19937 mt(123);
+        shuffle(jobs.begin(), jobs.end(), mt);
+        return;
     }
-    void run_remove_cmd(const string & str) {
-        cmd = "rm -r " + str;
-        run();
+    map<pair<string, string>, double> times;
+    load_previous_times(cfg, times);
+    unsigned known = 0;
+    for (Job &job : jobs) {
+        auto it = times.find({job.family, job.name});
+        if (it != times.end()) {
+            job.expected = it->second;
+            ++known;
+        }
     }
-    void run_echo_string_cmd(const string &str, const string & path) {
-        stringstream ss;
-        ss << "echo " << str << " >>" + path;
-        cmd = ss.str();
-        run();
+    // longest expected first; instances without history are treated as hard
+    stable_sort(jobs.begin(), jobs.end(), [](const Job &a, const Job &b) { return a.expected > b.expected; });
+    cout << "scheduling with " << known << "/" << jobs.size() << " previous run times" << endl;
+}
+
+string journal_line(const Job &job, const Result &r) {
+    stringstream ss;
+    ss << job.path << '\t' << r.result << '\t' << r.wall << '\t' << r.cpu << '\t' << r.max_rss_kb << '\t'
+       << r.exit_code << '\t' << r.time << '\t' << r.memory << '\t' << r.conflict << '\t'
+       << r.decision << '\t' << r.stage;
+    return ss.str();
+}
+
+void load_journal(const string &path, map<string, Result> &done) {
+    ifstream ifs(path);
+    string line;
+    while (getline(ifs, line)) {
+        vector<string> cols = split(line, '\t');
+        if (cols.size() != 11)
+            continue; // torn write of an interrupted run
+        Result r;
+        r.result = cols[1];
+        r.wall = atof(cols[2].c_str());
+        r.cpu = atof(cols[3].c_str());
+        r.max_rss_kb = atol(cols[4].c_str());
+        r.exit_code = atoi(cols[5].c_str());
+        r.time = atof(cols[6].c_str());
+        r.memory = atof(cols[7].c_str());
+        r.conflict = atof(cols[8].c_str());
+        r.decision = atof(cols[9].c_str());
+        r.stage = atof(cols[10].c_str());
+        done[cols[0]] = r;
     }
+}
+
+string csv_row(const Job &job, const Result &r) {
+    stringstream ss;
+    ss << job.name << ',' << job.family << ',' << r.result << ',' << r.time << ',' << r.memory << ','
+       << r.conflict << ',' << r.decision << ',' << r.stage;
+    return ss.str();
+}
+
+const char *csv_header = "benchmark,family,result,time,memory,conflict,decision,stage";
 
-    void run_touch_cmd(const string & str){
-        stringstream ss;
-        ss << "touch " << str;
-        cmd = ss.str();
-        run();
+// Same rows and summary as collect.py, in list order.
+void write_final_csv(const string &path, const vector<Job> &jobs, const map<string, Result> &done) {
+    vector<const Job *> ordered(jobs.size());
+    for (const Job &job : jobs) ordered[job.index] = &job;
+    ofstream ofs(path + ".tmp");
+    ofs << csv_header << "\n";
+    unsigned total = 0, sat = 0, unsat = 0, timeout = 0, unknown = 0;
+    for (const Job *job : ordered) {
+        auto it = done.find(job->path);
+        if (it == done.end())
+            continue;
+        const Result &r = it->second;
+        ++total;
+        if (r.result == "timeout") ++timeout;
+        else if (r.result == "sat") ++sat;
+        else if (r.result == "unsat") ++unsat;
+        else ++unknown;
+        ofs << csv_row(*job, r) << "\n";
     }
+    ofs << "\n";
+    ofs << "total,sat,unsat,solved,timeout,unsolved\n";
+    ofs << total << ',' << sat << ',' << unsat << ',' << sat + unsat << ',' << timeout << ',' << unknown << "\n";
+    ofs.close();
+    rename((path + ".tmp").c_str(), path.c_str());
+    cout << "sat: " << sat << "\nunsat: " << unsat << "\nsolved: " << sat + unsat << "\ntotal: " << total << endl;
+}
 
-    void run_z3_cmd(const string &path) {
-        string rela_path = getPath(path);
-        string final_path = output_path + rela_path + ".txt";
-        run_touch_cmd(final_path);
-        stringstream ss;
-        ss << solver_path << " " << path;
-        ss << " -T:" << time_limit;
-        ss << " -memory:" << memory_limit;
-        ss << " -st > " + final_path;
-        cmd = ss.str();
-        if (!run()) {
-            run_echo_string_cmd("memoryout", final_path);
+// -----------------------------------
+//
+// classification of a finished job
+//
+// -----------------------------------
+
+double stat_value(const string &line) {
+    // " :time             0.10)" -> 0.10
+    stringstream ss(line);
+    string key, val;
+    ss >> key >> val;
+    if (!val.empty() && val.back() == ')') val.pop_back();
+    return atof(val.c_str());
+}
+
+void read_solver_output(const string &path, Result &r, bool &out_of_memory) {
+    ifstream ifs(path);
+    string line;
+    bool first = true;
+    while (getline(ifs, line)) {
+        if (first) {
+            r.result = line;
+            first = false;
         }
+        if (line.find("out of memory") != string::npos || line.find("bad_alloc") != string::npos)
+            out_of_memory = true;
+        stringstream ss(line);
+        string key;
+        ss >> key;
+        if (key == ":memory") r.memory = stat_value(line);
+        else if (key == ":time") r.time = stat_value(line);
+        else if (key == ":nlsat-conflicts") r.conflict = stat_value(line);
+        else if (key == ":nlsat-decisions") r.decision = stat_value(line);
+        else if (key == ":nlsat-stages") r.stage = stat_value(line);
     }
-};
+}
+
+// Replace the first line of the output file by the runner's verdict, keeping what the solver printed.
+void prepend_result(const string &path, const string &result) {
+    ifstream ifs(path);
+    stringstream old;
+    old << ifs.rdbuf();
+    ifs.close();
+    ofstream ofs(path);
+    ofs << result << "\n" << old.str();
+}
+
+void classify(const Config &cfg, const string &out_path, int status, bool wall_timeout, Result &r) {
+    bool out_of_memory = false;
+    r.result.clear();
+    read_solver_output(out_path, r, out_of_memory);
+    bool solver_verdict = r.result == "sat" || r.result == "unsat" || r.result == "unknown" || r.result == "timeout";
+    if (WIFEXITED(status))
+        r.exit_code = WEXITSTATUS(status);
+    else if (WIFSIGNALED(status))
+        r.exit_code = -WTERMSIG(status);
+    bool exited = WIFEXITED(status);
+    if (solver_verdict && exited)
+        ; // the solver's own answer, including its -T timeouts
+    else if (wall_timeout || (WIFSIGNALED(status) && (WTERMSIG(status) == SIGXCPU || (WTERMSIG(status) == SIGKILL && r.cpu >= cfg.time_limit))))
+        r.result = "timeout";
+    else if (out_of_memory || r.max_rss_kb >= (long)cfg.memory_limit * 1024 * 95 / 100)
+        r.result = "memoryout";
+    else
+        r.result = "crash";
+    if (!solver_verdict || !exited)
+        prepend_result(out_path, r.result);
+    // solvers without -st statistics: fall back to the measured values
+    if (r.time == 0) r.time = r.wall;
+    if (r.memory == 0) r.memory = r.max_rss_kb / 1024.0;
+}
 
-class Z3_Multiprocess_Runner {
+// -----------------------------------
+//
+// process pool
+//
+// -----------------------------------
+
+class Runner {
 private:
-    System_Comand_Helper &sch;
-    vector<string> &vec_job;
-    unsigned ite, siz;
-public:
-    Z3_Multiprocess_Runner(System_Comand_Helper &_sch, vector<string> &_vec_job)
-        : sch(_sch), vec_job(_vec_job), ite(0), siz(_vec_job.size()) {}
+    struct Running {
+        unsigned job;
+        chrono::steady_clock::time_point start;
+        bool killed = false;
+    };
+    const Config &cfg;
+    vector<Job> &jobs;
+    map<string, Result> &done;
+    string self_path;
+    ofstream journal, csv;
+    map<pid_t, Running> running;
+    unsigned finished = 0, todo = 0;
 
-    void init() {
-        ite = 0;
-        siz = vec_job.size();
+    string output_file(const Job &job, const char *ext) const {
+        return join_path(cfg.output_path, job.name + ext);
     }
-    bool has_next_job() {
-        if (ite >= siz) return false;
+
+    bool spawn(unsigned job_id) {
+        const Job &job = jobs[job_id];
+        string out = output_file(job, ".txt"), err = output_file(job, ".err");
+        string cpu = to_string(cfg.time_limit), mem = to_string(cfg.memory_limit);
+        vector<char *> argv;
+        argv.push_back(const_cast<char *>(self_path.c_str()));
+        argv.push_back(const_cast<char *>(shim_flag));
+        argv.push_back(const_cast<char *>(cpu.c_str()));
+        argv.push_back(const_cast<char *>(mem.c_str()));
+        argv.push_back(const_cast<char *>(cfg.solver_path.c_str()));
+        argv.push_back(const_cast<char *>(job.full_path.c_str()));
+        for (const string &a : cfg.solver_args)
+            argv.push_back(const_cast<char *>(a.c_str()));
+        argv.push_back(nullptr);
+
+        posix_spawn_file_actions_t fa;
+        posix_spawn_file_actions_init(&fa);
+        posix_spawn_file_actions_addopen(&fa, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+        posix_spawn_file_actions_addopen(&fa, STDOUT_FILENO, out.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        posix_spawn_file_actions_addopen(&fa, STDERR_FILENO, err.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        posix_spawnattr_t attr;
+        posix_spawnattr_init(&attr);
+        // own process group, so that a wall clock timeout also kills helpers of the solver;
+        // SIGCHLD is blocked in the runner and must not stay blocked in the child
+        sigset_t empty;
+        sigemptyset(&empty);
+        posix_spawnattr_setpgroup(&attr, 0);
+        posix_spawnattr_setsigmask(&attr, &empty);
+        posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGMASK);
+        pid_t pid;
+        int rc = posix_spawn(&pid, self_path.c_str(), &fa, &attr, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&fa);
+        posix_spawnattr_destroy(&attr);
+        if (rc != 0) {
+            cout << "posix_spawn failed: " << strerror(rc) << endl;
+            return false;
+        }
+        running[pid] = Running{job_id, chrono::steady_clock::now()};
         return true;
     }
-    unsigned get_cur_job_id() {
-        return ite;
-    }
-    void get_next_job() {
-        ++ite;
-    }
-    // void config_z3_parameters(const int &seed, const int &tl) {
-    //     time_limit = tl;
-    //     if (seed == -1) {
-    //         nlsat_shuffle_vars = false;
-    //         nlsat_seed = 0;
-    //     }
-    //     else {
-    //         nlsat_shuffle_vars = true;
-    //         nlsat_seed = seed;
-    //     }
-    // }
-    void child_process() {
-        const string &job = vec_job[ite];
-
-        stringstream ss;
-        ss << "file[" << ite << "] = " << job;
-        string tag = ss.str();
-
-        // config_z3_parameters(-1, 1200);
-        sch.run_z3_cmd(job);
-
-        cout << "finish: " << tag << endl;
-        exit(0);
+
+    void finish(pid_t pid, int status, const struct rusage &ru) {
+        Running run = running[pid];
+        running.erase(pid);
+        const Job &job = jobs[run.job];
+        Result r;
+        r.wall = chrono::duration<double>(chrono::steady_clock::now() - run.start).count();
+        r.cpu = ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 + ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+        r.max_rss_kb = ru.ru_maxrss;
+        classify(cfg, output_file(job, ".txt"), status, run.killed, r);
+        struct stat st;
+        string err = output_file(job, ".err");
+        if (stat(err.c_str(), &st) == 0 && st.st_size == 0)
+            unlink(err.c_str());
+        journal << journal_line(job, r) << endl;
+        csv << csv_row(job, r) << "\n" << flush;
+        done[job.path] = r;
+        ++finished;
+        cout << "finish [" << finished << "/" << todo << "]: " << job.path << " " << r.result
+             << " wall " << r.wall << " cpu " << r.cpu << " rss " << r.max_rss_kb / 1024 << "MB" << endl;
     }
-    void process_finished_child(const unsigned &job_id, const int &sta) {
-        if (sta != 0) {
-            stringstream ss;
-            ss << "file[" << job_id << "] = " << vec_job[job_id];
-            string tag = ss.str();
-            cout << "error: " << tag << endl;
+
+    void reap() {
+        int status;
+        struct rusage ru;
+        pid_t pid;
+        while ((pid = wait4(-1, &status, WNOHANG, &ru)) > 0) {
+            if (running.count(pid))
+                finish(pid, status, ru);
         }
-        else {
-            // cout << "main catch finish: " << tag << endl;
+    }
+
+    // Block until a child exits or the next wall clock deadline passes.
+    void wait_for_event(const sigset_t &sigchld) {
+        unsigned wall = cfg.wall_limit ? cfg.wall_limit : cfg.time_limit + 60;
+        auto now = chrono::steady_clock::now();
+        auto next = now + chrono::seconds(wall);
+        for (auto &kv : running) {
+            auto deadline = kv.second.start + chrono::seconds(wall);
+            if (!kv.second.killed && deadline <= now) {
+                kill(-kv.first, SIGKILL);
+                kv.second.killed = true;
+            }
+            else if (!kv.second.killed)
+                next = min(next, deadline);
         }
+        auto wait = chrono::duration_cast<chrono::nanoseconds>(next - now).count();
+        struct timespec ts;
+        ts.tv_sec = wait / 1000000000;
+        ts.tv_nsec = wait % 1000000000;
+        sigtimedwait(&sigchld, nullptr, &ts);
     }
-};
-template<typename T>
-class Process_Pool {
-private:
-    unsigned max_proc_num;
-    map<unsigned, pid_t> dict_proc_id;
+
 public:
-    Process_Pool(unsigned _max_proc_num = 1234567) : max_proc_num(_max_proc_num) {}
-    void handle_finished_process(T &func) {
-        pid_t child_pid;
-        int sta;
-        for (const auto x : dict_proc_id) {
-            child_pid = waitpid(x.second, &sta, WNOHANG);
-            if (child_pid == 0) { // child process does not finish
-                // do nothing
-            }
-            else { // child process finished
-                // assert(child_pid == x.second);
-                func.process_finished_child(x.first, sta);
-                dict_proc_id.erase(x.first);
-                break;
-            }
-            // else if (child_pid > 0) { // child process finished
-            //     assert(child_pid == x.second);
-            //     func.process_finished_child(x.first, sta);
-            //     dict_proc_id.erase(x.second);
-            //     break;
-            // }
-            // else {
-            //     cout << "waitpid error [" << x.first << ", " << x.second << "], child_pid = " << child_pid << endl;
-            //     assert(false);
-            // }
+    Runner(const Config &_cfg, vector<Job> &_jobs, map<string, Result> &_done, const string &journal_path, const string &csv_path)
+        : cfg(_cfg), jobs(_jobs), done(_done) {
+        char buf[PATH_MAX];
+        ssize_t len = readlink("/proc/self/exe", buf, sizeof(buf) - 1);
+        if (len <= 0) {
+            cout << "cannot locate the runner binary" << endl;
+            exit(1);
         }
+        self_path.assign(buf, len);
+        journal.open(journal_path, ios::app);
+        bool fresh_csv = access(csv_path.c_str(), F_OK) != 0;
+        csv.open(csv_path, ios::app);
+        if (fresh_csv)
+            csv << csv_header << "\n" << flush;
     }
-    void solve(T &func) {
-        bool is_parent;
-        func.init();
-        while (true) {
-            is_parent = false;
-            if (!func.has_next_job())
-                break;
-            pid_t pid = fork();
-            if (pid == -1) {
-                cout << "fork failed" << endl;
-                exit(1);
-            }
-            if(pid == 0) {
-                func.child_process();
-                exit(0);
-            }
-            else {
-                unsigned job_id = func.get_cur_job_id();
-
-                // stringstream ss;
-                // ss << "file[" << job_id << "] = " << vec_job[job_id] << "pid = " << pid;
-                // string tag = ss.str();
-                // cout << "debug: " << tag << endl;
-                
-                dict_proc_id[job_id] = pid;
-                // sleep(1);
-                is_parent = true;
-                while (dict_proc_id.size() >= max_proc_num) {
-                    handle_finished_process(func);
-                    // sleep(1);
-                }
+
+    void solve() {
+        sigset_t sigchld;
+        sigemptyset(&sigchld);
+        sigaddset(&sigchld, SIGCHLD);
+        sigprocmask(SIG_BLOCK, &sigchld, nullptr);
+        vector<unsigned> pending;
+        for (unsigned i = 0; i < jobs.size(); i++)
+            if (!done.count(jobs[i].path))
+                pending.push_back(i);
+        todo = pending.size();
+        cout << "jobs: " << jobs.size() << ", already done: " << jobs.size() - todo << endl;
+        size_t next = 0;
+        while (next < pending.size() || !running.empty()) {
+            while (next < pending.size() && running.size() < cfg.max_process_num) {
+                if (!spawn(pending[next]))
+                    exit(1);
+                ++next;
             }
-            func.get_next_job();
-        }
-        if (!is_parent) return ;
-        while (!dict_proc_id.empty()) {
-            handle_finished_process(func);
-            // sleep(1);
+            wait_for_event(sigchld);
+            reap();
         }
     }
 };
 
-void get_jobs(System_Comand_Helper &sch, vector<string> &vec_job) {
-
-    ifstream ifs(instance_list_path);
-    string word;
-    while (ifs >> word) {
-        vec_job.emplace_back(word);
-    }
-}
-template<typename T>
-void shuffle_jobs(T &vec) {
-    mt19937 mt(123);
-    shuffle(vec.begin(), vec.end(), mt);
-}
-void solve() {
-    System_Comand_Helper sch;
-    vector<string> vec_job;
-    
-    // sch.run_mkdir_cmd(output_dir_pre_path);
-    get_jobs(sch, vec_job);
-
-    shuffle_jobs(vec_job);
-
-    // sch.run_mkdir_cmd(output_path);
-
-    cout << "vec file size: " << vec_job.size() << endl;
-    
-    // output_dir_path = output_dir_pre_path;
-
-    // sch.run_mkdir_cmd(output_dir_path);
-
-    // set<string> vis_set;
-    // for (const string &job : vec_job) {
-    //     string pre_path = get_file_pre_path(get_instance_output_path(job));
-    //     if (vis_set.count(pre_path) == 0) {
-    //         sch.run_mkdir_cmd(pre_path);
-    //         vis_set.emplace(pre_path);
-    //     }
-    // }
-
-    Process_Pool<Z3_Multiprocess_Runner> pp(max_process_num);
-    Z3_Multiprocess_Runner z3mr(sch, vec_job);
-    pp.solve(z3mr);
+void usage() {
+    cout << "Usage: ./parallel_run <instance_list_path> <solver_path> <output_path> [options] [-- solver args]\n"
+         << "  -j <n>      number of parallel jobs (default: number of cores)\n"
+         << "  -T <sec>    CPU time limit per instance (default: 1200)\n"
+         << "  -W <sec>    wall clock limit per instance (default: CPU time limit + 60)\n"
+         << "  -M <MB>     address space limit per instance (default: 30720)\n"
+         << "  -p <csv>    previous results (collect.py format), run the longest expected instances first\n"
+         << "  -- args     arguments passed to the solver after the instance (default: -st)\n"
+         << "Interrupted sweeps resume from <output_path>/journal.tsv." << endl;
 }
 
 int main(int argc, char **argv) {
-    if(argc < 4) {
-        cout << "Usage: ./parallel_run [instance_list_path] [solver_path] [output_path]" << endl;
+    if (argc > 1 && strcmp(argv[1], shim_flag) == 0)
+        run_shim(argc, argv);
+    if (argc < 4) {
+        usage();
+        return 1;
+    }
+    Config cfg;
+    cfg.instance_list_path = argv[1];
+    cfg.solver_path = argv[2];
+    cfg.output_path = argv[3];
+    for (int i = 4; i < argc; i++) {
+        string opt = argv[i];
+        if (opt == "--") {
+            cfg.solver_args.assign(argv + i + 1, argv + argc);
+            break;
+        }
+        if (i + 1 >= argc) {
+            usage();
+            return 1;
+        }
+        string val = argv[++i];
+        if (opt == "-j") cfg.max_process_num = max(1, atoi(val.c_str()));
+        else if (opt == "-T") cfg.time_limit = atoi(val.c_str());
+        else if (opt == "-W") cfg.wall_limit = atoi(val.c_str());
+        else if (opt == "-M") cfg.memory_limit = atoi(val.c_str());
+        else if (opt == "-p") cfg.previous_csv = val;
+        else {
+            usage();
+            return 1;
+        }
+    }
+    if (access(cfg.solver_path.c_str(), X_OK) != 0) {
+        cout << "solver is not executable: " << cfg.solver_path << endl;
+        return 1;
     }
-    string instance_list_path = argv[1];
-    string solver_path = argv[2];
-    string output_path = argv[3];
     struct stat st;
-    if (stat(output_path.c_str(), &st) == -1) {
-        cout << "mkdir " << output_path << endl;
-        mkdir(output_path.c_str(), 0700);
+    if (stat(cfg.output_path.c_str(), &st) == -1) {
+        cout << "mkdir " << cfg.output_path << endl;
+        mkdir(cfg.output_path.c_str(), 0700);
     }
-    solve();
+
+    vector<Job> jobs;
+    get_jobs(cfg, jobs);
+    schedule_jobs(cfg, jobs);
+
+    string journal_path = join_path(cfg.output_path, "journal.tsv");
+    string csv_path = join_path(cfg.output_path, "results.csv");
+    map<string, Result> done;
+    load_journal(journal_path, done);
+
+    Runner runner(cfg, jobs, done, journal_path, csv_path);
+    runner.solve();
+    write_final_csv(csv_path, jobs, done);
     return 0;
 }
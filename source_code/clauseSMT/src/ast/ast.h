@@ -1425,6 +1425,8 @@ enum proof_gen_mode {
 //
 // -----------------------------------
 
+class simplify_cache;
+
 class ast_manager {
     friend class basic_decl_plugin;
 protected:
@@ -1501,6 +1503,7 @@ protected:
 #endif
     ast_manager *             m_format_manager; // hack for isolating format objects in a different manager.
     symbol                    m_lambda_def;
+    simplify_cache *          m_simplify_cache = nullptr; // not owned, see rewriter.shared_cache
 
     void init();
 
@@ -1526,6 +1529,10 @@ public:
         ~suspend_trace() { m.m_trace_stream = m_tr; }
     };
 
+    // cache of simplification results shared by the rewriters of this manager, if any
+    void set_simplify_cache(simplify_cache * c) { m_simplify_cache = c; }
+    simplify_cache * get_simplify_cache() const { return m_simplify_cache; }
+
     void enable_int_real_coercions(bool f) { m_int_real_coercions = f; }
     bool int_real_coercions() const { return m_int_real_coercions; }
 
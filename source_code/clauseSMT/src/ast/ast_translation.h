@@ -41,6 +41,7 @@ class ast_translation {
     unsigned            m_miss_count;
     unsigned            m_insert_count;
     unsigned            m_num_process;
+    bool                m_frozen_from;
 
     void cache(ast * s, ast * t);
     void collect_decl_extra_children(decl * d);
@@ -53,12 +54,21 @@ class ast_translation {
     ast * process(ast const * n);
 
 public:
-    ast_translation(ast_manager & from, ast_manager & to, bool copy_plugins = true) : m_from_manager(from), m_to_manager(to) {
+    /**
+       \brief When frozen_from is true, the caller guarantees that the terms of
+       the source manager are not created or deleted while the translation
+       exists. The translation then does not update the reference counters of
+       the source terms, and several threads can translate concurrently from
+       the same source manager (with copy_plugins set to false).
+    */
+    ast_translation(ast_manager & from, ast_manager & to, bool copy_plugins = true, bool frozen_from = false) : m_from_manager(from), m_to_manager(to) {
         m_loop_count = 0;
         m_hit_count = 0;
         m_miss_count = 0;
         m_insert_count = 0;
         m_num_process = 0;
+        m_frozen_from = frozen_from;
+        SASSERT(!frozen_from || !copy_plugins);
         if (&from != &to) {
             if (copy_plugins)
                 m_to_manager.copy_families_plugins(m_from_manager);
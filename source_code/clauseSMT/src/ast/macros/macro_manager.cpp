@@ -24,6 +24,7 @@ Revision History:
 #include "ast/rewriter/var_subst.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/rewriter/rewriter_def.h"
+#include "ast/rewriter/simplify_cache.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_translation.h"
 #include "ast/recurse_expr_def.h"
@@ -150,6 +151,9 @@ bool macro_manager::insert(func_decl * f, quantifier * q, proof * pr, expr_depen
 
     TRACE("macro_insert", tout << "A macro was successfully created for: " << f->get_name() << "\n";);
 
+    if (m.get_simplify_cache())
+        m.get_simplify_cache()->invalidate();
+
     // Nothing's forbidden anymore; if something's bad, we detected it earlier.
     // mark_forbidden(m->get_expr());
     return true;
@@ -313,8 +313,10 @@ protected:
     template<bool ProofGen>
     void cache_result(expr * t, expr * new_t, proof * pr, bool c) {
         if (c) {
-            if (!ProofGen)
+            if (!ProofGen) {
                 rewriter_core::cache_result(t, new_t);
+                m_cfg.result_cached(t, new_t);
+            }
             else
                 rewriter_core::cache_result(t, new_t, pr);
         }
@@ -396,6 +398,8 @@ struct default_rewriter_cfg {
     bool get_macro(func_decl * d, expr * & def, quantifier * & q, proof * & def_pr) { return false; }
     bool reduce_macro() { return false; }
     bool get_subst(expr * s, expr * & t, proof * & t_pr) { return false; }
+    // called when the rewriter caches new_t as the result of t (only without proofs)
+    void result_cached(expr * t, expr * new_t) {}
     void reset() {}
     void cleanup() {}
 };
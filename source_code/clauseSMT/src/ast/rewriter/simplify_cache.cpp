@@ -0,0 +1,79 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    simplify_cache.cpp
+
+Abstract:
+
+    Cache of simplification results shared by the rewriters that use
+    the same manager.
+
+--*/
+#include "ast/rewriter/simplify_cache.h"
+
+simplify_cache::simplify_cache(ast_manager & m, unsigned max_size):
+    m(m),
+    m_pinned(m),
+    m_max_size(max_size) {
+}
+
+bool simplify_cache::find(expr * t, unsigned fingerprint, expr * & r) {
+    if (m_table.find(mk_key(t, fingerprint), r)) {
+        m_stats.m_hits++;
+        return true;
+    }
+    m_stats.m_misses++;
+    return false;
+}
+
+void simplify_cache::insert(expr * t, unsigned fingerprint, expr * r) {
+    if (m_max_size == 0)
+        return;
+    if (m_table.size() >= m_max_size) {
+        reset();
+        m_stats.m_flushes++;
+    }
+    // the key keeps a reference on t, so that its id is not reused by another term
+    uint64_t k = mk_key(t, fingerprint);
+    if (m_table.contains(k))
+        return;
+    m_table.insert(k, r);
+    m_pinned.push_back(t);
+    m_pinned.push_back(r);
+    m_stats.m_inserts++;
+}
+
+void simplify_cache::invalidate() {
+    if (m_table.empty())
+        return;
+    reset();
+    m_stats.m_invalidations++;
+}
+
+void simplify_cache::reset() {
+    m_table.reset();
+    m_pinned.reset();
+}
+
+void simplify_cache::collect_statistics(statistics & st) const {
+    st.update("rewriter shared cache hits", m_stats.m_hits);
+    st.update("rewriter shared cache misses", m_stats.m_misses);
+    st.update("rewriter shared cache inserts", m_stats.m_inserts);
+    st.update("rewriter shared cache flushes", m_stats.m_flushes);
+    st.update("rewriter shared cache invalidations", m_stats.m_invalidations);
+    unsigned lookups = m_stats.m_hits + m_stats.m_misses;
+    if (lookups > 0)
+        st.update("rewriter shared cache hit rate", static_cast<double>(m_stats.m_hits) / lookups);
+}
+
+scoped_simplify_cache::scoped_simplify_cache(simplify_cache & c):
+    m_cache(c) {
+    c.get_manager().set_simplify_cache(&c);
+}
+
+scoped_simplify_cache::~scoped_simplify_cache() {
+    m_cache.get_manager().set_simplify_cache(nullptr);
+    m_cache.reset();
+}
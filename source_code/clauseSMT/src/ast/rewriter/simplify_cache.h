@@ -0,0 +1,89 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    simplify_cache.h
+
+Abstract:
+
+    Cache of simplification results shared by the rewriters that use
+    the same manager.
+
+    The tactics of a chain create their own rewriters, and each rewriter
+    starts with an empty cache. When the cache is attached to the manager
+    (see rewriter.shared_cache), a rewriter stores the results of the ground
+    terms it simplifies, and the next rewriters with the same configuration
+    reuse them.
+
+    Entries are keyed by the term and a fingerprint of the configuration of
+    the rewriter. The cache holds references to the terms and results, and is
+    flushed when it reaches its maximal size or when the definitions that a
+    rewriter may expand (macros, recursive functions) change.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "util/map.h"
+#include "util/statistics.h"
+
+class simplify_cache {
+    struct stats {
+        unsigned m_hits;
+        unsigned m_misses;
+        unsigned m_inserts;
+        unsigned m_flushes;
+        unsigned m_invalidations;
+        stats() { reset(); }
+        void reset() { memset(this, 0, sizeof(*this)); }
+    };
+
+    ast_manager &   m;
+    u64_map<expr*>  m_table;
+    expr_ref_vector m_pinned;    // keys and results of m_table
+    unsigned        m_max_size;
+    stats           m_stats;
+
+    static uint64_t mk_key(expr * t, unsigned fingerprint) {
+        return (static_cast<uint64_t>(t->get_id()) << 32) | fingerprint;
+    }
+
+public:
+    simplify_cache(ast_manager & m, unsigned max_size = 1000000);
+
+    ast_manager & get_manager() const { return m; }
+
+    void set_max_size(unsigned max_size) { m_max_size = max_size; }
+
+    unsigned size() const { return m_table.size(); }
+
+    /**
+       \brief Store in r the result of simplifying t with a rewriter of the given
+       configuration, if it is known.
+    */
+    bool find(expr * t, unsigned fingerprint, expr * & r);
+
+    void insert(expr * t, unsigned fingerprint, expr * r);
+
+    /**
+       \brief Remove all entries, the definitions used by the rewriters changed.
+    */
+    void invalidate();
+
+    void reset();
+
+    void collect_statistics(statistics & st) const;
+    void reset_statistics() { m_stats.reset(); }
+};
+
+/**
+   \brief Attach the cache to its manager during the lifetime of this object.
+   The entries are removed when the cache is detached.
+*/
+class scoped_simplify_cache {
+    simplify_cache & m_cache;
+public:
+    scoped_simplify_cache(simplify_cache & c);
+    ~scoped_simplify_cache();
+};
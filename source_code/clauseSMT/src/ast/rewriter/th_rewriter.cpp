@@ -32,6 +32,7 @@ Notes:
 #include "ast/rewriter/rewriter_def.h"
 #include "ast/rewriter/var_subst.h"
 #include "ast/rewriter/expr_safe_replace.h"
+#include "ast/rewriter/simplify_cache.h"
 #include "ast/expr_substitution.h"
 #include "ast/ast_smt2_pp.h"
 #include "ast/ast_pp.h"
@@ -68,6 +69,9 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
     bool                m_push_ite_bv = true;
     bool                m_ignore_patterns_on_ground_qbody = true;
     bool                m_rewrite_patterns = true;
+    bool                m_shared_cache = false;
+    bool                m_has_solver = false;
+    unsigned            m_fingerprint = 0;   // hash of the parameters, identifies the configuration in the shared cache
 
 
     ast_manager & m() const { return m_b_rw.m(); }
@@ -83,6 +87,11 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         m_push_ite_bv    = p.push_ite_bv();
         m_ignore_patterns_on_ground_qbody = p.ignore_patterns_on_ground_qbody();
         m_rewrite_patterns = p.rewrite_patterns();
+        m_shared_cache   = p.shared_cache();
+        std::ostringstream strm;
+        _p.display(strm);
+        std::string const& s = strm.str();
+        m_fingerprint    = string_hash(s.c_str(), static_cast<unsigned>(s.size()), 17);
     }
 
     void updt_params(params_ref const & p) {
@@ -828,9 +837,28 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         m_subst = nullptr;
     }
 
+    // The results depend on the substitution and the solver, they are not shared.
+    simplify_cache * shared_cache() const {
+        if (!m_shared_cache || m_subst || m_has_solver || m().proofs_enabled())
+            return nullptr;
+        return m().get_simplify_cache();
+    }
+
+    static bool is_shareable(expr * t) {
+        return is_app(t) && to_app(t)->get_num_args() > 0 && is_ground(t);
+    }
+
+    void result_cached(expr * t, expr * new_t) {
+        simplify_cache * c = shared_cache();
+        if (c && is_shareable(t))
+            c->insert(t, m_fingerprint, new_t);
+    }
+
     bool get_subst(expr * s, expr * & t, proof * & pr) {
-        if (m_subst == nullptr)
-            return false;
+        if (m_subst == nullptr) {
+            simplify_cache * c = shared_cache();
+            return c && is_shareable(s) && c->find(s, m_fingerprint, t);
+        }
         expr_dependency * d = nullptr;
         if (m_subst->find(s, t, pr, d)) {
             m_used_dependencies = m().mk_join(m_used_dependencies, d);
@@ -855,6 +883,7 @@ struct th_rewriter::imp : public rewriter_tpl<th_rewriter_cfg> {
 
     void set_solver(expr_solver* solver) {
         m_cfg.m_seq_rw.set_solver(solver);
+        m_cfg.m_has_solver = solver != nullptr;
     }
 };
 
@@ -906,12 +935,14 @@ void th_rewriter::reset() {
 
 void th_rewriter::operator()(expr_ref & term) {
     expr_ref result(term.get_manager());
-    m_imp->operator()(term, result);
+    (*this)(term, result);
     term = std::move(result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result) {
     m_imp->operator()(t, result);
+    // the root is not cached by the rewriter
+    m_imp->cfg().result_cached(t, result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr) {
@@ -46,6 +46,7 @@ Notes:
 #include "model/model_smt2_pp.h"
 #include "model/model_v2_pp.h"
 #include "model/model_params.hpp"
+#include "params/rewriter_params.hpp"
 #include "tactic/tactic_exception.h"
 #include "tactic/generic_model_converter.h"
 #include "solver/smt_logics.h"
@@ -367,12 +368,14 @@ void cmd_context::insert_macro(symbol const& s, unsigned arity, sort*const* doma
     expr_ref tt = sub(t, rvars);
     p.set_definition(replace, d, true, vars.size(), vars.data(), tt);
     register_fun(s, d.get_def()->get_decl());
+    invalidate_simplify_cache();
 }
 
 void cmd_context::erase_macro(symbol const& s) {
     macro_decls decls;
     VERIFY(m_macros.find(s, decls));
     decls.erase_last(m());
+    invalidate_simplify_cache();
 }
 
 bool cmd_context::macros_find(symbol const& s, unsigned n, expr*const* args, expr_ref_vector& coerced_args, expr*& t) const {
@@ -819,6 +822,11 @@ void cmd_context::init_manager() {
         SASSERT(m_pmanager == 0);
         m_check_sat_result = nullptr;
         m_manager  = m_params.mk_ast_manager();
+        if (m_limit_parent) {
+            m_limit_parent->push_child(&m_manager->limit());
+            if (m_limit_parent->is_canceled())
+                m_manager->limit().cancel();
+        }
         m_pmanager = alloc(pdecl_manager, *m_manager);
         init_manager_core(true);
     }
@@ -1005,6 +1013,7 @@ void cmd_context::insert_rec_fun(func_decl* f, expr_ref_vector const& binding, s
     recfun::promise_def d = p.get_promise_def(f);
     recfun_replace replace(m());
     p.set_definition(replace, d, false, vars.size(), vars.data(), rhs);
+    invalidate_simplify_cache();
 }
 
 func_decl * cmd_context::find_func_decl(symbol const & s) const {
@@ -1440,10 +1449,13 @@ void cmd_context::reset(bool finalize) {
     m_opt = nullptr;
     m_pp_env = nullptr;
     m_dt_eh  = nullptr;
+    m_simplify_cache = nullptr;
     if (m_manager) {
         dealloc(m_pmanager);
         m_pmanager = nullptr;
         if (m_own_manager) {
+            if (m_limit_parent)
+                m_limit_parent->pop_child();
             dealloc(m_manager);
             m_manager = nullptr;
             m_manager_initialized = false;
@@ -1657,6 +1669,16 @@ void cmd_context::check_sat(unsigned num_assumptions, expr * const * assumptions
     unsigned rlimit  = m_params.rlimit();
     scoped_watch sw(*this);
     lbool r;
+    scoped_ptr<scoped_simplify_cache> _simplify_cache;
+    rewriter_params rp;
+    if (rp.shared_cache()) {
+        if (!m_simplify_cache)
+            m_simplify_cache = alloc(simplify_cache, m());
+        m_simplify_cache->set_max_size(rp.shared_cache_max_size());
+        _simplify_cache = alloc(scoped_simplify_cache, *m_simplify_cache);
+    }
+    else
+        m_simplify_cache = nullptr;
 
     if (m_opt && !m_opt->empty()) {
         bool is_clear = m_check_sat_result == nullptr;
@@ -2184,6 +2206,8 @@ void cmd_context::display_statistics(bool show_total_time, double total_time) {
     st.update("time", get_seconds());
     get_memory_statistics(st);
     get_rlimit_statistics(m().limit(), st);
+    if (m_simplify_cache)
+        m_simplify_cache->collect_statistics(st);
     if (m_check_sat_result) {
         m_check_sat_result->collect_statistics(st);
     }
@@ -33,6 +33,7 @@ Notes:
 #include "ast/datatype_decl_plugin.h"
 #include "ast/recfun_decl_plugin.h"
 #include "ast/rewriter/seq_rewriter.h"
+#include "ast/rewriter/simplify_cache.h"
 #include "tactic/generic_model_converter.h"
 #include "solver/solver.h"
 #include "solver/check_logic.h"
@@ -217,6 +218,7 @@ protected:
     ast_manager *                m_manager;
     bool                         m_own_manager;
     bool                         m_manager_initialized;
+    reslimit *                   m_limit_parent { nullptr }; // parent of the limit of the managers created by the context
     pdecl_manager *              m_pmanager;
     sexpr_manager *              m_sexpr_manager;
     check_logic                  m_check_logic;
@@ -282,6 +284,9 @@ protected:
     scoped_ptr<pp_env>            m_pp_env;
     pp_env & get_pp_env() const;
 
+    scoped_ptr<simplify_cache>    m_simplify_cache; // attached to the manager during check-sat, with rewriter.shared_cache
+    void invalidate_simplify_cache() { if (m_simplify_cache) m_simplify_cache->invalidate(); }
+
     void register_builtin_sorts(decl_plugin * p);
     void register_builtin_ops(decl_plugin * p);
     void load_plugin(symbol const & name, bool install_names, svector<family_id>& fids);
@@ -375,6 +380,12 @@ public:
     std::string reason_unknown() const;
 
     bool has_manager() const { return m_manager != nullptr; }
+    /**
+       \brief Link the resource limit of the managers that the context creates to parent,
+       so that canceling parent cancels the context without forcing the creation
+       of its manager (which fixes the logic).
+    */
+    void set_limit_parent(reslimit * parent) { SASSERT(!m_manager); m_limit_parent = parent; }
     ast_manager & m() const { const_cast<cmd_context*>(this)->init_manager(); return *m_manager; }
     ast_manager & get_ast_manager() override { return m(); }
     pdecl_manager & pm() const { if (!m_pmanager) const_cast<cmd_context*>(this)->init_manager(); return *m_pmanager; }
@@ -0,0 +1,164 @@
+/*
+  Copyright (c) 2017 Microsoft Corporation
+*/
+
+#include "math/lp/lar_solver.h"
+#include "math/lp/nra_relaxation.h"
+#include "math/polynomial/polynomial.h"
+#include "util/map.h"
+
+namespace nra {
+
+struct relaxation::imp {
+
+    class resource_limit : public lp::lp_resource_limit {
+        reslimit& m_limit;
+    public:
+        resource_limit(reslimit& lim): m_limit(lim) {}
+        bool get_cancel_flag() override { return !m_limit.inc(); }
+    };
+
+    // p op 0 is relaxed to m_term op -m_offset
+    struct atom_info {
+        lp::lpvar m_term;
+        rational  m_offset;
+    };
+
+    nlsat::solver&        m_solver;
+    nlsat::pmanager&      m_pm;
+    resource_limit        m_limit;
+    lp::lar_solver        m_lar;
+    unsigned              m_num_ext;
+    u_map<lp::lpvar>      m_var2col;    // nlsat variable to column
+    u_map<lp::lpvar>      m_mon2col;    // monomial id to column
+    u_map<atom_info>      m_atoms;      // relaxed atoms
+    uint_set              m_nonlinear;  // atoms that cannot be relaxed
+    svector<nlsat::literal> m_ci2lit;
+
+    imp(nlsat::solver& s, reslimit& lim):
+        m_solver(s),
+        m_pm(s.pm()),
+        m_limit(lim),
+        m_num_ext(0) {
+        m_lar.settings().set_resource_limit(m_limit);
+    }
+
+    lp::lpvar mk_column() {
+        return m_lar.add_var(m_num_ext++, false);
+    }
+
+    lp::lpvar var2col(nlsat::var x) {
+        lp::lpvar j;
+        if (!m_var2col.find(x, j)) {
+            j = mk_column();
+            m_var2col.insert(x, j);
+        }
+        return j;
+    }
+
+    lp::lpvar mon2col(polynomial::monomial* m) {
+        if (m_pm.size(m) == 1 && m_pm.degree(m, 0) == 1)
+            return var2col(m_pm.get_var(m, 0));
+        lp::lpvar j;
+        unsigned id = m_pm.id(m);
+        if (!m_mon2col.find(id, j)) {
+            j = mk_column();
+            m_mon2col.insert(id, j);
+        }
+        return j;
+    }
+
+    /*
+      \brief Relax the atom of b as a term, the polynomial must be a single
+      odd factor so that its sign is the sign of the atom.
+    */
+    bool relax(nlsat::bool_var b, atom_info& info) {
+        if (m_atoms.find(b, info))
+            return true;
+        if (m_nonlinear.contains(b))
+            return false;
+        nlsat::atom* a = m_solver.bool_var2atom(b);
+        if (!a || !a->is_ineq_atom() || to_ineq_atom(a)->size() != 1 || to_ineq_atom(a)->is_even(0)) {
+            m_nonlinear.insert(b);
+            return false;
+        }
+        nlsat::poly* p = to_ineq_atom(a)->p(0);
+        vector<std::pair<rational, lp::lpvar>> coeffs;
+        rational offset;
+        for (unsigned i = 0, sz = m_pm.size(p); i < sz; ++i) {
+            polynomial::monomial* m = m_pm.get_monomial(p, i);
+            rational c(m_pm.coeff(p, i));
+            if (m_pm.size(m) == 0)
+                offset = c;
+            else
+                coeffs.push_back(std::make_pair(c, mon2col(m)));
+        }
+        info.m_term = m_lar.add_term(coeffs, m_num_ext++);
+        info.m_offset = offset;
+        m_atoms.insert(b, info);
+        return true;
+    }
+
+    lbool check(unsigned n, nlsat::literal const* lits, nlsat::literal_vector& core) {
+        // relax the atoms before the scope, the terms are kept across checks
+        atom_info info;
+        for (unsigned i = 0; i < n; ++i)
+            relax(lits[i].var(), info);
+
+        m_lar.push();
+        unsigned num_bounds = 0;
+        for (unsigned i = 0; i < n; ++i) {
+            nlsat::literal l = lits[i];
+            if (!relax(l.var(), info))
+                continue;
+            lp::lconstraint_kind k;
+            switch (m_solver.bool_var2atom(l.var())->get_kind()) {
+            case nlsat::atom::EQ:
+                if (l.sign())
+                    continue;
+                k = lp::EQ;
+                break;
+            case nlsat::atom::LT:
+                k = l.sign() ? lp::GE : lp::LT;
+                break;
+            case nlsat::atom::GT:
+                k = l.sign() ? lp::LE : lp::GT;
+                break;
+            default:
+                continue;
+            }
+            lp::constraint_index ci = m_lar.add_var_bound(info.m_term, k, -info.m_offset);
+            m_ci2lit.setx(ci, l, nlsat::null_literal);
+            num_bounds++;
+        }
+        lbool r = l_true;
+        if (num_bounds > 1) {
+            lp::lp_status st = m_lar.find_feasible_solution();
+            if (st == lp::lp_status::INFEASIBLE) {
+                lp::explanation ex;
+                m_lar.get_infeasibility_explanation(ex);
+                for (auto p : ex)
+                    core.push_back(m_ci2lit[p.ci()]);
+                r = l_false;
+            }
+            else if (st == lp::lp_status::CANCELLED || st == lp::lp_status::TIME_EXHAUSTED)
+                r = l_undef;
+        }
+        m_lar.pop(1);
+        return r;
+    }
+};
+
+relaxation::relaxation(nlsat::solver& s, reslimit& lim) {
+    m_imp = alloc(imp, s, lim);
+}
+
+relaxation::~relaxation() {
+    dealloc(m_imp);
+}
+
+lbool relaxation::check(unsigned n, nlsat::literal const* lits, nlsat::literal_vector& core) {
+    return m_imp->check(n, lits, core);
+}
+
+}
@@ -0,0 +1,32 @@
+/*
+  Copyright (c) 2017 Microsoft Corporation
+
+  Linear relaxation of the nlsat literals in an incremental lar_solver.
+  Every nonlinear monomial is abstracted as a fresh column, so an
+  infeasible relaxation has a Farkas explanation that is a valid
+  nonlinear lemma.
+*/
+
+#pragma once
+#include "util/rlimit.h"
+#include "nlsat/nlsat_solver.h"
+
+namespace nra {
+
+    class relaxation : public nlsat::linear_relaxation {
+        struct imp;
+        imp* m_imp;
+
+    public:
+
+        relaxation(nlsat::solver& s, reslimit& lim);
+
+        ~relaxation() override;
+
+        /*
+          \brief Check the relaxation of the literals, atoms are linearized
+          once and only their bounds are pushed for the check.
+        */
+        lbool check(unsigned n, nlsat::literal const* lits, nlsat::literal_vector& core) override;
+    };
+}
@@ -16,6 +16,8 @@ Author:
 Notes:
 
 --*/
+#include <cmath>
+#include <limits>
 #include "util/mpbq.h"
 #include "util/basic_interval.h"
 #include "util/scoped_ptr_vector.h"
@@ -47,7 +49,11 @@ namespace algebraic_numbers {
         unsigned   m_sign_lower:1;
         unsigned   m_not_rational:1; // if true we know for sure it is not a rational
         unsigned   m_i:29; // number is the i-th root of p, 0 if it is not known which root of p the number is.
-        algebraic_cell():m_p_sz(0), m_p(nullptr), m_minimal(false), m_not_rational(false), m_i(0) {}
+        // outward rounded double enclosure of the number, it may be wider than m_interval
+        double     m_dlower;
+        double     m_dupper;
+        algebraic_cell():m_p_sz(0), m_p(nullptr), m_minimal(false), m_not_rational(false), m_i(0),
+                         m_dlower(-std::numeric_limits<double>::infinity()), m_dupper(std::numeric_limits<double>::infinity()) {}
         bool is_minimal() const { return m_minimal != 0; }
     };
 
@@ -92,10 +98,13 @@ namespace algebraic_numbers {
 
         // statistics
         unsigned                 m_compare_cheap;
+        unsigned                 m_compare_double;
         unsigned                 m_compare_sturm;
         unsigned                 m_compare_refine;
         unsigned                 m_compare_poly_eq;
 
+        size_t                   m_num_bytes;     // bytes of the live cells and their polynomials
+
         imp(reslimit& lim, manager & w, unsynch_mpq_manager & m, params_ref const & p, small_object_allocator & a):
             m_limit(lim),
             m_wrapper(w),
@@ -114,7 +123,8 @@ namespace algebraic_numbers {
             m_isolate_roots(bqm()),
             m_isolate_lowers(bqm()),
             m_isolate_uppers(bqm()),
-            m_add_tmp(upm()) {
+            m_add_tmp(upm()),
+            m_num_bytes(0) {
             updt_params(p);
             reset_statistics();
             m_x = pm().mk_var();
@@ -136,12 +146,14 @@ namespace algebraic_numbers {
 
         void reset_statistics() {
             m_compare_cheap   = 0;
+            m_compare_double  = 0;
             m_compare_sturm   = 0;
             m_compare_refine  = 0;
             m_compare_poly_eq = 0;
         }
 
         void collect_statistics(statistics & st) {
+            st.update("algebraic compare double", m_compare_double);
 #ifndef _EXTERNAL_RELEASE
             st.update("algebraic compare cheap", m_compare_cheap);
             st.update("algebraic compare sturm", m_compare_sturm);
@@ -182,12 +194,14 @@ namespace algebraic_numbers {
 
         void del(basic_cell * c) {
             qm().del(c->m_value);
+            m_num_bytes -= sizeof(basic_cell);
             m_allocator.deallocate(sizeof(basic_cell), c);
         }
 
         void del_poly(algebraic_cell * c) {
             for (unsigned i = 0; i < c->m_p_sz; i++)
                 qm().del(c->m_p[i]);
+            m_num_bytes -= sizeof(mpz)*c->m_p_sz;
             m_allocator.deallocate(sizeof(mpz)*c->m_p_sz, c->m_p);
             c->m_p    = nullptr;
             c->m_p_sz = 0;
@@ -200,6 +214,7 @@ namespace algebraic_numbers {
         void del(algebraic_cell * c) {
             del_poly(c);
             del_interval(c);
+            m_num_bytes -= sizeof(algebraic_cell);
             m_allocator.deallocate(sizeof(algebraic_cell), c);
         }
 
@@ -366,6 +381,7 @@ namespace algebraic_numbers {
             if (qm().is_zero(n))
                 return nullptr;
             void * mem = static_cast<basic_cell*>(m_allocator.allocate(sizeof(basic_cell)));
+            m_num_bytes += sizeof(basic_cell);
             basic_cell * c = new (mem) basic_cell();
             qm().swap(c->m_value, n);
             return c;
@@ -392,6 +408,52 @@ namespace algebraic_numbers {
             SASSERT(acell_inv(*c));
         }
 
+        /**
+           \brief Store in l and u doubles such that l <= b <= u.
+           The bounds are infinite if b is out of the range of normalized doubles.
+        */
+        void to_double_enclosure(mpbq const & b, double & l, double & u) {
+            mpz const & n = b.numerator();
+            if (qm().is_zero(n)) {
+                l = u = 0.0;
+                return;
+            }
+            unsigned bits  = qm().bitsize(n);
+            int shift      = bits > 53 ? bits - 53 : 0;
+            if (b.k() > 1000 || shift > 900 || shift - static_cast<int>(b.k()) < -1000) {
+                l = -std::numeric_limits<double>::infinity();
+                u = std::numeric_limits<double>::infinity();
+                return;
+            }
+            int e = shift - static_cast<int>(b.k());
+            if (shift == 0) {
+                // exact
+                l = u = std::ldexp(static_cast<double>(qm().get_int64(n)), e);
+                return;
+            }
+            // t is n / 2^shift rounded towards zero, |t| < 2^53
+            scoped_mpz t(qm());
+            qm().machine_div2k(n, shift, t);
+            int64_t v = qm().get_int64(t);
+            l = std::ldexp(static_cast<double>(v - 1), e);
+            u = std::ldexp(static_cast<double>(v + 1), e);
+        }
+
+        void update_enclosure(algebraic_cell * c) {
+            double l, u, tmp;
+            to_double_enclosure(lower(c), l, tmp);
+            to_double_enclosure(upper(c), tmp, u);
+            // refinement only shrinks the interval, keep the tighter bounds
+            c->m_dlower = std::max(c->m_dlower, l);
+            c->m_dupper = std::min(c->m_dupper, u);
+        }
+
+        void reset_enclosure(algebraic_cell * c) {
+            c->m_dlower = -std::numeric_limits<double>::infinity();
+            c->m_dupper = std::numeric_limits<double>::infinity();
+            update_enclosure(c);
+        }
+
         // Make sure the GCD of the coefficients is one and the leading coefficient is positive
         void normalize_coeffs(algebraic_cell * c) {
             SASSERT(c->m_p_sz > 2);
@@ -406,15 +468,18 @@ namespace algebraic_numbers {
         algebraic_cell * mk_algebraic_cell(unsigned sz, mpz const * p, mpbq const & lower, mpbq const & upper, bool minimal) {
             SASSERT(sz > 2);
             void * mem = static_cast<algebraic_cell*>(m_allocator.allocate(sizeof(algebraic_cell)));
+            m_num_bytes += sizeof(algebraic_cell);
             algebraic_cell * c = new (mem) algebraic_cell();
             c->m_p_sz = sz;
             c->m_p    = static_cast<mpz*>(m_allocator.allocate(sizeof(mpz)*sz));
+            m_num_bytes += sizeof(mpz)*sz;
             for (unsigned i = 0; i < sz; i++) {
                 new (c->m_p + i) mpz();
                 qm().set(c->m_p[i], p[i]);
             }
             bqim().set(c->m_interval, lower, upper);
             update_sign_lower(c);
+            reset_enclosure(c);
             c->m_minimal = minimal;
             SASSERT(c->m_i == 0);
             SASSERT(c->m_not_rational == false);
@@ -453,6 +518,7 @@ namespace algebraic_numbers {
             SASSERT(c->m_p_sz == 0);
             c->m_p_sz = sz;
             c->m_p    = static_cast<mpz*>(m_allocator.allocate(sizeof(mpz)*sz));
+            m_num_bytes += sizeof(mpz)*sz;
             for (unsigned i = 0; i < sz; i++) {
                 new (c->m_p + i) mpz();
                 qm().set(c->m_p[i], p[i]);
@@ -476,6 +542,8 @@ namespace algebraic_numbers {
             target->m_sign_lower   = source->m_sign_lower;
             target->m_not_rational = source->m_not_rational;
             target->m_i            = source->m_i;
+            target->m_dlower       = source->m_dlower;
+            target->m_dupper       = source->m_dupper;
             //SASSERT(acell_inv(*source)); source could be owned by a different manager
             SASSERT(acell_inv(*target));
         }
@@ -506,6 +574,7 @@ namespace algebraic_numbers {
                         c->m_not_rational = true;
                     c->m_i            = 0;
                     update_sign_lower(c);
+                    reset_enclosure(c);
                     normalize_coeffs(c);
                 }
                 SASSERT(acell_inv(*a.to_algebraic()));
@@ -525,6 +594,7 @@ namespace algebraic_numbers {
                     SASSERT(a.is_basic() && !b.is_basic());
                     del(a);
                     void * mem = m_allocator.allocate(sizeof(algebraic_cell));
+                    m_num_bytes += sizeof(algebraic_cell);
                     algebraic_cell * c = new (mem) algebraic_cell();
                     a.m_cell = TAG(void *, c, ROOT);
                     copy(c, b.to_algebraic());
@@ -768,6 +838,8 @@ namespace algebraic_numbers {
         */
         bool refine_core(algebraic_cell * c) {
             bool r = upm().refine_core(c->m_p_sz, c->m_p, sign_lower(c), bqm(), lower(c), upper(c));
+            if (r)
+                update_enclosure(c);
             SASSERT(acell_inv(*c));
             return r;
         }
@@ -820,6 +892,7 @@ namespace algebraic_numbers {
                 a.m_cell = mk_basic_cell(r);
                 return false;
             }
+            update_enclosure(c);
             SASSERT(acell_inv(*c));
             return true;
         }
@@ -1619,6 +1692,9 @@ namespace algebraic_numbers {
                 upm().p_minus_x(c->m_p_sz, c->m_p);
                 bqim().neg(c->m_interval);
                 update_sign_lower(c);
+                std::swap(c->m_dlower, c->m_dupper);
+                c->m_dlower = -c->m_dlower;
+                c->m_dupper = -c->m_dupper;
                 SASSERT(acell_inv(*c));
             }
         }
@@ -1693,6 +1769,7 @@ namespace algebraic_numbers {
                 upm().convert_q2bq_interval(cell_a->m_p_sz, cell_a->m_p, inv_lower, inv_upper, bqm(), lower(cell_a), upper(cell_a));
                 TRACE("algebraic_bug", tout << "after inv: "; display_root(tout, a); tout << "\n"; display_interval(tout, a); tout << "\n";);
                 update_sign_lower(cell_a);
+                reset_enclosure(cell_a);
                 SASSERT(acell_inv(*cell_a));       
             }
         }
@@ -1740,6 +1817,22 @@ namespace algebraic_numbers {
              (p(b) < 0) == (p(l) < 0) then c > b else c < b
         */
         ::sign compare(algebraic_cell * c, mpq const & b) {
+            if (qm().is_int64(b.numerator()) && qm().is_int64(b.denominator())) {
+                int64_t n = qm().get_int64(b.numerator());
+                int64_t d = qm().get_int64(b.denominator());
+                if (-(1ll << 53) < n && n < (1ll << 53) && d < (1ll << 53)) {
+                    // n and d are exact, the quotient is at most one ulp away from b
+                    double q = static_cast<double>(n) / static_cast<double>(d);
+                    if (c->m_dupper < std::nextafter(q, -std::numeric_limits<double>::infinity())) {
+                        m_compare_double++;
+                        return sign_neg;
+                    }
+                    if (c->m_dlower > std::nextafter(q, std::numeric_limits<double>::infinity())) {
+                        m_compare_double++;
+                        return sign_pos;
+                    }
+                }
+            }
             mpbq const & l = lower(c);
             mpbq const & u = upper(c);
             if (bqm().le(u, b))
@@ -1762,6 +1855,14 @@ namespace algebraic_numbers {
             SASSERT(!a.is_basic() && !b.is_basic());
             algebraic_cell * cell_a = a.to_algebraic();
             algebraic_cell * cell_b = b.to_algebraic();
+            if (cell_a->m_dupper < cell_b->m_dlower) {
+                m_compare_double++;
+                return sign_neg;
+            }
+            if (cell_a->m_dlower > cell_b->m_dupper) {
+                m_compare_double++;
+                return sign_pos;
+            }
             mpbq const & a_lower = lower(cell_a);
             mpbq const & a_upper = upper(cell_a);
             mpbq const & b_lower = lower(cell_b);
@@ -2883,6 +2984,10 @@ namespace algebraic_numbers {
         return m_imp->qm();
     }
 
+    size_t manager::memory_size() const {
+        return m_imp->m_num_bytes;
+    }
+
     mpbq_manager & manager::bqm() const {
         return m_imp->bqm();
     }
@@ -67,6 +67,11 @@ namespace algebraic_numbers {
 
         unsynch_mpq_manager & qm() const;
 
+        /**
+           \brief Return the number of bytes of the live algebraic cells.
+        */
+        size_t memory_size() const;
+
         mpbq_manager & bqm() const;
 
         void del(numeral & a);
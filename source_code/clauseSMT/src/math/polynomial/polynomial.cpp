@@ -1858,6 +1858,25 @@ namespace polynomial {
         bool                     m_use_sparse_gcd;
         bool                     m_use_prs_gcd;
 
+        /**
+           \brief Horner scheme of a polynomial compiled into a flat program over
+           a stack of values, see compile_core.
+        */
+        struct horner_program {
+            enum opcode { PUSH, MUL_POW, ADD };
+            struct instr {
+                opcode   m_op;
+                unsigned m_arg;    // PUSH: coefficient index, MUL_POW: variable
+                unsigned m_degree; // MUL_POW: exponent
+            };
+            svector<instr>   m_code;
+            svector<mpz>     m_coeffs;
+            unsigned         m_depth;
+            unsigned         m_max_depth;
+            horner_program(): m_depth(0), m_max_depth(0) {}
+        };
+        ptr_vector<horner_program> m_programs; // indexed by polynomial id
+
         // Debugging method: check if the coefficients of p are in the numeral_manager.
         bool consistent_coeffs(polynomial const * p) {
             scoped_numeral a(m_manager);
@@ -2379,6 +2398,10 @@ namespace polynomial {
                    });
             m_polynomials.reset();
             SASSERT(m_polynomials.empty());
+            for (horner_program * prog : m_programs)
+                if (prog)
+                    del_program(prog);
+            m_programs.reset();
             m_iccp_ZpX_buffers.clear();
             m_monomial_manager->dec_ref();
         }
@@ -2448,6 +2471,10 @@ namespace polynomial {
                 dec_ref(p->m(i));
             }
             unsigned id = p->id();
+            if (id < m_programs.size() && m_programs[id]) {
+                del_program(m_programs[id]);
+                m_programs[id] = nullptr;
+            }
             m_pid_gen.recycle(id);
             m_polynomials[id] = 0;
             mm().allocator().deallocate(obj_sz, p);
@@ -6129,6 +6156,13 @@ namespace polynomial {
                     p->make_first_maximal();
                 SASSERT(!p || p->size() <= 1 || !p->lex_sorted());
             }
+            // the compiled programs refer to the old variables
+            for (horner_program * & prog : m_programs) {
+                if (prog) {
+                    del_program(prog);
+                    prog = nullptr;
+                }
+            }
             TRACE("rename",
                   tout << "polynomials after rename\n";
                   for (unsigned i = 0; i < m_polynomials.size(); i++) {
@@ -6562,6 +6596,192 @@ namespace polynomial {
             t_eval_core(p, vm, x2v, 0, p->size(), max_var(p), r);
         }
 
+        void del_program(horner_program * prog) {
+            for (mpz & c : prog->m_coeffs)
+                m_manager.m().del(c);
+            dealloc(prog);
+        }
+
+        void emit(horner_program & prog, horner_program::opcode op, unsigned arg, unsigned degree) {
+            horner_program::instr i;
+            i.m_op = op;
+            i.m_arg = arg;
+            i.m_degree = degree;
+            prog.m_code.push_back(i);
+            if (op == horner_program::PUSH)
+                prog.m_max_depth = std::max(prog.m_max_depth, ++prog.m_depth);
+            else if (op == horner_program::ADD)
+                --prog.m_depth;
+        }
+
+        void emit_coeff(horner_program & prog, numeral const & a) {
+            prog.m_coeffs.push_back(mpz());
+            m_manager.m().set(prog.m_coeffs.back(), a);
+            emit(prog, horner_program::PUSH, prog.m_coeffs.size() - 1, 0);
+        }
+
+        /**
+           \brief Compile the evaluation of the monomials of p at positions [start, end),
+           where all variables > x are ignored. It follows t_eval_core: the value is
+           pushed on the stack of the program.
+        */
+        void compile_core(polynomial * p, unsigned start, unsigned end, var x, horner_program & prog) {
+            SASSERT(start < end);
+            if (end == start + 1) {
+                emit_coeff(prog, p->a(start));
+                monomial * m = p->m(start);
+                for (unsigned i = 0; i < m->size() && m->get_var(i) <= x; i++)
+                    emit(prog, horner_program::MUL_POW, m->get_var(i), m->degree(i));
+                return;
+            }
+            // the first term is pushed, the next ones are added to it
+            bool first = true;
+            unsigned i = start;
+            while (i < end) {
+                unsigned d = p->m(i)->degree_of(x);
+                if (d == 0) {
+                    var y = p->max_smaller_than(i, end, x);
+                    if (y == null_var)
+                        emit_coeff(prog, p->a(i));
+                    else
+                        compile_core(p, i, end, y, prog);
+                    if (!first)
+                        emit(prog, horner_program::ADD, 0, 0);
+                    break;
+                }
+                unsigned j = i + 1;
+                unsigned next_d = 0;
+                for (; j < end; j++) {
+                    unsigned d_j = p->m(j)->degree_of(x);
+                    if (d_j < d) {
+                        next_d = d_j;
+                        break;
+                    }
+                }
+                var y = p->max_smaller_than(i, j, x);
+                if (y == null_var)
+                    emit_coeff(prog, p->a(i));
+                else
+                    compile_core(p, i, j, y, prog);
+                if (!first)
+                    emit(prog, horner_program::ADD, 0, 0);
+                first = false;
+                emit(prog, horner_program::MUL_POW, x, d - next_d);
+                i = j;
+            }
+        }
+
+        /**
+           \brief Return the program evaluating p, it is compiled on the first
+           evaluation and cached until p is deleted.
+        */
+        horner_program const & get_program(polynomial * p) {
+            SASSERT(!is_const(p));
+            unsigned id = p->id();
+            if (id < m_programs.size() && m_programs[id])
+                return *m_programs[id];
+            lex_sort(p);
+            horner_program * prog = alloc(horner_program);
+            compile_core(p, 0, p->size(), max_var(p), *prog);
+            SASSERT(prog->m_depth == 1);
+            m_programs.reserve(id + 1, nullptr);
+            m_programs[id] = prog;
+            return *prog;
+        }
+
+        template<typename ValManager>
+        void t_eval_program(polynomial * p, var2value<ValManager> const & x2v, typename ValManager::numeral & r) {
+            ValManager & vm = x2v.m();
+            if (is_zero(p)) {
+                vm.reset(r);
+                return;
+            }
+            if (is_const(p)) {
+                vm.set(r, p->a(0));
+                return;
+            }
+            checkpoint();
+            horner_program const & prog = get_program(p);
+            _scoped_numeral_vector<ValManager> stack(vm);
+            for (unsigned i = 0; i < prog.m_max_depth; i++)
+                stack.push_back(typename ValManager::numeral());
+            _scoped_numeral<ValManager> aux(vm);
+            unsigned top = 0;
+            for (auto const & i : prog.m_code) {
+                switch (i.m_op) {
+                case horner_program::PUSH:
+                    vm.set(stack[top++], prog.m_coeffs[i.m_arg]);
+                    break;
+                case horner_program::MUL_POW:
+                    SASSERT(x2v.contains(i.m_arg));
+                    if (i.m_degree == 1)
+                        vm.mul(stack[top - 1], x2v(i.m_arg), stack[top - 1]);
+                    else {
+                        vm.power(x2v(i.m_arg), i.m_degree, aux);
+                        vm.mul(stack[top - 1], aux, stack[top - 1]);
+                    }
+                    break;
+                case horner_program::ADD:
+                    --top;
+                    vm.add(stack[top - 1], stack[top], stack[top - 1]);
+                    break;
+                }
+            }
+            SASSERT(top == 1);
+            vm.set(r, stack[0]);
+        }
+
+        /**
+           \brief Evaluate p at n points, the program is run once with a row of n
+           values per stack slot.
+        */
+        template<typename ValManager>
+        void t_eval_program(polynomial * p, unsigned n, var2value<ValManager> const * const * x2vs, typename ValManager::numeral * rs) {
+            if (n == 0)
+                return;
+            ValManager & vm = x2vs[0]->m();
+            if (is_zero(p) || is_const(p)) {
+                for (unsigned k = 0; k < n; k++)
+                    t_eval_program(p, *x2vs[k], rs[k]);
+                return;
+            }
+            checkpoint();
+            horner_program const & prog = get_program(p);
+            _scoped_numeral_vector<ValManager> stack(vm);
+            for (unsigned i = 0; i < prog.m_max_depth * n; i++)
+                stack.push_back(typename ValManager::numeral());
+            _scoped_numeral<ValManager> aux(vm);
+            unsigned top = 0;
+            for (auto const & i : prog.m_code) {
+                switch (i.m_op) {
+                case horner_program::PUSH:
+                    for (unsigned k = 0; k < n; k++)
+                        vm.set(stack[top * n + k], prog.m_coeffs[i.m_arg]);
+                    ++top;
+                    break;
+                case horner_program::MUL_POW:
+                    for (unsigned k = 0; k < n; k++) {
+                        auto & v = stack[(top - 1) * n + k];
+                        if (i.m_degree == 1)
+                            vm.mul(v, (*x2vs[k])(i.m_arg), v);
+                        else {
+                            vm.power((*x2vs[k])(i.m_arg), i.m_degree, aux);
+                            vm.mul(v, aux, v);
+                        }
+                    }
+                    break;
+                case horner_program::ADD:
+                    --top;
+                    for (unsigned k = 0; k < n; k++)
+                        vm.add(stack[(top - 1) * n + k], stack[top * n + k], stack[(top - 1) * n + k]);
+                    break;
+                }
+            }
+            SASSERT(top == 1);
+            for (unsigned k = 0; k < n; k++)
+                vm.set(rs[k], stack[k]);
+        }
+
         class single_var2value : public var2value<numeral_manager> {
             numeral_manager & m_manager;
             var             m_x;
@@ -6584,15 +6804,23 @@ namespace polynomial {
         }
 
         void eval(polynomial const * p, var2mpbqi const & x2v, mpbqi & r) {
-            t_eval<mpbqi_manager>(const_cast<polynomial*>(p), x2v, r);
+            t_eval_program<mpbqi_manager>(const_cast<polynomial*>(p), x2v, r);
         }
 
         void eval(polynomial const * p, var2mpq const & x2v, mpq & r) {
-            t_eval<unsynch_mpq_manager>(const_cast<polynomial*>(p), x2v, r);
+            t_eval_program<unsynch_mpq_manager>(const_cast<polynomial*>(p), x2v, r);
         }
 
         void eval(polynomial const * p, var2anum const & x2v, anum & r) {
-            t_eval<anum_manager>(const_cast<polynomial*>(p), x2v, r);
+            t_eval_program<anum_manager>(const_cast<polynomial*>(p), x2v, r);
+        }
+
+        void eval(polynomial const * p, unsigned n, var2mpbqi const * const * x2vs, mpbqi * rs) {
+            t_eval_program<mpbqi_manager>(const_cast<polynomial*>(p), n, x2vs, rs);
+        }
+
+        void eval(polynomial const * p, unsigned n, var2mpq const * const * x2vs, mpq * rs) {
+            t_eval_program<unsynch_mpq_manager>(const_cast<polynomial*>(p), n, x2vs, rs);
         }
 
         // Return the variable with minimal degree in p
@@ -7463,6 +7691,14 @@ namespace polynomial {
         return m_imp->eval(p, x2v, r);
     }
 
+    void manager::eval(polynomial const * p, unsigned n, var2mpbqi const * const * x2vs, mpbqi * rs) {
+        m_imp->eval(p, n, x2vs, rs);
+    }
+
+    void manager::eval(polynomial const * p, unsigned n, var2mpq const * const * x2vs, mpq * rs) {
+        m_imp->eval(p, n, x2vs, rs);
+    }
+
     void manager::display(std::ostream & out, monomial const * m, display_var_proc const & proc, bool user_star) const {
         m->display(out, proc, user_star);
     }
@@ -936,11 +936,21 @@ namespace polynomial {
            \brief Evaluate polynomial p using the assignment [x_1 -> v_1, ..., x_n -> v_n].
            The result is store in r.
            All variables occurring in p must be in xs.
+
+           Remark: p is compiled into a Horner scheme on its first evaluation, the
+           compiled program is kept until p is deleted.
         */
         void eval(polynomial const * p, var2mpbqi const & x2v, mpbqi & r);
         void eval(polynomial const * p, var2mpq const & x2v, mpq & r);
         void eval(polynomial const * p, var2anum const & x2v, algebraic_numbers::anum & r);
 
+        /**
+           \brief Evaluate polynomial p at the n assignments x2vs[0], ..., x2vs[n-1].
+           The value at x2vs[i] is stored in rs[i].
+        */
+        void eval(polynomial const * p, unsigned n, var2mpbqi const * const * x2vs, mpbqi * rs);
+        void eval(polynomial const * p, unsigned n, var2mpq const * const * x2vs, mpq * rs);
+
         /**
            \brief Apply substitution [x_1 -> v_1, ..., x_n -> v_n].
            That is, given p \in Z[x_1, ..., x_n, y_1, ..., y_m] return a polynomial
@@ -134,6 +134,15 @@ namespace polynomial {
             m_factor_cache.reset();
         }
 
+        size_t memory_size() const {
+            size_t r = m_poly_table.size() * sizeof(polynomial*) + m_cached_polys.size() * sizeof(polynomial*) + m_in_cache.size();
+            for (psc_chain_entry const * e : m_psc_chain_cache)
+                r += sizeof(psc_chain_entry) + sizeof(polynomial*) * e->m_result_sz;
+            for (factor_entry const * e : m_factor_cache)
+                r += sizeof(factor_entry) + sizeof(polynomial*) * e->m_result_sz;
+            return r;
+        }
+
         unsigned pid(polynomial * p) const { return m.id(p); }
         
         polynomial * mk_unique(polynomial * p) {
@@ -228,6 +237,15 @@ namespace polynomial {
         m_imp->factor(const_cast<polynomial*>(p), distinct_factors);
     }
     
+    size_t cache::memory_size() const {
+        return m_imp->memory_size();
+    }
+
+    void cache::flush() {
+        m_imp->reset_psc_chain_cache();
+        m_imp->reset_factor_cache();
+    }
+
     void cache::reset() {
         manager & _m = m();
         dealloc(m_imp);
@@ -37,6 +37,16 @@ namespace polynomial {
         void psc_chain(polynomial const * p, polynomial const * q, var x, polynomial_ref_vector & S);
         void factor(polynomial const * p, polynomial_ref_vector & distinct_factors);
         void reset();
+        /**
+           \brief Remove the cached psc chains and factorizations, the unique
+           polynomials are kept.
+        */
+        void flush();
+        /**
+           \brief Return the number of bytes of the cache entries, the cached
+           polynomials are owned by the manager.
+        */
+        size_t memory_size() const;
     };
 };
 
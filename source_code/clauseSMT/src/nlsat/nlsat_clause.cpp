@@ -25,6 +25,9 @@ namespace nlsat {
         m_size(sz),
         m_capacity(sz),
         m_learned(learned),
+        m_removed(false),
+        m_marked(false),
+        m_var_hash(0),
         m_activity(0),
         m_assumptions(as) {
         for (unsigned i = 0; i < sz; i++) {
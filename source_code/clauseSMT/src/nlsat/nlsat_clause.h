@@ -27,8 +27,11 @@ namespace nlsat {
         friend class solver;
         unsigned         m_id;
         unsigned         m_size;
-        unsigned         m_capacity:31;
+        unsigned         m_capacity:29;
         unsigned         m_learned:1;
+        unsigned         m_removed:1;
+        unsigned         m_marked:1;
+        unsigned         m_var_hash;
         // wzh dynamic
         // unsigned         m_activity;
         double m_activity;
@@ -60,6 +63,13 @@ namespace nlsat {
         bool contains(bool_var v) const;
         void shrink(unsigned num_lits) { SASSERT(num_lits <= m_size); if (num_lits < m_size) { m_size = num_lits; } }
         assumption_set assumptions() const { return m_assumptions; }
+        void set_removed() { m_removed = true; }
+        bool is_removed() const { return m_removed; }
+        unsigned var_hash() const { return m_var_hash; }
+        void set_var_hash(unsigned h) { m_var_hash = h; }
+        bool is_marked() const { return m_marked; }
+        void mark() { m_marked = true; }
+        void unmark() { m_marked = false; }
     };
 
     typedef ptr_vector<clause> clause_vector;
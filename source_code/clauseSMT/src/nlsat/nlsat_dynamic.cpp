@@ -1,5 +1,6 @@
 #include "nlsat/nlsat_dynamic.h"
 #include "util/heap.h"
+#include "util/ema.h"
 #include <iomanip>
 #include <math.h>
 #include <iostream>
@@ -212,8 +213,20 @@ namespace nlsat {
         int                                                              restart_first = 100;
         // The factor with which the restart limit is multiplied in each restart
         double                                                           restart_inc = 1.5;
-        // use luby restart sequence or not
-        const bool                                                       luby_restart = false;
+        // geometric, luby or ema restarts
+        restart_strategy                                                 m_restart_strategy = RESTART_GEOMETRIC;
+        // ema: restart when the fast average of the lemma stage-lbd exceeds the slow one by this factor
+        double                                                           m_restart_margin = 1.1;
+        // ema: block the restart when the hybrid trail is deeper than its average by this factor
+        double                                                           m_restart_blocking = 1.4;
+        // ema: minimum number of conflicts between two restarts
+        const unsigned                                                   ema_min_conflicts = 50;
+        // ema: no blocking before this number of conflicts
+        const unsigned                                                   ema_block_start = 1000;
+        ema                                                              m_fast_lbd_avg;
+        ema                                                              m_slow_lbd_avg;
+        ema                                                              m_trail_avg;
+        unsigned                                                         m_ema_conflicts = 0;
         // number of conflicts
         int                                                              nof_conflicts;
         // current conflict number
@@ -225,6 +238,7 @@ namespace nlsat {
          * * Statistics
         */
         unsigned                  &                                      m_restart;
+        unsigned                  &                                      m_blocked_restarts;
         unsigned                  &                                      m_learned_deleted;
         unsigned                                                         m_rand_seed;
 
@@ -250,9 +264,9 @@ namespace nlsat {
 
         
         imp(nlsat_clause_vector & nlsat_clauses, nlsat_atom_vector & nlsat_atoms, anum_manager & am, pmanager & pm, assignment & ass, evaluator & eva, interval_set_manager & ism, svector<lbool> const & bvalues, bool_var_vector const & pure_bool_vars, bool_var_vector const & pure_bool_convert, solver & s, clause_vector const & clauses, clause_vector & learned, atom_vector const & atoms, 
-        unsigned & restart, unsigned & deleted, unsigned seed):
+        unsigned & restart, unsigned & blocked_restarts, unsigned & deleted, unsigned seed):
             m_am(am), m_pm(pm), m_assignment(ass), m_clauses(clauses), m_learned(learned), m_atoms(atoms),
-            m_restart(restart), m_solver(s), m_learned_deleted(deleted), m_bvalues(bvalues), m_pure_bool_vars(pure_bool_vars), m_pure_bool_convert(pure_bool_convert),
+            m_restart(restart), m_blocked_restarts(blocked_restarts), m_solver(s), m_learned_deleted(deleted), m_bvalues(bvalues), m_pure_bool_vars(pure_bool_vars), m_pure_bool_convert(pure_bool_convert),
             m_rand_seed(seed), m_evaluator(eva), m_ism(ism), m_nlsat_clauses(nlsat_clauses), m_nlsat_atoms(nlsat_atoms),
             m_literal_activity_table(s),
 
@@ -313,6 +327,11 @@ namespace nlsat {
             m_num_clauses = m_clauses.size();
 
             m_hybrid_activity.resize(m_num_hybrid);
+            // clause indices of a previous check are stale once the
+            // clauses were simplified
+            m_hybrid_var_watched_clauses.reset();
+            m_hybrid_var_unit_clauses.reset();
+            m_hybrid_var_assigned_clauses.reset();
             m_hybrid_var_watched_clauses.resize(m_num_hybrid, var_vector());
             m_hybrid_var_unit_clauses.resize(m_num_hybrid, var_vector());
             m_hybrid_var_assigned_clauses.resize(m_num_hybrid, var_vector());
@@ -526,10 +545,43 @@ namespace nlsat {
         }
 
         void init_nof_conflicts(){
-            double rest_base = luby_restart ? luby(restart_inc, m_restart) : std::pow(restart_inc, m_restart);
+            if(m_restart_strategy == RESTART_EMA){
+                // the restart is decided by the moving averages, see check_restart_requirement
+                nof_conflicts = -1;
+                return;
+            }
+            double rest_base = m_restart_strategy == RESTART_LUBY ? luby(restart_inc, m_restart) : std::pow(restart_inc, m_restart);
             nof_conflicts = rest_base * restart_first;
         }
 
+        void set_restart_strategy(restart_strategy s, double margin, double blocking, double fast_alpha, double slow_alpha){
+            m_restart_strategy = s;
+            m_restart_margin = margin;
+            m_restart_blocking = blocking;
+            m_fast_lbd_avg.set_alpha(fast_alpha);
+            m_slow_lbd_avg.set_alpha(slow_alpha);
+            m_trail_avg.set_alpha(slow_alpha);
+        }
+
+        /**
+         * Glucose style restarts on the hybrid trail:
+         * lbd is the number of distinct stages in the new lemma, trail_size the number of
+         * assigned hybrid vars when the conflict was found. A conflict found on an unusually
+         * deep trail suggests the search is close to a model, so the next restart is postponed.
+         */
+        void update_restart_averages(unsigned lbd, unsigned trail_size){
+            m_ema_conflicts++;
+            m_fast_lbd_avg.update(lbd);
+            m_slow_lbd_avg.update(lbd);
+            if(m_restart_strategy == RESTART_EMA && m_ema_conflicts > ema_block_start &&
+               curr_conflicts >= ema_min_conflicts && trail_size > m_restart_blocking * m_trail_avg){
+                TRACE("wzh", std::cout << "[restart] block restart, trail: " << trail_size << ", avg: " << (double) m_trail_avg << std::endl;);
+                curr_conflicts = 0;
+                m_blocked_restarts++;
+            }
+            m_trail_avg.update(trail_size);
+        }
+
         static double luby(double y, int x){
             // Find the finite subsequence that contains index 'x', and the
             // size of that subsequence:
@@ -560,6 +612,24 @@ namespace nlsat {
             }
         }
 
+        // aggressive reduceDB under memory pressure, only the binary learned clauses are kept
+        unsigned reduce_learned(){
+            unsigned sz = m_learned.size();
+            unsigned j = 0;
+            for(unsigned i = 0; i < sz; i++){
+                if(m_learned[i]->size() > 2){
+                    m_solver.del_clause(m_learned[i]);
+                }
+                else{
+                    m_learned[j++] = m_learned[i];
+                }
+            }
+            m_learned.shrink(j);
+            m_learned_deleted += (sz - j);
+            TRACE("wzh", std::cout << "[reduce] memory reduceDB deleted " << (sz - j) << std::endl;);
+            return sz - j;
+        }
+
         // Comparator for reduceDB
         struct reduceDB_lt {
             bool operator()(clause const * cls1, clause const * cls2){
@@ -636,6 +706,9 @@ namespace nlsat {
         }
 
         bool check_restart_requirement(){
+            if(m_restart_strategy == RESTART_EMA){
+                return curr_conflicts >= ema_min_conflicts && m_fast_lbd_avg > m_restart_margin * m_slow_lbd_avg;
+            }
             return nof_conflicts >= 0 && curr_conflicts >= nof_conflicts;
         }
 
@@ -1175,6 +1248,30 @@ namespace nlsat {
             update_unit_bool_vars();
         }
 
+        /**
+         * * clauses watched by arith var x that become unit in an unassigned arith var once x is assigned
+         * * x must already be (tentatively) assigned, the watches are not modified
+        */
+        void collect_unit_clauses_after(var x, unsigned_vector & clauses, var_vector & vars) {
+            clauses.reset();
+            vars.reset();
+            hybrid_var hx = x + m_num_bool;
+            for(clause_index idx: m_hybrid_var_watched_clauses[hx]){
+                if(unit_clause_contains(idx)){
+                    continue;
+                }
+                auto * cls = m_nlsat_clauses[idx];
+                hybrid_var other = cls->get_another_watched_var(hx);
+                if(other == null_var || !is_arith_var(other) || m_assignment.is_assigned(other - m_num_bool)){
+                    continue;
+                }
+                if(select_watched_var_except(cls, other) == null_var){
+                    clauses.push_back(idx);
+                    vars.push_back(other - m_num_bool);
+                }
+            }
+        }
+
         bool unit_clause_contains(clause_index idx) const {
             for(auto ele: m_hybrid_var_unit_clauses){
                 if(ele.contains(idx)){
@@ -1696,8 +1793,8 @@ namespace nlsat {
     };
 
     Dynamic_manager::Dynamic_manager(nlsat_clause_vector & nlsat_clauses, nlsat_atom_vector & nlsat_atoms, anum_manager & am, pmanager & pm, assignment & ass, evaluator & eva, interval_set_manager & ism, svector<lbool> const & bvalues, bool_var_vector const & pure_bool_vars, bool_var_vector const & pure_bool_convert, solver & s, clause_vector const & clauses, clause_vector & learned, 
-    atom_vector const & atoms, unsigned & restart, unsigned & deleted, unsigned seed){
-        m_imp = alloc(imp, nlsat_clauses, nlsat_atoms, am, pm, ass, eva, ism, bvalues, pure_bool_vars, pure_bool_convert, s, clauses, learned, atoms, restart, deleted, seed);
+    atom_vector const & atoms, unsigned & restart, unsigned & blocked_restarts, unsigned & deleted, unsigned seed){
+        m_imp = alloc(imp, nlsat_clauses, nlsat_atoms, am, pm, ass, eva, ism, bvalues, pure_bool_vars, pure_bool_convert, s, clauses, learned, atoms, restart, blocked_restarts, deleted, seed);
     }
 
     Dynamic_manager::~Dynamic_manager(){
@@ -1721,10 +1818,22 @@ namespace nlsat {
         m_imp->init_nof_conflicts();
     }
 
+    void Dynamic_manager::set_restart_strategy(restart_strategy s, double margin, double blocking, double fast_alpha, double slow_alpha){
+        m_imp->set_restart_strategy(s, margin, blocking, fast_alpha, slow_alpha);
+    }
+
+    void Dynamic_manager::update_restart_averages(unsigned lbd, unsigned trail_size){
+        m_imp->update_restart_averages(lbd, trail_size);
+    }
+
     void Dynamic_manager::minimize_learned(){
         m_imp->minimize_learned();
     }
 
+    unsigned Dynamic_manager::reduce_learned(){
+        return m_imp->reduce_learned();
+    }
+
     void Dynamic_manager::reset_curr_conflicts(){
         m_imp->reset_curr_conflicts();
     }
@@ -1793,6 +1902,10 @@ namespace nlsat {
         m_imp->do_watched_clauses(x, is_bool);
     }
 
+    void Dynamic_manager::collect_unit_clauses_after(var x, unsigned_vector & clauses, var_vector & vars){
+        m_imp->collect_unit_clauses_after(x, clauses, vars);
+    }
+
     void Dynamic_manager::undo_watched_clauses(var x, bool is_bool){
         m_imp->undo_watched_clauses(x, is_bool);
     }
@@ -54,6 +54,15 @@ namespace nlsat {
         BOOL, ARITH, INIT, FINISH, SWITCH
     };
 
+    /**
+     * ^ GEOMETRIC: restart after restart_first * restart_inc^k conflicts
+     * ^ LUBY: restart after restart_first * luby(k) conflicts
+     * ^ EMA: glucose style, moving averages of lemma stage-lbd and trail size
+    */
+    enum restart_strategy {
+        RESTART_GEOMETRIC, RESTART_LUBY, RESTART_EMA
+    };
+
     /**
      * @brief manager of dynamic nlsat
     */
@@ -64,7 +73,7 @@ namespace nlsat {
         imp * m_imp;
     public:
         Dynamic_manager(nlsat_clause_vector & nlsat_clauses, nlsat_atom_vector & nlsat_atoms, anum_manager & am, pmanager & pm, assignment & ass, evaluator & eva, interval_set_manager & ism, svector<lbool> const & bvalues, bool_var_vector const & pure_bool_vars, bool_var_vector const & pure_bool_convert, solver & s, clause_vector const & clauses, clause_vector & learned, 
-        atom_vector const & atoms, unsigned & restart, unsigned & deleted, unsigned rand_seed);
+        atom_vector const & atoms, unsigned & restart, unsigned & blocked_restarts, unsigned & deleted, unsigned rand_seed);
         ~Dynamic_manager();
 
         // set number of arith vars
@@ -75,7 +84,11 @@ namespace nlsat {
         void init_learnt_management();
         void update_learnt_management();
         void init_nof_conflicts();
+        void set_restart_strategy(restart_strategy s, double margin, double blocking, double fast_alpha, double slow_alpha);
+        // lbd: number of stages in the new lemma, trail_size: assigned hybrid vars at the conflict
+        void update_restart_averages(unsigned lbd, unsigned trail_size);
         void minimize_learned();
+        unsigned reduce_learned();
 
         void reset_curr_conflicts();
         void inc_curr_conflicts();
@@ -113,6 +126,9 @@ namespace nlsat {
         void do_watched_clauses(hybrid_var x, bool is_bool);
         // for bool var: atom index
         void undo_watched_clauses(hybrid_var x, bool is_bool);
+        // clauses (and their unassigned arith var) that become unit once arith var x is assigned
+        // x must already be (tentatively) assigned
+        void collect_unit_clauses_after(var x, unsigned_vector & clauses, var_vector & vars);
 
         void find_next_process_clauses(var x, bool_var b, clause_vector & clauses, search_mode m_search_mode);
 
@@ -19,6 +19,7 @@ Revision History:
 --*/
 #include "nlsat/nlsat_evaluator.h"
 #include "nlsat/nlsat_solver.h"
+#include "nlsat/nlsat_profile.h"
 
 namespace nlsat {
 
@@ -27,6 +28,7 @@ namespace nlsat {
         assignment const &       m_assignment;
         pmanager &               m_pm;
         small_object_allocator & m_allocator;
+        profiler &               m_profiler;
         anum_manager &           m_am;
         interval_set_manager     m_ism;
         scoped_anum_vector       m_tmp_values;
@@ -58,6 +60,13 @@ namespace nlsat {
             
             sign_table(anum_manager & am):m_am(am) {}
 
+            size_t memory_size() const {
+                return m_sections.capacity() * sizeof(section) + 
+                    (m_sorted_sections.capacity() + m_poly_sections.capacity()) * sizeof(unsigned) +
+                    m_poly_signs.capacity() * sizeof(sign) + 
+                    m_info.capacity() * sizeof(poly_info);
+            }
+
             ~sign_table() {
                 reset();
             }
@@ -358,18 +367,38 @@ namespace nlsat {
         };
 
         sign_table m_sign_table_tmp;
-
-        imp(solver& s, assignment const & x2v, pmanager & pm, small_object_allocator & allocator):
+        // m_sign_table_tmp holds the factors of the family m_tmp_family at m_tmp_x
+        unsigned   m_tmp_family;
+        var        m_tmp_x;
+        unsigned   m_tmp_timestamp;
+
+        // sign of the product of the factors of each atom family, valid at m_family_timestamp[f]
+        svector<int>   m_family_sign;
+        unsigned_vector m_family_timestamp;
+
+        // clause-level sign table, shared by the literals of one clause
+        sign_table         m_clause_table;
+        var                m_clause_x;
+        ptr_vector<poly>   m_clause_polys;  // polynomial of each entry of m_clause_table
+        unsigned_vector    m_clause_ids;    // entries of m_clause_table of the polynomials of an atom
+
+        imp(solver& s, assignment const & x2v, pmanager & pm, small_object_allocator & allocator, profiler & prof):
             m_solver(s),
             m_assignment(x2v),
             m_pm(pm),
             m_allocator(allocator),
+            m_profiler(prof),
             m_am(m_assignment.am()),
             m_ism(m_am, allocator),
             m_tmp_values(m_am),
             m_add_roots_tmp(m_am),
             m_inf_tmp(m_am),
-            m_sign_table_tmp(m_am) {
+            m_sign_table_tmp(m_am),
+            m_tmp_family(UINT_MAX),
+            m_tmp_x(null_var),
+            m_tmp_timestamp(0),
+            m_clause_table(m_am),
+            m_clause_x(null_var) {
         }
 
         // var max_var(poly const * p) const {
@@ -441,6 +470,10 @@ namespace nlsat {
             SASSERT(all_assigned_ineq(a));
             // all variables of a were already assigned... 
             atom::kind k = a->get_kind();
+            unsigned f   = a->family();
+            unsigned ts  = m_assignment.timestamp();
+            if (f < m_family_sign.size() && m_family_timestamp[f] == ts)
+                return satisfied(m_family_sign[f], k, neg);
             unsigned sz  = a->size();
             int sign = 1;
             for (unsigned i = 0; i < sz; i++) {
@@ -451,6 +484,14 @@ namespace nlsat {
                 if (sign == 0)
                     break;
             }
+            if (f != UINT_MAX) {
+                if (f >= m_family_sign.size()) {
+                    m_family_sign.resize(f + 1, 0);
+                    m_family_timestamp.resize(f + 1, UINT_MAX);
+                }
+                m_family_sign[f]      = sign;
+                m_family_timestamp[f] = ts;
+            }
             return satisfied(sign, k, neg);
         }
 
@@ -461,7 +502,10 @@ namespace nlsat {
             atom::kind k = a->get_kind();
             scoped_anum_vector & roots = m_tmp_values;
             roots.reset();
-            m_am.isolate_roots(polynomial_ref(a->p(), m_pm), undef_var_assignment(m_assignment, a->x()), roots);
+            {
+                profiler::scope _ps(m_profiler, PROF_ISOLATE_ROOTS);
+                m_am.isolate_roots(polynomial_ref(a->p(), m_pm), undef_var_assignment(m_assignment, a->x()), roots);
+            }
             TRACE("nlsat_evaluator",
                   m_solver.display(tout << (neg?"!":""), *a); tout << "\n";
                   if (roots.empty()) {
@@ -508,17 +552,21 @@ namespace nlsat {
                 // TRACE("nlsat_evaluator", tout << "x: " << x << " max_var(p): " << m_pm.max_var(p) << "\n";);
                 // Note: I added undef_var_assignment in the following statement, to allow us to obtain the infeasible interval sets
                 // even when the maximal variable is assigned. I need this feature to minimize conflict cores.
-                m_am.isolate_roots(polynomial_ref(p, m_pm), undef_var_assignment(m_assignment, x), roots, signs);
+                {
+                    profiler::scope _ps(m_profiler, PROF_ISOLATE_ROOTS);
+                    m_am.isolate_roots(polynomial_ref(p, m_pm), undef_var_assignment(m_assignment, x), roots, signs);
+                }
                 t.add(roots, signs);
             }
         }
 
         // Evaluate the sign of p1^e1*...*pn^en (of atom a) in cell c of table t.
-        sign sign_at(ineq_atom * a, sign_table const & t, unsigned c) const {
+        // pi is the entry ids[i] of t, or the entry i if ids is nullptr.
+        sign sign_at(ineq_atom * a, sign_table const & t, unsigned const * ids, unsigned c) const {
             auto sign = sign_pos;
             unsigned num_ps = a->size();
             for (unsigned i = 0; i < num_ps; i++) {
-                ::sign curr_sign = t.sign_at(i, c);
+                ::sign curr_sign = t.sign_at(ids ? ids[i] : i, c);
                 TRACE("nlsat_evaluator_bug", tout << "sign of i: " << i << " at cell " << c << "\n"; 
                       m_pm.display(tout, a->p(i)); 
                       tout << "\nsign: " << curr_sign << "\n";);
@@ -533,20 +581,34 @@ namespace nlsat {
         
         interval_set_ref infeasible_intervals_ineq(ineq_atom * a, bool neg, clause const* cls, var x) {
             sign_table & table = m_sign_table_tmp;
-            table.reset();
             TRACE("nsat_evaluator", m_solver.display(tout, *a) << "\n";);
             unsigned num_ps = a->size();
+            // the atoms of a family have the same factors, hence the same table
+            if (a->family() != UINT_MAX && a->family() == m_tmp_family && x == m_tmp_x && 
+                m_assignment.timestamp() == m_tmp_timestamp)
+                return infeasible_intervals_ineq(a, neg, cls, table, nullptr);
+            table.reset();
+            m_tmp_family = UINT_MAX;
             // var x = a->max_var();
             for (unsigned i = 0; i < num_ps; i++) {
                 add(a->p(i), x, table);
                 TRACE("nlsat_evaluator_bug", tout << "table after:\n"; m_pm.display(tout, a->p(i)); tout << "\n"; table.display_raw(tout);); 
                 
             }
+            m_tmp_family    = a->family();
+            m_tmp_x         = x;
+            m_tmp_timestamp = m_assignment.timestamp();
             TRACE("nlsat_evaluator", 
                   tout << "sign table for:\n"; 
                   for (unsigned i = 0; i < num_ps; i++) { m_pm.display(tout, a->p(i)); tout << "\n"; }
                   table.display(tout););
+            return infeasible_intervals_ineq(a, neg, cls, table, nullptr);
+        }
 
+        /**
+           \brief Collect the infeasible intervals of a from a sign table that contains its polynomials.
+        */
+        interval_set_ref infeasible_intervals_ineq(ineq_atom * a, bool neg, clause const* cls, sign_table const & table, unsigned const * ids) {
             interval_set_ref result(m_ism);
             interval_set_ref set(m_ism);
             literal jst(a->bvar(), neg);
@@ -568,7 +630,7 @@ namespace nlsat {
                       tout << "prev_root_id: " << prev_root_id << "\n";
                       tout << "processing cell: " << c << "\n";
                       tout << "interval_set so far:\n" << result << "\n";);
-                int sign = sign_at(a, table, c);
+                int sign = sign_at(a, table, ids, c);
                 TRACE("nlsat_evaluator", tout << "sign: " << sign << "\n";);
                 if (satisfied(sign, k, neg)) {
                     // current cell is satisfied
@@ -652,7 +714,10 @@ namespace nlsat {
             // var x = a->max_var();
             // Note: I added undef_var_assignment in the following statement, to allow us to obtain the infeasible interval sets
             // even when the maximal variable is assigned. I need this feature to minimize conflict cores.
-            m_am.isolate_roots(polynomial_ref(a->p(), m_pm), undef_var_assignment(m_assignment, x), roots);
+            {
+                profiler::scope _ps(m_profiler, PROF_ISOLATE_ROOTS);
+                m_am.isolate_roots(polynomial_ref(a->p(), m_pm), undef_var_assignment(m_assignment, x), roots);
+            }
 
             if (i > roots.size()) {
                 // p does have sufficient roots
@@ -712,18 +777,51 @@ namespace nlsat {
         }
         
         interval_set_ref infeasible_intervals(atom * a, bool neg, clause const* cls, var x) {
+            profiler::scope _ps(m_profiler, PROF_INFEASIBLE);
             return a->is_ineq_atom() ? infeasible_intervals_ineq(to_ineq_atom(a), neg, cls, x) : infeasible_intervals_root(to_root_atom(a), neg, cls, x); 
         }
+
+        void start_clause(var x) {
+            m_clause_table.reset();
+            m_clause_polys.reset();
+            m_clause_x = x;
+        }
+
+        interval_set_ref clause_infeasible_intervals(atom * a, bool neg, clause const* cls) {
+            profiler::scope _ps(m_profiler, PROF_INFEASIBLE);
+            SASSERT(m_clause_x != null_var);
+            if (!a->is_ineq_atom())
+                return infeasible_intervals_root(to_root_atom(a), neg, cls, m_clause_x);
+            ineq_atom * ia = to_ineq_atom(a);
+            m_clause_ids.reset();
+            for (unsigned i = 0; i < ia->size(); i++) {
+                poly * p   = ia->p(i);
+                unsigned j = 0;
+                for (; j < m_clause_polys.size() && m_clause_polys[j] != p; j++);
+                if (j == m_clause_polys.size()) {
+                    add(p, m_clause_x, m_clause_table);
+                    m_clause_polys.push_back(p);
+                }
+                m_clause_ids.push_back(j);
+            }
+            TRACE("nlsat_evaluator", tout << "clause sign table:\n"; m_clause_table.display(tout););
+            return infeasible_intervals_ineq(ia, neg, cls, m_clause_table, m_clause_ids.data());
+        }
     };
     
-    evaluator::evaluator(solver& s, assignment const & x2v, pmanager & pm, small_object_allocator & allocator) {
-        m_imp = alloc(imp, s, x2v, pm, allocator);
+    evaluator::evaluator(solver& s, assignment const & x2v, pmanager & pm, small_object_allocator & allocator, profiler & prof) {
+        m_imp = alloc(imp, s, x2v, pm, allocator, prof);
     }
 
     evaluator::~evaluator() {
         dealloc(m_imp);
     }
 
+    size_t evaluator::memory_size() const {
+        return m_imp->m_sign_table_tmp.memory_size() + m_imp->m_clause_table.memory_size() +
+            (m_imp->m_clause_polys.capacity() + m_imp->m_clause_ids.capacity()) * sizeof(unsigned);
+    }
+
     interval_set_manager & evaluator::ism() const {
         return m_imp->m_ism;
     }
@@ -736,6 +834,14 @@ namespace nlsat {
         return m_imp->infeasible_intervals(a, neg, cls, x);
     }
 
+    void evaluator::start_clause(var x) {
+        m_imp->start_clause(x);
+    }
+
+    interval_set_ref evaluator::clause_infeasible_intervals(atom * a, bool neg, clause const* cls) {
+        return m_imp->clause_infeasible_intervals(a, neg, cls);
+    }
+
     void evaluator::push() {
         // do nothing
     }
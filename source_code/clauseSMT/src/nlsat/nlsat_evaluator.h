@@ -26,16 +26,23 @@ Revision History:
 namespace nlsat {
 
     class solver;
+    class profiler;
 
     class evaluator {
         struct imp;
         imp *  m_imp;
     public:
-        evaluator(solver& s, assignment const & x2v, pmanager & pm, small_object_allocator & allocator);
+        evaluator(solver& s, assignment const & x2v, pmanager & pm, small_object_allocator & allocator, profiler & prof);
         ~evaluator();
 
         interval_set_manager & ism() const;
 
+        /**
+           \brief Return the number of bytes of the sign tables, the interval sets are
+           accounted by ism().
+        */
+        size_t memory_size() const;
+
         /**
            \brief Evaluate the given literal in the current model.
            All variables in the atom must be assigned.
@@ -53,6 +60,20 @@ namespace nlsat {
         */
         interval_set_ref infeasible_intervals(atom * a, bool neg, clause const* cls, var x);
 
+        /**
+           \brief Start the evaluation of the literals of a clause for x.
+
+           The following calls to clause_infeasible_intervals share one sign table: a polynomial
+           occurring in several atoms of the clause has its roots isolated only once.
+           The table is only valid while the assignment is not changed.
+        */
+        void start_clause(var x);
+
+        /**
+           \brief Same as infeasible_intervals(a, neg, cls, x) for the x of the last start_clause.
+        */
+        interval_set_ref clause_infeasible_intervals(atom * a, bool neg, clause const* cls);
+
         void push();
         void pop(unsigned num_scopes);
     };
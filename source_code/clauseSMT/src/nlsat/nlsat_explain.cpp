@@ -19,6 +19,7 @@ Revision History:
 #include "nlsat/nlsat_explain.h"
 #include "nlsat/nlsat_assignment.h"
 #include "nlsat/nlsat_evaluator.h"
+#include "nlsat/nlsat_profile.h"
 #include "math/polynomial/algebraic_numbers.h"
 #include "util/ref_buffer.h"
 
@@ -161,9 +162,10 @@ namespace nlsat {
 
         evaluator &             m_evaluator;
         Dynamic_manager & m_dm;
+        profiler &              m_profiler;
 
         imp(solver & s, assignment const & x2v, polynomial::cache & u, atom_vector const & atoms, atom_vector const & x2eq,
-            evaluator & ev, Dynamic_manager & dm):
+            evaluator & ev, Dynamic_manager & dm, profiler & prof):
             m_solver(s),
             m_assignment(x2v),
             m_atoms(atoms),
@@ -181,7 +183,8 @@ namespace nlsat {
             m_core2(s),
             m_result(nullptr),
             m_evaluator(ev),
-            m_dm(dm)
+            m_dm(dm),
+            m_profiler(prof)
             {
             m_simplify_cores   = false;
             m_full_dimensional = false;
@@ -190,6 +193,7 @@ namespace nlsat {
         }
         
         ~imp() {
+            reset_min_sets();
         }
 
         std::ostream& display(std::ostream & out, polynomial_ref const & p) const {
@@ -285,6 +289,7 @@ namespace nlsat {
             // SASSERT(max_var(p) == x);
             SASSERT(max_stage_var_poly(p) == max_stage_var_poly(q));
             SASSERT(max_stage_var_poly(p) == x);
+            profiler::scope _ps(m_profiler, PROF_PSC_CHAIN);
             m_cache.psc_chain(p, q, x, result);
         }
         
@@ -1006,7 +1011,10 @@ namespace nlsat {
                 roots.reset();
                 // Variable y is assigned in m_assignment. We must temporarily unassign it.
                 // Otherwise, the isolate_roots procedure will assume p is a constant polynomial.
-                m_am.isolate_roots(p, undef_var_assignment(m_assignment, y), roots);
+                {
+                    profiler::scope _ps(m_profiler, PROF_ISOLATE_ROOTS);
+                    m_am.isolate_roots(p, undef_var_assignment(m_assignment, y), roots);
+                }
                 unsigned num_roots = roots.size();
                 TRACE("nlsat_explain", tout << "[debug] num roots: " << num_roots << std::endl;);
                 for (unsigned i = 0; i < num_roots; i++) {
@@ -1616,75 +1624,79 @@ namespace nlsat {
             }
         }
         
-        // Auxiliary method for core minimization.
-        literal_vector m_min_newtodo;
-        bool minimize_core(literal_vector & todo, literal_vector & core) {
-            SASSERT(!todo.empty());
-            literal_vector & new_todo = m_min_newtodo;
-            new_todo.reset();
+        // Core minimization (QuickXplain).
+        // m_min_sets[i] is the infeasible set of the i-th core literal. It is computed once
+        // per conflict, the search itself only takes unions of these sets.
+        ptr_vector<interval_set> m_min_sets;
+        unsigned_vector          m_min_core;
+
+        void reset_min_sets() {
+            interval_set_manager & ism = m_evaluator.ism();
+            for (interval_set * s : m_min_sets)
+                ism.dec_ref(s);
+            m_min_sets.reset();
+        }
+
+        /**
+           \brief Append to core a minimal subset of the candidates [lo, hi) that covers the
+           real line together with background.
+
+           \pre background together with m_min_sets[lo, hi) covers the real line.
+           has_delta is true if background was extended by the caller since the last test.
+        */
+        void quick_xplain(interval_set * background, bool has_delta, unsigned lo, unsigned hi, unsigned_vector & core) {
             interval_set_manager & ism = m_evaluator.ism();
+            if (has_delta && ism.is_full(background))
+                return;
+            if (hi - lo == 1) {
+                core.push_back(lo);
+                return;
+            }
+            unsigned mid = lo + (hi - lo) / 2;
             interval_set_ref r(ism);
-            // Copy the union of the infeasible intervals of core into r.
+            r = background;
+            for (unsigned i = lo; i < mid; i++)
+                r = ism.mk_union(r, m_min_sets[i]);
             unsigned sz = core.size();
-            for (unsigned i = 0; i < sz; i++) {
-                literal l = core[i];
-                atom * a  = m_atoms[l.var()];
-                SASSERT(a != 0);
-                // interval_set_ref inf = m_evaluator.infeasible_intervals(a, l.sign(), nullptr);
-                interval_set_ref inf = m_evaluator.infeasible_intervals(a, l.sign(), nullptr, m_dm.max_stage_or_unassigned_atom(a));
-                r = ism.mk_union(inf, r);
-                if (ism.is_full(r)) {
-                    // Done
-                    return false;
-                }
-            }
-            TRACE("nlsat_minimize", tout << "interval set after adding partial core:\n" << r << "\n";);
-            if (todo.size() == 1) {
-                // Done
-                core.push_back(todo[0]);
-                return false;
-            }
-            // Copy the union of the infeasible intervals of todo into r until r becomes full.
-            sz = todo.size();
-            for (unsigned i = 0; i < sz; i++) {
-                literal l = todo[i];
-                atom * a  = m_atoms[l.var()];
-                SASSERT(a != 0);
-                // interval_set_ref inf = m_evaluator.infeasible_intervals(a, l.sign(), nullptr);
-                interval_set_ref inf = m_evaluator.infeasible_intervals(a, l.sign(), nullptr, m_dm.max_stage_or_unassigned_atom(a));
-                r = ism.mk_union(inf, r);
-                if (ism.is_full(r)) {
-                    // literal l must be in the core
-                    core.push_back(l);
-                    new_todo.swap(todo);
-                    return !todo.empty();
-                }
-                else {
-                    new_todo.push_back(l);
-                }
-            }
-            UNREACHABLE();
-            return true;
+            quick_xplain(r, true, mid, hi, core);
+            r = background;
+            for (unsigned i = sz; i < core.size(); i++)
+                r = ism.mk_union(r, m_min_sets[core[i]]);
+            quick_xplain(r, core.size() > sz, lo, mid, core);
         }
 
-        literal_vector m_min_todo;
-        literal_vector m_min_core;
         void minimize(unsigned num, literal const * ls, scoped_literal_vector & r) {
-            literal_vector & todo = m_min_todo;
-            literal_vector & core = m_min_core;
-            todo.reset(); core.reset();
-            todo.append(num, ls);
-            while (true) {
-                TRACE("nlsat_minimize", tout << "core minimization:\n"; display(tout, todo); tout << "\nCORE:\n"; display(tout, core) << "\n";);
-                if (!minimize_core(todo, core))
-                    break;
-                std::reverse(todo.begin(), todo.end());
-                TRACE("nlsat_minimize", tout << "core minimization:\n"; display(tout, todo); tout << "\nCORE:\n"; display(tout, core) << "\n";);
-                if (!minimize_core(todo, core))
-                    break;
+            interval_set_manager & ism = m_evaluator.ism();
+            reset_min_sets();
+            interval_set_ref all(ism);
+            for (unsigned i = 0; i < num; i++) {
+                atom * a = m_atoms[ls[i].var()];
+                if (a == nullptr) {
+                    // boolean literal, the interval sets do not justify it
+                    reset_min_sets();
+                    r.append(num, ls);
+                    return;
+                }
+                interval_set_ref inf = m_evaluator.infeasible_intervals(a, ls[i].sign(), nullptr, m_dm.max_stage_or_unassigned_atom(a));
+                ism.inc_ref(inf);
+                m_min_sets.push_back(inf);
+                all = ism.mk_union(all, inf);
+            }
+            if (!ism.is_full(all)) {
+                // the core is not justified by the interval sets alone
+                TRACE("nlsat_minimize", tout << "core is not covered by infeasible intervals:\n" << all << "\n";);
+                reset_min_sets();
+                r.append(num, ls);
+                return;
             }
-            TRACE("nlsat_minimize", tout << "core:\n"; display(tout, core););
-            r.append(core.size(), core.data());
+            m_min_core.reset();
+            quick_xplain(nullptr, false, 0, num, m_min_core);
+            // keep the original order of the literals
+            std::sort(m_min_core.begin(), m_min_core.end());
+            for (unsigned i : m_min_core)
+                r.push_back(ls[i]);
+            TRACE("nlsat_minimize", tout << "core:\n"; display(tout, r.size(), r.data()) << "\n";);
+            reset_min_sets();
         }
 
         void process(unsigned num, literal const * ls) {
@@ -1874,7 +1886,10 @@ namespace nlsat {
                 p = ps.get(i);
                 scoped_anum_vector & roots = m_roots_tmp;
                 roots.reset();
-                m_am.isolate_roots(p, undef_var_assignment(m_assignment, x), roots);
+                {
+                    profiler::scope _ps(m_profiler, PROF_ISOLATE_ROOTS);
+                    m_am.isolate_roots(p, undef_var_assignment(m_assignment, x), roots);
+                }
                 for (auto const& r : roots) {
                     int s = m_am.compare(x_val, r);
                     SASSERT(s != 0);
@@ -2029,7 +2044,10 @@ namespace nlsat {
                 p = m_ps.get(i);
                 scoped_anum_vector & roots = m_roots_tmp;
                 roots.reset();
-                m_am.isolate_roots(p, undef_var_assignment(m_assignment, x), roots);
+                {
+                    profiler::scope _ps(m_profiler, PROF_ISOLATE_ROOTS);
+                    m_am.isolate_roots(p, undef_var_assignment(m_assignment, x), roots);
+                }
                 for (unsigned j = 0; j < roots.size(); ++j) {
                     int s = m_am.compare(x_val, roots[j]);
                     if (s <= 0 && (unbounded || m_am.compare(roots[j], val) <= 0)) {
@@ -2043,8 +2061,8 @@ namespace nlsat {
     };
 
     explain::explain(solver & s, assignment const & x2v, polynomial::cache & u, 
-                     atom_vector const& atoms, atom_vector const& x2eq, evaluator & ev, Dynamic_manager & dm) {
-        m_imp = alloc(imp, s, x2v, u, atoms, x2eq, ev, dm);
+                     atom_vector const& atoms, atom_vector const& x2eq, evaluator & ev, Dynamic_manager & dm, profiler & prof) {
+        m_imp = alloc(imp, s, x2v, u, atoms, x2eq, ev, dm, prof);
     }
 
     explain::~explain() {
@@ -2084,6 +2102,10 @@ namespace nlsat {
         (*m_imp)(n, ls, result);
     }
 
+    void explain::minimize(unsigned n, literal const * ls, scoped_literal_vector & result) {
+        m_imp->minimize(n, ls, result);
+    }
+
     void explain::project(var x, unsigned n, literal const * ls, scoped_literal_vector & result) {
         m_imp->project(x, n, ls, result);
     }
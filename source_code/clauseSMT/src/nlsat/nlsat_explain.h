@@ -28,6 +28,8 @@ namespace nlsat {
     class evaluator;
 
     
+    class profiler;
+
     class explain {
     public:
         struct imp;
@@ -35,7 +37,7 @@ namespace nlsat {
         imp * m_imp;
     public:
         explain(solver & s, assignment const & x2v, polynomial::cache & u, 
-                atom_vector const& atoms, atom_vector const& x2eq, evaluator & ev, Dynamic_manager & dm);
+                atom_vector const& atoms, atom_vector const& x2eq, evaluator & ev, Dynamic_manager & dm, profiler & prof);
         ~explain();
 
         void reset();
@@ -66,6 +68,12 @@ namespace nlsat {
         // void operator()(unsigned n, literal const * ls, var_vector const & dynamic, scoped_literal_vector & result);
         void operator()(unsigned n, literal const * ls, scoped_literal_vector & result);
 
+        /**
+           \brief Store in result a minimal subset of ls[0], ..., ls[n-1] whose infeasible
+           intervals cover the real line, or all of them when the intervals do not cover it.
+           This is the core minimization of operator() when minimize_cores is set.
+        */
+        void minimize(unsigned n, literal const * ls, scoped_literal_vector & result);
         
         /**
            \brief projection for a given variable.
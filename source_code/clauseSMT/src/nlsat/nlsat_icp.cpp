@@ -0,0 +1,342 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_icp.cpp
+
+Abstract:
+
+    Interval constraint propagation over the unit clauses of nlsat.
+
+    Every unit literal over a single odd polynomial p constrains p to a
+    target interval T (p < 0, p = 0, p >= 0, ...). For each variable x of
+    degree one in p = A*x + R the bounds of x are narrowed to
+    (T - I(R)) / I(A) whenever I(A) does not contain zero, and the literal
+    is in conflict if I(p) and T are disjoint.
+
+    Only unit clauses without assumptions are used, so the derived bounds
+    are consequences of the input clauses and are added as input clauses.
+    A bound that is already a unit clause is not added again, so the
+    propagation can be rerun on every check.
+
+Revision History:
+
+--*/
+#include "util/uint_set.h"
+#include "math/interval/interval.h"
+#include "nlsat/nlsat_icp.h"
+#include "nlsat/nlsat_solver.h"
+
+namespace nlsat {
+
+    struct icp::imp {
+        typedef interval_manager<im_default_config> imanager;
+        typedef imanager::interval interval;
+        typedef _scoped_interval<imanager> scoped_interval;
+
+        // p is constrained to the target interval of the literal
+        struct unit {
+            literal m_lit;
+            poly*   m_p;
+            var_vector m_xs;    // variables of degree one in p
+            unsigned m_coeffs;  // index of A, R of m_xs[0] in m_coeffs
+        };
+
+        solver&                s;
+        unsynch_mpq_manager    m_qm;
+        mpq                    m_zero;
+        imanager               m_im;
+        pmanager&              m_pm;
+        atom_vector const&     m_atoms;
+        clause_vector&         m_clauses;
+        unsigned               m_max_rounds;
+        unsigned               m_max_bits;
+        vector<unit>           m_units;
+        uint_set               m_asserted;  // literals of the unit clauses without assumptions
+        polynomial_ref_vector  m_coeffs;
+        ptr_vector<interval>   m_box;
+        bool_vector            m_lower_derived, m_upper_derived;
+        bool                   m_changed;
+
+        imp(solver& s, reslimit& lim, pmanager& pm, atom_vector const& atoms, clause_vector& clauses):
+            s(s),
+            m_im(lim, im_default_config(m_qm)),
+            m_pm(pm),
+            m_atoms(atoms),
+            m_clauses(clauses),
+            m_max_rounds(8),
+            m_max_bits(128),
+            m_coeffs(pm),
+            m_changed(false) {}
+
+        ~imp() {
+            reset_box();
+        }
+
+        void reset_box() {
+            for (interval* i : m_box) {
+                m_im.del(*i);
+                dealloc(i);
+            }
+            m_box.reset();
+            m_lower_derived.reset();
+            m_upper_derived.reset();
+        }
+
+        void init_box() {
+            reset_box();
+            for (var x = 0; x < s.num_vars(); ++x)
+                m_box.push_back(alloc(interval));
+            m_lower_derived.resize(s.num_vars(), false);
+            m_upper_derived.resize(s.num_vars(), false);
+        }
+
+        unsigned operator()() {
+            init_box();
+            init_units();
+            if (m_units.empty())
+                return 0;
+            for (unsigned r = 0; r < m_max_rounds; ++r) {
+                m_changed = false;
+                for (unit const& u : m_units) {
+                    if (!propagate(u)) {
+                        TRACE("nlsat_icp", s.display(tout << "icp conflict at ", u.m_lit) << "\n";);
+                        literal lit = false_literal;
+                        if (m_asserted.contains(lit.index()))
+                            return 0;
+                        s.mk_clause(1, &lit, false, nullptr);
+                        return 1;
+                    }
+                }
+                if (!m_changed)
+                    break;
+            }
+            return mk_bound_clauses();
+        }
+
+        //
+        // Units
+        //
+
+        void init_units() {
+            m_units.reset();
+            m_coeffs.reset();
+            m_asserted.reset();
+            for (clause* c : m_clauses) {
+                if (c->size() != 1 || c->assumptions() != nullptr)
+                    continue;
+                literal lit = (*c)[0];
+                m_asserted.insert(lit.index());
+                atom* a = m_atoms[lit.var()];
+                if (!a || !a->is_ineq_atom())
+                    continue;
+                ineq_atom const& ia = *to_ineq_atom(a);
+                if (ia.size() != 1 || ia.is_even(0))
+                    continue;
+                unit u;
+                u.m_lit = lit;
+                u.m_p = ia.p(0);
+                u.m_coeffs = m_coeffs.size();
+                var_vector xs;
+                m_pm.vars(u.m_p, xs);
+                polynomial_ref A(m_pm), R(m_pm);
+                for (var x : xs) {
+                    if (m_pm.degree(u.m_p, x) != 1)
+                        continue;
+                    A = m_pm.coeff(u.m_p, x, 1, R);
+                    u.m_xs.push_back(x);
+                    m_coeffs.push_back(A);
+                    m_coeffs.push_back(R);
+                }
+                m_units.push_back(u);
+            }
+        }
+
+        // p < 0, p > 0, p = 0 and their negations
+        void target(literal lit, interval& t) {
+            atom::kind k = m_atoms[lit.var()]->get_kind();
+            m_im.reset(t);
+            bool sign = lit.sign();
+            if (k == atom::EQ && !sign)
+                m_im.set(t, m_zero);
+            else if ((k == atom::LT && !sign) || (k == atom::GT && sign))
+                set_upper(t, m_zero, !sign);
+            else if ((k == atom::GT && !sign) || (k == atom::LT && sign))
+                set_lower(t, m_zero, !sign);
+        }
+
+        bool is_diseq(literal lit) const {
+            return lit.sign() && m_atoms[lit.var()]->get_kind() == atom::EQ;
+        }
+
+        bool propagate(unit const& u) {
+            scoped_interval t(m_im), ip(m_im), ia(m_im), ir(m_im), d(m_im), x_range(m_im);
+            eval(u.m_p, ip);
+            if (is_diseq(u.m_lit))
+                return !m_im.is_zero(ip);
+            target(u.m_lit, t);
+            if (disjoint(ip, t))
+                return false;
+            for (unsigned i = 0; i < u.m_xs.size(); ++i) {
+                var x = u.m_xs[i];
+                eval(m_coeffs.get(u.m_coeffs + 2 * i), ia);
+                if (m_im.contains_zero(ia))
+                    continue;
+                eval(m_coeffs.get(u.m_coeffs + 2 * i + 1), ir);
+                m_im.sub(t, ir, d);
+                m_im.div(d, ia, x_range);
+                if (!tighten(x, x_range, u.m_xs.size() > 1 || !m_pm.is_const(m_coeffs.get(u.m_coeffs + 2 * i + 1))))
+                    return false;
+            }
+            return true;
+        }
+
+        //
+        // Interval evaluation over the current box
+        //
+
+        void eval(poly* p, interval& r) {
+            scoped_interval m(m_im), pw(m_im), tmp(m_im);
+            scoped_mpq c(m_qm);
+            m_im.set(r, m_zero);
+            unsigned sz = m_pm.size(p);
+            for (unsigned i = 0; i < sz; ++i) {
+                polynomial::monomial* mon = m_pm.get_monomial(p, i);
+                m_qm.set(c, m_pm.coeff(p, i));
+                m_im.set(m, c);
+                for (unsigned j = 0; j < m_pm.size(mon); ++j) {
+                    m_im.power(*m_box[m_pm.get_var(mon, j)], m_pm.degree(mon, j), pw);
+                    m_im.mul(m, pw, tmp);
+                    m_im.set(m, tmp);
+                }
+                m_im.add(r, m, tmp);
+                m_im.set(r, tmp);
+                if (m_im.lower_is_inf(r) && m_im.upper_is_inf(r))
+                    return;
+            }
+        }
+
+        // all values of a are less than all values of b
+        bool before(interval const& a, interval const& b) {
+            if (a.m_upper_inf || b.m_lower_inf)
+                return false;
+            return m_qm.lt(a.m_upper, b.m_lower) || (m_qm.eq(a.m_upper, b.m_lower) && (a.m_upper_open || b.m_lower_open));
+        }
+
+        bool disjoint(interval const& a, interval const& b) {
+            return before(a, b) || before(b, a);
+        }
+
+        //
+        // Bounds
+        //
+
+        void set_lower(interval& i, mpq const& v, bool open) {
+            m_qm.set(i.m_lower, v);
+            i.m_lower_inf = false;
+            i.m_lower_open = open;
+        }
+
+        void set_upper(interval& i, mpq const& v, bool open) {
+            m_qm.set(i.m_upper, v);
+            i.m_upper_inf = false;
+            i.m_upper_open = open;
+        }
+
+        bool tighten(var x, interval const& r, bool derived) {
+            interval& b = *m_box[x];
+            scoped_mpq v(m_qm);
+            if (!r.m_lower_inf && m_qm.bitsize(r.m_lower) <= m_max_bits) {
+                m_qm.set(v, r.m_lower);
+                bool open = r.m_lower_open;
+                if (s.is_int(x)) {
+                    if (open && m_qm.is_int(v))
+                        m_qm.inc(v);
+                    else
+                        m_qm.ceil(v, v);
+                    open = false;
+                }
+                if (b.m_lower_inf || m_qm.gt(v, b.m_lower) || (m_qm.eq(v, b.m_lower) && open && !b.m_lower_open)) {
+                    set_lower(b, v, open);
+                    m_lower_derived[x] = derived;
+                    m_changed = true;
+                }
+            }
+            if (!r.m_upper_inf && m_qm.bitsize(r.m_upper) <= m_max_bits) {
+                m_qm.set(v, r.m_upper);
+                bool open = r.m_upper_open;
+                if (s.is_int(x)) {
+                    if (open && m_qm.is_int(v))
+                        m_qm.dec(v);
+                    else
+                        m_qm.floor(v, v);
+                    open = false;
+                }
+                if (b.m_upper_inf || m_qm.lt(v, b.m_upper) || (m_qm.eq(v, b.m_upper) && open && !b.m_upper_open)) {
+                    set_upper(b, v, open);
+                    m_upper_derived[x] = derived;
+                    m_changed = true;
+                }
+            }
+            if (b.m_lower_inf || b.m_upper_inf)
+                return true;
+            if (m_qm.gt(b.m_lower, b.m_upper))
+                return false;
+            return !m_qm.eq(b.m_lower, b.m_upper) || (!b.m_lower_open && !b.m_upper_open);
+        }
+
+        // x >= v, x > v, x <= v, x < v as d*x - n compared with 0
+        literal mk_bound_literal(var x, mpq const& v, bool lower, bool open) {
+            rational r(v);
+            rational d = denominator(r), n = numerator(r);
+            polynomial_ref p(m_pm);
+            p = m_pm.mk_linear(1, &d, &x, -n);
+            poly* ps = p.get();
+            bool is_even = false;
+            if (lower)
+                return open ? s.mk_ineq_literal(atom::GT, 1, &ps, &is_even) : ~s.mk_ineq_literal(atom::LT, 1, &ps, &is_even);
+            else
+                return open ? s.mk_ineq_literal(atom::LT, 1, &ps, &is_even) : ~s.mk_ineq_literal(atom::GT, 1, &ps, &is_even);
+        }
+
+        unsigned mk_bound_clauses() {
+            unsigned n = 0;
+            for (var x = 0; x < m_box.size(); ++x) {
+                interval const& b = *m_box[x];
+                literal lits[2];
+                unsigned sz = 0;
+                if (m_lower_derived[x] && !b.m_lower_inf)
+                    lits[sz++] = mk_bound_literal(x, b.m_lower, true, b.m_lower_open);
+                if (m_upper_derived[x] && !b.m_upper_inf)
+                    lits[sz++] = mk_bound_literal(x, b.m_upper, false, b.m_upper_open);
+                for (unsigned i = 0; i < sz; ++i) {
+                    if (m_asserted.contains(lits[i].index()))
+                        continue;
+                    m_asserted.insert(lits[i].index());
+                    TRACE("nlsat_icp", s.display(tout << "icp bound ", lits[i]) << "\n";);
+                    s.mk_clause(1, lits + i, false, nullptr);
+                    ++n;
+                }
+            }
+            return n;
+        }
+    };
+
+    icp::icp(solver& s, reslimit& lim, pmanager& pm, atom_vector const& atoms, clause_vector& clauses) {
+        m_imp = alloc(imp, s, lim, pm, atoms, clauses);
+    }
+
+    icp::~icp() {
+        dealloc(m_imp);
+    }
+
+    void icp::set_max_rounds(unsigned n) {
+        m_imp->m_max_rounds = n;
+    }
+
+    unsigned icp::operator()() {
+        return (*m_imp)();
+    }
+
+};
@@ -0,0 +1,42 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_icp.h
+
+Abstract:
+
+    Interval constraint propagation over the unit clauses of nlsat.
+    Bounds of the arithmetic variables are propagated through the
+    polynomials of the asserted unit literals, derived bounds (and
+    conflicts) are added as unit clauses, so the Dynamic_manager turns
+    them into justified infeasible sets before any variable is assigned.
+
+Revision History:
+
+--*/
+#pragma once
+
+#include "util/rlimit.h"
+#include "nlsat/nlsat_types.h"
+#include "nlsat/nlsat_clause.h"
+
+namespace nlsat {
+    class icp {
+        struct imp;
+        imp * m_imp;
+    public:
+        icp(solver& s, reslimit& lim, pmanager & pm, atom_vector const& atoms, clause_vector& clauses);
+        ~icp();
+
+        void set_max_rounds(unsigned n);
+
+        /**
+           \brief Propagate the bounds of the unit clauses without assumptions.
+           Return the number of unit clauses added, a conflict is added as the
+           clause (false). Bounds that are already unit clauses are skipped.
+        */
+        unsigned operator()();
+    };
+}
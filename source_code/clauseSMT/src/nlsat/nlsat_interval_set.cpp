@@ -108,7 +108,8 @@ namespace nlsat {
 
     interval_set_manager::interval_set_manager(anum_manager & m, small_object_allocator & a):
         m_am(m),
-        m_allocator(a) {
+        m_allocator(a),
+        m_num_bytes(0) {
             set_const_anum();
     }
      
@@ -125,6 +126,7 @@ namespace nlsat {
             m_am.del(s->m_intervals[i].m_upper);
         }
         s->~interval_set();
+        m_num_bytes -= obj_sz;
         m_allocator.deallocate(obj_sz, s);
     }
 
@@ -149,6 +151,7 @@ namespace nlsat {
                                             bool upper_open, bool upper_inf, anum const & upper,
                                             literal justification, clause const* cls) {
         void * mem = m_allocator.allocate(interval_set::get_obj_size(1));
+        m_num_bytes += interval_set::get_obj_size(1);
         interval_set * new_set = new (mem) interval_set();
         new_set->m_num_intervals = 1;
         new_set->m_ref_count  = 0;
@@ -262,9 +265,10 @@ namespace nlsat {
                   i.m_justification);
     }
 
-    inline interval_set * mk_interval(small_object_allocator & allocator, interval_buffer & buf, bool full) {
+    inline interval_set * mk_interval(small_object_allocator & allocator, size_t & num_bytes, interval_buffer & buf, bool full) {
         unsigned sz = buf.size();
         void * mem = allocator.allocate(interval_set::get_obj_size(sz));
+        num_bytes += interval_set::get_obj_size(sz);
         interval_set * new_set = new (mem) interval_set();
         new_set->m_full = full;
         new_set->m_ref_count  = 0;
@@ -522,7 +526,7 @@ namespace nlsat {
                 found_slack = true;
         }
         // Create new interval set
-        interval_set * new_set = mk_interval(m_allocator, result, !found_slack);
+        interval_set * new_set = mk_interval(m_allocator, m_num_bytes, result, !found_slack);
         SASSERT(check_interval_set(m_am, sz, new_set->m_intervals));
         return new_set;
     }
@@ -711,7 +715,7 @@ namespace nlsat {
         interval_buffer result;
         push_back(m_am, result, s->m_intervals[idx]);
         bool found_slack  = !result[0].m_lower_inf || !result[0].m_upper_inf;
-        interval_set * new_set = mk_interval(m_allocator, result, !found_slack);
+        interval_set * new_set = mk_interval(m_allocator, m_num_bytes, result, !found_slack);
         SASSERT(check_interval_set(m_am, result.size(), new_set->m_intervals));
         return new_set;
     }
@@ -753,7 +757,7 @@ namespace nlsat {
         inter2.m_upper_open = true;
         push_back(m_am, result, inter2);
 
-        return mk_interval(m_allocator, result, false);
+        return mk_interval(m_allocator, m_num_bytes, result, false);
     }
 
     interval_set * interval_set_manager::mk_complement(interval_set const * s){
@@ -801,7 +805,7 @@ namespace nlsat {
             push_back(m_am, result, inter);
         }
         // bool found_slack  = !result[0].m_lower_inf || !result[num-1].m_upper_inf;
-        return mk_interval(m_allocator, result, false);
+        return mk_interval(m_allocator, m_num_bytes, result, false);
     }
 
     // s1 /\ s2 = !(!s1 \/ !s2)
@@ -817,6 +821,26 @@ namespace nlsat {
         return mk_complement(mk_union(mk_complement(s1), mk_complement(s2)));
     }
 
+    bool interval_set_manager::contains(interval_set const * s, anum const & w) const {
+        if (s == nullptr)
+            return false;
+        for (unsigned i = 0; i < s->m_num_intervals; i++) {
+            interval const & curr = s->m_intervals[i];
+            if (!curr.m_lower_inf) {
+                ::sign c = m_am.compare(w, curr.m_lower);
+                if (c < 0 || (c == 0 && curr.m_lower_open))
+                    continue;
+            }
+            if (!curr.m_upper_inf) {
+                ::sign c = m_am.compare(w, curr.m_upper);
+                if (c > 0 || (c == 0 && curr.m_upper_open))
+                    continue;
+            }
+            return true;
+        }
+        return false;
+    }
+
     bool interval_set_manager::contains_zero(interval_set const * s) const {
         if(s == nullptr){
             return false;
@@ -905,7 +929,15 @@ namespace nlsat {
         
         if (n > 0)
             return;
-        
+
+        peek_point_in_complement(s, w);
+    }
+
+    /**
+       \brief All gaps of s are points, select one of them, a rational one if possible.
+    */
+    void interval_set_manager::peek_point_in_complement(interval_set const * s, anum & w) {
+        unsigned num = num_intervals(s);
         // Try to find a rational
         unsigned irrational_i = UINT_MAX;
         for (unsigned i = 1; i < num; i++) {
@@ -925,6 +957,172 @@ namespace nlsat {
         m_am.set(w, s->m_intervals[irrational_i].m_upper);
     }
 
+    /**
+       \brief Store in r the simplest rational (smallest denominator, then smallest absolute value)
+       in the open interval (l, u). l_inf/u_inf mark infinite ends.
+       This is the continued fraction descent of the Stern-Brocot tree.
+    */
+    static void simplest_rational(unsynch_mpq_manager & qm, mpq const & l, bool l_inf, mpq const & u, bool u_inf, mpq & r) {
+        if ((l_inf || qm.is_neg(l)) && (u_inf || qm.is_pos(u))) {
+            qm.reset(r);
+            return;
+        }
+        if (!u_inf && !qm.is_pos(u)) {
+            // (l, u) is negative: mirror it
+            scoped_mpq nl(qm), nu(qm);
+            qm.set(nl, u);
+            qm.neg(nl);
+            if (!l_inf) {
+                qm.set(nu, l);
+                qm.neg(nu);
+            }
+            simplest_rational(qm, nl, false, nu, l_inf, r);
+            qm.neg(r);
+            return;
+        }
+        // 0 <= l < u
+        SASSERT(!l_inf && !qm.is_neg(l));
+        scoped_mpq n(qm), n1(qm);
+        qm.floor(l, n);
+        mpq one(1);
+        qm.add(n, one, n1);
+        if (u_inf || qm.lt(n1, u)) {
+            qm.set(r, n1);
+            return;
+        }
+        // n <= l < u <= n + 1: r = n + 1/y with y in (1/(u - n), 1/(l - n))
+        scoped_mpq lo(qm), hi(qm), y(qm);
+        qm.sub(u, n, lo);
+        qm.inv(lo);
+        bool hi_inf = qm.eq(l, n);
+        if (!hi_inf) {
+            qm.sub(l, n, hi);
+            qm.inv(hi);
+        }
+        simplest_rational(qm, lo, false, hi, hi_inf, y);
+        qm.inv(y);
+        qm.add(y, n, r);
+    }
+
+    /**
+       \brief Store in r the integer of smallest absolute value in (l, u). Return false if there is none.
+    */
+    static bool simplest_integer(unsynch_mpq_manager & qm, mpq const & l, bool l_inf, mpq const & u, bool u_inf, mpq & r) {
+        if ((l_inf || qm.is_neg(l)) && (u_inf || qm.is_pos(u))) {
+            qm.reset(r);
+            return true;
+        }
+        mpq one(1);
+        if (!u_inf && !qm.is_pos(u)) {
+            qm.ceil(u, r);
+            qm.sub(r, one, r);
+            return l_inf || qm.lt(l, r);
+        }
+        qm.floor(l, r);
+        qm.add(r, one, r);
+        return u_inf || qm.lt(r, u);
+    }
+
+    /**
+       \brief Rational inner approximation (l, u) of the i-th gap of s, i.e., the gap before the i-th
+       interval (i = num_intervals(s) is the gap after the last one).
+       Algebraic ends are refined until l < u.
+    */
+    void interval_set_manager::gap_bounds(interval_set const * s, unsigned i, mpq & l, bool & l_inf, mpq & u, bool & u_inf) {
+        unsigned num = num_intervals(s);
+        l_inf = i == 0;
+        u_inf = i == num;
+        unsigned precision = 8;
+        while (true) {
+            if (!l_inf)
+                m_am.get_upper(s->m_intervals[i-1].m_upper, l, precision);
+            if (!u_inf)
+                m_am.get_lower(s->m_intervals[i].m_lower, u, precision);
+            if (l_inf || u_inf || m_am.qm().lt(l, u))
+                return;
+            precision *= 2;
+        }
+    }
+
+    /**
+       \brief Return true if the i-th gap of s (see gap_bounds) is a non-empty open interval.
+    */
+    bool interval_set_manager::is_open_gap(interval_set const * s, unsigned i) {
+        unsigned num = num_intervals(s);
+        if (i == 0)
+            return !s->m_intervals[0].m_lower_inf;
+        if (i == num)
+            return !s->m_intervals[num-1].m_upper_inf;
+        return m_am.lt(s->m_intervals[i-1].m_upper, s->m_intervals[i].m_lower);
+    }
+
+    /**
+       \brief Store in c the simplest rational of the i-th gap of s, an integer if is_int and the
+       gap contains one. Return true if c is such an integer.
+    */
+    bool interval_set_manager::simplest_in_gap(interval_set const * s, unsigned i, bool is_int, mpq & c) {
+        unsynch_mpq_manager & qm = m_am.qm();
+        scoped_mpq l(qm), u(qm);
+        bool l_inf, u_inf;
+        gap_bounds(s, i, l, l_inf, u, u_inf);
+        if (is_int && simplest_integer(qm, l, l_inf, u, u_inf, c))
+            return true;
+        simplest_rational(qm, l, l_inf, u, u_inf, c);
+        return false;
+    }
+
+    void interval_set_manager::peek_simplest_in_complement(interval_set const * s, bool is_int, anum & w) {
+        SASSERT(!is_full(s));
+        if (s == nullptr) {
+            m_am.set(w, 0);
+            return;
+        }
+        unsynch_mpq_manager & qm = m_am.qm();
+        scoped_mpq c(qm), best(qm);
+        unsigned best_bits = UINT_MAX;
+        bool best_is_int = false;
+        unsigned num = num_intervals(s);
+        for (unsigned i = 0; i <= num; i++) {
+            if (!is_open_gap(s, i))
+                continue;
+            bool c_is_int = simplest_in_gap(s, i, is_int, c);
+            unsigned bits = qm.bitsize(c.get().numerator()) + qm.bitsize(c.get().denominator());
+            if ((c_is_int && !best_is_int) || (c_is_int == best_is_int && bits < best_bits)) {
+                best_bits = bits;
+                best_is_int = c_is_int;
+                qm.set(best, c);
+            }
+        }
+        if (best_bits != UINT_MAX) {
+            TRACE("nlsat_interval", tout << "simplest witness: " << qm.to_string(best) << " in " << s << "\n";);
+            m_am.set(w, best);
+            return;
+        }
+        peek_point_in_complement(s, w);
+    }
+
+    void interval_set_manager::peek_cell_witnesses(interval_set const * s, bool is_int, unsigned max_cells, scoped_anum_vector & ws) {
+        SASSERT(!is_full(s));
+        scoped_anum w(m_am);
+        if (s == nullptr) {
+            ws.push_back(w);
+            return;
+        }
+        unsynch_mpq_manager & qm = m_am.qm();
+        scoped_mpq c(qm);
+        unsigned num = num_intervals(s);
+        for (unsigned i = 0; i <= num && ws.size() < max_cells; i++) {
+            if (is_open_gap(s, i)) {
+                simplest_in_gap(s, i, is_int, c);
+                m_am.set(w, c);
+                ws.push_back(w);
+            }
+            else if (0 < i && i < num && s->m_intervals[i-1].m_upper_open && s->m_intervals[i].m_lower_open) {
+                ws.push_back(s->m_intervals[i-1].m_upper);
+            }
+        }
+    }
+
     std::ostream& interval_set_manager::display(std::ostream & out, interval_set const * s) const {
         if (s == nullptr) {
             out << "{}";
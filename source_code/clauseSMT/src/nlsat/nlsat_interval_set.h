@@ -40,14 +40,24 @@ namespace nlsat {
         anum_manager &           m_am;
         small_object_allocator & m_allocator;
         svector<char>            m_already_visited;
+        mutable size_t           m_num_bytes;     // bytes of the live interval sets
         random_gen               m_rand;
         void del(interval_set * s);
+        void peek_point_in_complement(interval_set const * s, anum & w);
+        void gap_bounds(interval_set const * s, unsigned i, mpq & l, bool & l_inf, mpq & u, bool & u_inf);
+        bool is_open_gap(interval_set const * s, unsigned i);
+        bool simplest_in_gap(interval_set const * s, unsigned i, bool is_int, mpq & c);
     public:
         interval_set_manager(anum_manager & m, small_object_allocator & a);
         ~interval_set_manager();
         
         void set_seed(unsigned s) { m_rand.set_seed(s); }
 
+        /**
+           \brief Return the number of bytes of the live interval sets.
+        */
+        size_t memory_size() const { return m_num_bytes; }
+
         /**
            \brief Return the empty set.
         */
@@ -98,6 +108,11 @@ namespace nlsat {
 
         bool complement_single(interval_set const *s);
 
+        /**
+           \brief Return true if w is in s.
+        */
+        bool contains(interval_set const * s, anum const & w) const;
+
         /**
            `\brief Return true if s1 is a subset of s2.
         */
@@ -135,6 +150,27 @@ namespace nlsat {
            \pre !is_full(s)
         */
         void peek_in_complement(interval_set const * s, bool is_int, anum & w, bool randomize);
+
+        /**
+           \brief Select a witness w in the complement of s with the fewest bits.
+
+           Every gap of s is approximated by an open interval with rational ends, and the
+           simplest rational of that interval (smallest denominator, see the Stern-Brocot tree)
+           is a candidate; integers are preferred when is_int. The witness is the candidate
+           with the smallest bit-size. Irrational witnesses are only selected when every
+           feasible cell is a point.
+
+           \pre !is_full(s)
+        */
+        void peek_simplest_in_complement(interval_set const * s, bool is_int, anum & w);
+
+        /**
+           \brief Append to ws one witness for each feasible cell of s, at most max_cells in total:
+           the simplest rational of every open gap, and the point of every point gap.
+
+           \pre !is_full(s)
+        */
+        void peek_cell_witnesses(interval_set const * s, bool is_int, unsigned max_cells, scoped_anum_vector & ws);
     };
 
     typedef obj_ref<interval_set, interval_set_manager> interval_set_ref;
@@ -0,0 +1,522 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_local_search.cpp
+
+Abstract:
+
+    Stochastic local search for nlsat with cell-jump moves.
+
+    Every arithmetic variable has a rational value and every Boolean
+    variable a truth value. A falsified clause is picked at random and
+    for each literal of the clause the candidate moves are:
+
+    - a pure Boolean literal: flip its variable.
+    - an arithmetic literal: for each variable x of the atom, the other
+      variables are fixed and each factor p of the atom becomes a
+      univariate polynomial in x. The candidate values of x are one
+      sample of every cell of the roots of p (below the least root,
+      between two consecutive roots, the rational roots, above the
+      greatest root), integer samples for integer variables.
+
+    Moves are scored by the weighted number of clauses they satisfy minus
+    the weighted number of clauses they falsify. When no move improves,
+    the weights of the falsified clauses are increased and the best move
+    is applied anyway.
+
+    The local search owns its managers, the clauses are copied on
+    construction, so it only touches the solver from the constructor.
+    Root atoms are not supported, the search gives up immediately if
+    one is present.
+
+Revision History:
+
+--*/
+#include <mutex>
+#include <atomic>
+#include "util/util.h"
+#include "util/small_object_allocator.h"
+#include "math/polynomial/algebraic_numbers.h"
+#include "nlsat/nlsat_local_search.h"
+#include "nlsat/nlsat_solver.h"
+#include "nlsat/nlsat_params.hpp"
+
+namespace nlsat {
+
+    struct local_search::imp {
+
+        // arithmetic atom as the factors m_polys[m_begin..m_end) compared with 0
+        struct ls_atom {
+            bool       m_arith;
+            atom::kind m_kind;
+            unsigned   m_begin;
+            unsigned   m_end;
+            var_vector m_vars;
+            ls_atom(): m_arith(false), m_kind(atom::EQ), m_begin(0), m_end(0) {}
+        };
+
+        // current values, m_excluded is left symbolic by substitute
+        struct value_map : public polynomial::var2mpq {
+            imp & m_imp;
+            var   m_excluded;
+            value_map(imp & i): m_imp(i), m_excluded(null_var) {}
+            unsynch_mpq_manager & m() const override { return m_imp.m_qm; }
+            bool contains(var x) const override { return x != m_excluded; }
+            mpq const & operator()(var x) const override { return m_imp.m_values[x]; }
+        };
+
+        reslimit               m_limit;
+        small_object_allocator m_allocator;
+        unsynch_mpq_manager    m_qm;
+        pmanager               m_pm;
+        anum_manager           m_am;
+        random_gen             m_rand;
+        unsigned               m_max_flips;
+        unsigned               m_max_bits;
+        bool                   m_supported;
+
+        bool_vector            m_is_int;
+        polynomial_ref_vector  m_polys;
+        bool_vector            m_even;
+        vector<ls_atom>        m_atoms;        // indexed by bool_var
+        vector<literal_vector> m_clauses;
+        vector<unsigned_vector> m_bool2clauses;
+        vector<unsigned_vector> m_var2atoms;
+
+        // assignment
+        scoped_mpq_vector      m_values;
+        bool_vector            m_bvalues;
+        value_map              m_vmap;
+        unsigned_vector        m_weights;
+        unsigned_vector        m_num_true;
+        unsigned_vector        m_unsat;
+        unsigned_vector        m_unsat_idx;
+
+        // move scoring
+        bool_var_vector        m_changed;
+        svector<int>           m_delta;
+        unsigned_vector        m_touched;
+        scoped_mpq_vector      m_cands;
+        scoped_mpq             m_tmp;
+        scoped_mpq             m_best_v;
+        var                    m_best_x;
+        bool_var               m_best_b;
+
+        // best assignment, read by the solver thread
+        mutable std::mutex     m_mutex;
+        vector<rational>       m_best_values;
+        svector<lbool>         m_best_bvalues;
+        unsigned               m_best_unsat;
+        bool                   m_has_best;
+        std::atomic<bool>      m_sat;
+
+        unsigned               m_flips;
+        unsigned               m_weight_updates;
+
+        imp(solver & s, atom_vector const & atoms, clause_vector const & clauses, params_ref const & p):
+            m_allocator("nlsat_local_search"),
+            m_pm(m_limit, m_qm, &m_allocator),
+            m_am(m_limit, m_qm, p, &m_allocator),
+            m_max_bits(256),
+            m_supported(true),
+            m_polys(m_pm),
+            m_values(m_qm),
+            m_vmap(*this),
+            m_cands(m_qm),
+            m_tmp(m_qm),
+            m_best_v(m_qm),
+            m_best_x(null_var),
+            m_best_b(null_bool_var),
+            m_best_unsat(UINT_MAX),
+            m_has_best(false),
+            m_sat(false),
+            m_flips(0),
+            m_weight_updates(0) {
+            nlsat_params np(p);
+            m_max_flips = np.local_search_max_flips();
+            m_rand.set_seed(np.seed());
+            for (var x = 0; x < s.num_vars(); ++x)
+                m_is_int.push_back(s.is_int(x));
+            m_var2atoms.resize(s.num_vars());
+            m_atoms.resize(atoms.size());
+            m_bool2clauses.resize(atoms.size());
+            for (bool_var b = 0; b < atoms.size(); ++b) {
+                atom * a = atoms[b];
+                if (a == nullptr)
+                    continue;
+                if (!a->is_ineq_atom()) {
+                    m_supported = false;
+                    return;
+                }
+                ineq_atom const & ia = *to_ineq_atom(a);
+                ls_atom & la = m_atoms[b];
+                la.m_arith = true;
+                la.m_kind  = ia.get_kind();
+                la.m_begin = m_polys.size();
+                var_vector xs;
+                for (unsigned i = 0; i < ia.size(); ++i) {
+                    m_polys.push_back(convert(s.pm(), ia.p(i), m_pm));
+                    m_even.push_back(ia.is_even(i));
+                    xs.reset();
+                    m_pm.vars(ia.p(i), xs);
+                    for (var x : xs)
+                        if (!la.m_vars.contains(x))
+                            la.m_vars.push_back(x);
+                }
+                la.m_end = m_polys.size();
+                for (var x : la.m_vars)
+                    m_var2atoms[x].push_back(b);
+            }
+            for (clause * c : clauses) {
+                if (c->is_removed())
+                    continue;
+                unsigned idx = m_clauses.size();
+                m_clauses.push_back(literal_vector());
+                for (literal l : *c) {
+                    m_clauses.back().push_back(l);
+                    unsigned_vector & occs = m_bool2clauses[l.var()];
+                    if (occs.empty() || occs.back() != idx)
+                        occs.push_back(idx);
+                }
+            }
+        }
+
+        //
+        // Evaluation
+        //
+
+        bool eval_atom(bool_var b) {
+            ls_atom const & la = m_atoms[b];
+            int s = 1;
+            for (unsigned i = la.m_begin; i < la.m_end; ++i) {
+                m_pm.eval(m_polys.get(i), m_vmap, m_tmp);
+                if (m_qm.is_zero(m_tmp)) {
+                    s = 0;
+                    break;
+                }
+                if (m_qm.is_neg(m_tmp) && !m_even[i])
+                    s = -s;
+            }
+            switch (la.m_kind) {
+            case atom::EQ: return s == 0;
+            case atom::LT: return s < 0;
+            case atom::GT: return s > 0;
+            default: UNREACHABLE(); return false;
+            }
+        }
+
+        bool is_true(literal l) const {
+            return m_bvalues[l.var()] != l.sign();
+        }
+
+        bool is_fixed(bool_var b) const {
+            return b == true_bool_var;
+        }
+
+        void add_unsat(unsigned ci) {
+            m_unsat_idx[ci] = m_unsat.size();
+            m_unsat.push_back(ci);
+        }
+
+        void remove_unsat(unsigned ci) {
+            unsigned idx = m_unsat_idx[ci];
+            unsigned last = m_unsat.back();
+            m_unsat[idx] = last;
+            m_unsat_idx[last] = idx;
+            m_unsat.pop_back();
+            m_unsat_idx[ci] = UINT_MAX;
+        }
+
+        void init() {
+            m_values.reset();
+            m_values.resize(m_is_int.size());
+            m_vmap.m_excluded = null_var;
+            m_bvalues.reset();
+            m_bvalues.resize(m_atoms.size(), false);
+            for (bool_var b = 0; b < m_atoms.size(); ++b) {
+                if (m_atoms[b].m_arith)
+                    m_bvalues[b] = eval_atom(b);
+                else if (is_fixed(b))
+                    m_bvalues[b] = true;
+                else
+                    m_bvalues[b] = m_rand(2) == 0;
+            }
+            m_weights.reset();
+            m_weights.resize(m_clauses.size(), 1);
+            m_num_true.reset();
+            m_num_true.resize(m_clauses.size(), 0);
+            m_unsat.reset();
+            m_unsat_idx.reset();
+            m_unsat_idx.resize(m_clauses.size(), UINT_MAX);
+            m_delta.reset();
+            m_delta.resize(m_clauses.size(), 0);
+            for (unsigned ci = 0; ci < m_clauses.size(); ++ci) {
+                for (literal l : m_clauses[ci])
+                    if (is_true(l))
+                        m_num_true[ci]++;
+                if (m_num_true[ci] == 0)
+                    add_unsat(ci);
+            }
+        }
+
+        //
+        // Moves
+        //
+
+        // weighted number of clauses satisfied minus falsified by flipping m_changed
+        int score_changed() {
+            for (bool_var b : m_changed) {
+                for (unsigned ci : m_bool2clauses[b]) {
+                    if (m_delta[ci] == 0 && !m_touched.contains(ci))
+                        m_touched.push_back(ci);
+                    for (literal l : m_clauses[ci])
+                        if (l.var() == b)
+                            m_delta[ci] += is_true(l) ? -1 : 1;
+                }
+            }
+            int score = 0;
+            for (unsigned ci : m_touched) {
+                int was = m_num_true[ci] > 0;
+                int now = static_cast<int>(m_num_true[ci]) + m_delta[ci] > 0;
+                score += static_cast<int>(m_weights[ci]) * (now - was);
+                m_delta[ci] = 0;
+            }
+            m_touched.reset();
+            return score;
+        }
+
+        // atoms of x that change their value with x := v
+        void collect_changed(var x, mpq const & v) {
+            m_changed.reset();
+            scoped_mpq old(m_qm);
+            m_qm.set(old, m_values[x]);
+            m_qm.set(m_values[x], v);
+            for (bool_var b : m_var2atoms[x])
+                if (eval_atom(b) != m_bvalues[b])
+                    m_changed.push_back(b);
+            m_qm.set(m_values[x], old);
+        }
+
+        void add_candidate(var x, anum const & w) {
+            if (!m_am.is_rational(w))
+                return;
+            if (m_is_int[x] && !m_am.is_int(w))
+                return;
+            scoped_mpq v(m_qm);
+            m_am.to_rational(w, v);
+            if (m_qm.bitsize(v) > m_max_bits || m_qm.eq(v, m_values[x]))
+                return;
+            m_cands.push_back(v);
+        }
+
+        // one sample of each cell of the factors of b in x, the other variables fixed
+        void cell_samples(bool_var b, var x) {
+            ls_atom const & la = m_atoms[b];
+            m_cands.reset();
+            m_vmap.m_excluded = x;
+            polynomial_ref q(m_pm);
+            scoped_anum_vector roots(m_am);
+            scoped_anum w(m_am);
+            for (unsigned i = la.m_begin; i < la.m_end; ++i) {
+                q = m_pm.substitute(m_polys.get(i), m_vmap);
+                if (m_pm.is_const(q))
+                    continue;
+                roots.reset();
+                m_am.isolate_roots(q, roots);
+                if (roots.empty())
+                    continue;
+                m_am.int_lt(roots[0], w);
+                add_candidate(x, w);
+                for (unsigned j = 0; j < roots.size(); ++j) {
+                    add_candidate(x, roots[j]);
+                    if (j + 1 == roots.size())
+                        break;
+                    if (m_is_int[x]) {
+                        m_am.int_gt(roots[j], w);
+                        add_candidate(x, w);
+                        m_am.int_lt(roots[j + 1], w);
+                        add_candidate(x, w);
+                    }
+                    else {
+                        m_am.select(roots[j], roots[j + 1], w);
+                        add_candidate(x, w);
+                    }
+                }
+                m_am.int_gt(roots.back(), w);
+                add_candidate(x, w);
+            }
+            m_vmap.m_excluded = null_var;
+        }
+
+        // keep the best move, ties are broken at random
+        void consider(int score, var x, mpq const * v, bool_var b, int & best, unsigned & num_ties) {
+            if (score < best)
+                return;
+            if (score == best) {
+                ++num_ties;
+                if (m_rand(num_ties) != 0)
+                    return;
+            }
+            else
+                num_ties = 1;
+            best = score;
+            m_best_x = x;
+            m_best_b = b;
+            if (v)
+                m_qm.set(m_best_v, *v);
+        }
+
+        bool pick_move(unsigned ci, int & best) {
+            best = INT_MIN;
+            unsigned num_ties = 0;
+            m_best_x = null_var;
+            m_best_b = null_bool_var;
+            for (literal l : m_clauses[ci]) {
+                bool_var b = l.var();
+                if (is_fixed(b))
+                    continue;
+                if (!m_atoms[b].m_arith) {
+                    m_changed.reset();
+                    m_changed.push_back(b);
+                    consider(score_changed(), null_var, nullptr, b, best, num_ties);
+                    continue;
+                }
+                for (var x : m_atoms[b].m_vars) {
+                    cell_samples(b, x);
+                    for (unsigned i = 0; i < m_cands.size(); ++i) {
+                        collect_changed(x, m_cands[i]);
+                        // the move must satisfy the literal it was sampled for
+                        if (!m_changed.contains(b))
+                            continue;
+                        consider(score_changed(), x, &m_cands[i], null_bool_var, best, num_ties);
+                    }
+                }
+            }
+            return best != INT_MIN;
+        }
+
+        void apply_changed() {
+            for (bool_var b : m_changed) {
+                m_bvalues[b] = !m_bvalues[b];
+                for (unsigned ci : m_bool2clauses[b]) {
+                    for (literal l : m_clauses[ci]) {
+                        if (l.var() != b)
+                            continue;
+                        if (is_true(l)) {
+                            if (m_num_true[ci]++ == 0)
+                                remove_unsat(ci);
+                        }
+                        else if (--m_num_true[ci] == 0)
+                            add_unsat(ci);
+                    }
+                }
+            }
+        }
+
+        void apply_move() {
+            if (m_best_x != null_var) {
+                collect_changed(m_best_x, m_best_v);
+                m_qm.set(m_values[m_best_x], m_best_v);
+            }
+            else {
+                m_changed.reset();
+                m_changed.push_back(m_best_b);
+            }
+            apply_changed();
+        }
+
+        void update_weights() {
+            ++m_weight_updates;
+            for (unsigned ci : m_unsat)
+                m_weights[ci]++;
+        }
+
+        void save_best() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_best_unsat = m_unsat.size();
+            m_best_values.reset();
+            for (unsigned x = 0; x < m_values.size(); ++x)
+                m_best_values.push_back(rational(m_values[x]));
+            m_best_bvalues.reset();
+            for (bool_var b = 0; b < m_bvalues.size(); ++b)
+                m_best_bvalues.push_back(to_lbool(m_bvalues[b]));
+            m_has_best = true;
+        }
+
+        lbool search() {
+            if (!m_supported)
+                return l_undef;
+            init();
+            save_best();
+            while (!m_unsat.empty()) {
+                if (!m_limit.inc() || m_flips >= m_max_flips)
+                    return l_undef;
+                ++m_flips;
+                unsigned ci = m_unsat[m_rand(m_unsat.size())];
+                int best;
+                if (!pick_move(ci, best))
+                    continue;
+                if (best <= 0)
+                    update_weights();
+                apply_move();
+                if (m_unsat.size() < m_best_unsat)
+                    save_best();
+            }
+            m_sat = true;
+            return l_true;
+        }
+
+        lbool operator()() {
+            try {
+                return search();
+            }
+            catch (z3_exception &) {
+                // canceled while isolating roots
+                return l_undef;
+            }
+        }
+
+        bool get_best(vector<rational> & values, svector<lbool> & bvalues) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_has_best)
+                return false;
+            values.reset();
+            values.append(m_best_values);
+            bvalues.reset();
+            bvalues.append(m_best_bvalues);
+            return true;
+        }
+    };
+
+    local_search::local_search(solver & s, atom_vector const & atoms, clause_vector const & clauses, params_ref const & p) {
+        m_imp = alloc(imp, s, atoms, clauses, p);
+    }
+
+    local_search::~local_search() {
+        dealloc(m_imp);
+    }
+
+    lbool local_search::operator()() {
+        return (*m_imp)();
+    }
+
+    void local_search::cancel() {
+        m_imp->m_limit.cancel();
+    }
+
+    bool local_search::is_sat() const {
+        return m_imp->m_sat;
+    }
+
+    bool local_search::get_best(vector<rational> & values, svector<lbool> & bvalues) const {
+        return m_imp->get_best(values, bvalues);
+    }
+
+    void local_search::collect_statistics(statistics & st) const {
+        st.update("nlsat local search flips", m_imp->m_flips);
+        st.update("nlsat local search weight updates", m_imp->m_weight_updates);
+    }
+
+};
@@ -0,0 +1,66 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_local_search.h
+
+Abstract:
+
+    Stochastic local search over rational assignments of the nlsat
+    clauses. A move assigns a variable of an atom of a falsified clause
+    to a sample of a cell of the atom's polynomials (cell-jump), the
+    other variables being fixed.
+
+    The clauses are copied into managers owned by the local search, so
+    it can run in a thread next to the search of the solver. The best
+    assignment found so far can be read from the solver thread.
+
+Revision History:
+
+--*/
+#pragma once
+
+#include "util/params.h"
+#include "util/rational.h"
+#include "util/rlimit.h"
+#include "util/statistics.h"
+#include "nlsat/nlsat_types.h"
+#include "nlsat/nlsat_clause.h"
+
+namespace nlsat {
+    class local_search {
+        struct imp;
+        imp * m_imp;
+    public:
+        /**
+           \brief Copy the clauses of s, must be called from the thread of s.
+        */
+        local_search(solver & s, atom_vector const & atoms, clause_vector const & clauses, params_ref const & p);
+        ~local_search();
+
+        /**
+           \brief Search until all clauses are satisfied (l_true), the flip budget
+           is exhausted or the search is canceled (l_undef).
+        */
+        lbool operator()();
+
+        /**
+           \brief Thread-safe cancellation.
+        */
+        void cancel();
+
+        /**
+           \brief Return true if a model was found, thread-safe.
+        */
+        bool is_sat() const;
+
+        /**
+           \brief Copy the best assignment found so far, thread-safe.
+           Return false if there is none yet.
+        */
+        bool get_best(vector<rational> & values, svector<lbool> & bvalues) const;
+
+        void collect_statistics(statistics & st) const;
+    };
+}
@@ -10,6 +10,7 @@ struct nlsat_params {
      p(_p), g(gparams::get_module("nlsat")) {}
   static void collect_param_descrs(param_descrs & d) {
     d.insert("max_memory", CPK_UINT, "maximum amount of memory in megabytes", "4294967295","nlsat");
+    d.insert("soft_max_memory", CPK_UINT, "soft memory limit in megabytes, when it is reached the lemmas are reduced to the binary ones and the polynomial caches are flushed at the next restart, max_memory is enforced afterwards (0: 90% of max_memory)", "0","nlsat");
     d.insert("linxi_simple_check", CPK_BOOL, "linxi precheck about variables sign", "false","nlsat");
     d.insert("lazy", CPK_UINT, "how lazy the solver is.", "0","nlsat");
     d.insert("reorder", CPK_BOOL, "reorder variables.", "true","nlsat");
@@ -21,14 +22,36 @@ struct nlsat_params {
     d.insert("max_conflicts", CPK_UINT, "maximum number of conflicts.", "4294967295","nlsat");
     d.insert("shuffle_vars", CPK_BOOL, "use a random variable order.", "false","nlsat");
     d.insert("inline_vars", CPK_BOOL, "inline variables that can be isolated from equations (not supported in incremental mode)", "false","nlsat");
+    d.insert("simplify", CPK_BOOL, "preprocess clauses before the search: subsumption, and elimination of variables defined by linear or unconstrained equalities (no variable elimination in incremental mode)", "false","nlsat");
     d.insert("seed", CPK_UINT, "random seed.", "0","nlsat");
     d.insert("factor", CPK_BOOL, "factor polynomials produced during conflict resolution.", "true","nlsat");
+    d.insert("trace_file", CPK_SYMBOL, "write a compact binary trace of the explained conflicts to the given file (replay it with 'test-z3 nlsat_replay <file>')", "","nlsat");
+    d.insert("profile", CPK_BOOL, "time the hot paths of the search (root isolation, projection, clause discovery, ...) and report the times in the statistics", "false","nlsat");
+    d.insert("profile_trace_file", CPK_SYMBOL, "write the profiled scopes in Chrome trace format to the given file (implies profile)", "","nlsat");
+    d.insert("profile_trace_seconds", CPK_UINT, "only the first given number of seconds are written to profile_trace_file", "10","nlsat");
+    d.insert("restart", CPK_SYMBOL, "restart strategy of the dynamic search: geometric, luby or ema", "geometric","nlsat");
+    d.insert("restart.margin", CPK_DOUBLE, "ema restarts: restart when the fast average of the lemma stage-lbd exceeds the slow one by this factor", "1.1","nlsat");
+    d.insert("restart.blocking", CPK_DOUBLE, "ema restarts: postpone the restart when the hybrid trail is deeper than its average by this factor", "1.4","nlsat");
+    d.insert("restart.emafastglue", CPK_DOUBLE, "ema restarts: alpha factor of the fast moving average", "0.03","nlsat");
+    d.insert("restart.emaslowglue", CPK_DOUBLE, "ema restarts: alpha factor of the slow moving averages", "1e-05","nlsat");
+    d.insert("witness", CPK_SYMBOL, "witness selection in the feasible set of a variable: dyadic (a small dyadic rational in the first feasible cell) or simplest (the rational of fewest bits over all feasible cells)", "dyadic","nlsat");
+    d.insert("lookahead", CPK_BOOL, "sample one witness per feasible cell of the arith var and keep the one that blocks the fewest clauses of the unassigned arith vars", "false","nlsat");
+    d.insert("lookahead.max_cells", CPK_UINT, "maximum number of feasible cells scored by the witness look-ahead (at least 2)", "16","nlsat");
+    d.insert("icp", CPK_BOOL, "propagate the bounds of the unit constraints with interval arithmetic before the search, derived bounds are added as unit clauses", "false","nlsat");
+    d.insert("icp.max_rounds", CPK_UINT, "maximum number of interval propagation rounds over the unit constraints", "8","nlsat");
+    d.insert("linear_relaxation", CPK_BOOL, "check a linear relaxation of the asserted arithmetic literals, with the nonlinear monomials abstracted as fresh variables, in an incremental simplex during the search", "false","nlsat");
+    d.insert("local_search", CPK_BOOL, "run a stochastic local search with cell-jump moves in a thread next to the search, a model found by the local search is returned and its best assignment is used as a phase at restarts", "false","nlsat");
+    d.insert("local_search.max_flips", CPK_UINT, "maximum number of moves of the local search", "1000000","nlsat");
+    d.insert("fast_load", CPK_BOOL, "solve SMT-LIB2 files that only assert Boolean combinations of polynomial constraints over reals (QF_NRA) by loading them directly into nlsat, other files are processed by the regular front-end", "false","nlsat");
+    d.insert("assumption_lemmas", CPK_BOOL, "keep the lemmas that depend on the assumptions of a check, as clauses with the negation of these assumptions, instead of deleting them after the check", "false","nlsat");
+    d.insert("family_clauses", CPK_BOOL, "add the binary clauses not (p < 0) or not (p = 0), not (p < 0) or not (p > 0) and not (p = 0) or not (p > 0) between the atoms over the same polynomial p", "false","nlsat");
   }
   /*
      REG_MODULE_PARAMS('nlsat', 'nlsat_params::collect_param_descrs')
      REG_MODULE_DESCRIPTION('nlsat', 'nonlinear solver')
   */
   unsigned max_memory() const { return p.get_uint("max_memory", g, 4294967295u); }
+  unsigned soft_max_memory() const { return p.get_uint("soft_max_memory", g, 0u); }
   bool linxi_simple_check() const { return p.get_bool("linxi_simple_check", g, false); }
   unsigned lazy() const { return p.get_uint("lazy", g, 0u); }
   bool reorder() const { return p.get_bool("reorder", g, true); }
@@ -40,7 +63,28 @@ struct nlsat_params {
   unsigned max_conflicts() const { return p.get_uint("max_conflicts", g, 4294967295u); }
   bool shuffle_vars() const { return p.get_bool("shuffle_vars", g, false); }
   bool inline_vars() const { return p.get_bool("inline_vars", g, false); }
+  bool simplify() const { return p.get_bool("simplify", g, false); }
   unsigned seed() const { return p.get_uint("seed", g, 0u); }
   bool factor() const { return p.get_bool("factor", g, true); }
+  symbol trace_file() const { return p.get_sym("trace_file", g, symbol("")); }
+  bool profile() const { return p.get_bool("profile", g, false); }
+  symbol profile_trace_file() const { return p.get_sym("profile_trace_file", g, symbol("")); }
+  unsigned profile_trace_seconds() const { return p.get_uint("profile_trace_seconds", g, 10u); }
+  symbol restart() const { return p.get_sym("restart", g, symbol("geometric")); }
+  double restart_margin() const { return p.get_double("restart.margin", g, 1.1); }
+  double restart_blocking() const { return p.get_double("restart.blocking", g, 1.4); }
+  double restart_emafastglue() const { return p.get_double("restart.emafastglue", g, 0.03); }
+  double restart_emaslowglue() const { return p.get_double("restart.emaslowglue", g, 1e-05); }
+  symbol witness() const { return p.get_sym("witness", g, symbol("dyadic")); }
+  bool lookahead() const { return p.get_bool("lookahead", g, false); }
+  unsigned lookahead_max_cells() const { return p.get_uint("lookahead.max_cells", g, 16u); }
+  bool icp() const { return p.get_bool("icp", g, false); }
+  unsigned icp_max_rounds() const { return p.get_uint("icp.max_rounds", g, 8u); }
+  bool linear_relaxation() const { return p.get_bool("linear_relaxation", g, false); }
+  bool local_search() const { return p.get_bool("local_search", g, false); }
+  unsigned local_search_max_flips() const { return p.get_uint("local_search.max_flips", g, 1000000u); }
+  bool fast_load() const { return p.get_bool("fast_load", g, false); }
+  bool assumption_lemmas() const { return p.get_bool("assumption_lemmas", g, false); }
+  bool family_clauses() const { return p.get_bool("family_clauses", g, false); }
 };
 #endif
@@ -0,0 +1,108 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_profile.cpp
+
+Abstract:
+
+    Call counters and scoped timers for the hot paths of the nlsat search.
+
+Revision History:
+
+--*/
+#include "nlsat/nlsat_profile.h"
+#include "nlsat/nlsat_types.h"
+
+namespace nlsat {
+
+    // statistics keeps the key pointers, so all names are static.
+    static char const * g_phase_names[PROF_NUM_PHASES] = {
+        "select var",
+        "find clauses",
+        "process arith",
+        "resolve",
+        "explain",
+        "infeasible intervals",
+        "isolate roots",
+        "psc chain"
+    };
+
+    static char const * g_call_keys[PROF_NUM_PHASES] = {
+        "nlsat calls select var",
+        "nlsat calls find clauses",
+        "nlsat calls process arith",
+        "nlsat calls resolve",
+        "nlsat calls explain",
+        "nlsat calls infeasible intervals",
+        "nlsat calls isolate roots",
+        "nlsat calls psc chain"
+    };
+
+    static char const * g_time_keys[PROF_NUM_PHASES] = {
+        "nlsat time select var",
+        "nlsat time find clauses",
+        "nlsat time process arith",
+        "nlsat time resolve",
+        "nlsat time explain",
+        "nlsat time infeasible intervals",
+        "nlsat time isolate roots",
+        "nlsat time psc chain"
+    };
+
+    profiler::profiler():
+        m_enabled(false),
+        m_trace_seconds(0),
+        m_first_event(true) {
+        reset();
+    }
+
+    profiler::~profiler() {
+        if (m_trace)
+            *m_trace << "\n]\n";
+    }
+
+    void profiler::set_trace(std::string const & file_name, unsigned seconds) {
+        if (m_trace) {
+            *m_trace << "\n]\n";
+            m_trace = nullptr;
+        }
+        m_trace_seconds = seconds;
+        m_first_event = true;
+        if (file_name.empty())
+            return;
+        m_trace = alloc(std::ofstream, file_name, std::ios::out | std::ios::trunc);
+        if (!*m_trace)
+            throw solver_exception("could not open nlsat profile trace file");
+        *m_trace << "[";
+    }
+
+    void profiler::reset() {
+        m_start = clock::now();
+        for (unsigned i = 0; i < PROF_NUM_PHASES; ++i) {
+            m_calls[i] = 0;
+            m_seconds[i] = 0;
+        }
+    }
+
+    void profiler::trace_event(profile_phase p, clock::time_point start, clock::time_point end) {
+        double ts = std::chrono::duration<double, std::micro>(start - m_start).count();
+        if (ts > m_trace_seconds * 1000000.0)
+            return;
+        double dur = std::chrono::duration<double, std::micro>(end - start).count();
+        *m_trace << (m_first_event ? "\n" : ",\n");
+        *m_trace << "{\"name\":\"" << g_phase_names[p] << "\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" << ts << ",\"dur\":" << dur << "}";
+        m_first_event = false;
+    }
+
+    void profiler::collect_statistics(statistics & st) const {
+        for (unsigned i = 0; i < PROF_NUM_PHASES; ++i)
+            st.update(g_call_keys[i], m_calls[i]);
+        if (!m_enabled)
+            return;
+        for (unsigned i = 0; i < PROF_NUM_PHASES; ++i)
+            st.update(g_time_keys[i], m_seconds[i]);
+    }
+
+};
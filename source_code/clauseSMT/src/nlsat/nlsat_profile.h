@@ -0,0 +1,89 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_profile.h
+
+Abstract:
+
+    Call counters and scoped timers for the hot paths of the nlsat search.
+
+    Counters are always maintained. Timers are only read when profiling is
+    enabled (nlsat.profile), and the timed scopes of the first
+    nlsat.profile_trace_seconds of a run can be dumped in Chrome trace
+    format (chrome://tracing, Perfetto).
+
+Revision History:
+
+--*/
+#pragma once
+
+#include <chrono>
+#include <fstream>
+#include "util/statistics.h"
+#include "util/util.h"
+
+namespace nlsat {
+
+    enum profile_phase {
+        PROF_SELECT_VAR,
+        PROF_FIND_CLAUSES,
+        PROF_PROCESS_ARITH,
+        PROF_RESOLVE,
+        PROF_EXPLAIN,
+        PROF_INFEASIBLE,
+        PROF_ISOLATE_ROOTS,
+        PROF_PSC_CHAIN,
+        PROF_NUM_PHASES
+    };
+
+    class profiler {
+        typedef std::chrono::steady_clock clock;
+        bool                      m_enabled;
+        clock::time_point         m_start;
+        unsigned                  m_calls[PROF_NUM_PHASES];
+        double                    m_seconds[PROF_NUM_PHASES];
+        scoped_ptr<std::ofstream> m_trace;
+        double                    m_trace_seconds;
+        bool                      m_first_event;
+
+        void trace_event(profile_phase p, clock::time_point start, clock::time_point end);
+    public:
+        profiler();
+        ~profiler();
+
+        void set_enabled(bool f) { m_enabled = f; }
+        bool enabled() const { return m_enabled; }
+
+        /**
+           \brief Dump the scopes that start in the first \c seconds of the run to file_name.
+           An empty file name disables the dump.
+        */
+        void set_trace(std::string const & file_name, unsigned seconds);
+
+        void reset();
+        void collect_statistics(statistics & st) const;
+
+        class scope {
+            profiler &        m_profiler;
+            profile_phase     m_phase;
+            clock::time_point m_begin;
+        public:
+            scope(profiler & p, profile_phase ph): m_profiler(p), m_phase(ph) {
+                p.m_calls[ph]++;
+                if (p.m_enabled)
+                    m_begin = clock::now();
+            }
+            ~scope() {
+                if (!m_profiler.m_enabled)
+                    return;
+                clock::time_point end = clock::now();
+                m_profiler.m_seconds[m_phase] += std::chrono::duration<double>(end - m_begin).count();
+                if (m_profiler.m_trace)
+                    m_profiler.trace_event(m_phase, m_begin, end);
+            }
+        };
+    };
+
+};
@@ -0,0 +1,476 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_simplify.cpp
+
+Abstract:
+
+    Preprocessing of the nlsat clauses before the dynamic search.
+
+    Clauses are only created and deleted through the solver, the
+    Dynamic_manager rebuilds its clause and atom information (pure bool
+    conversion, hybrid watches) from the simplified clauses when the
+    search is initialized.
+
+Revision History:
+
+    Adapted from the z3 nlsat simplifier.
+
+--*/
+#include <algorithm>
+#include "nlsat/nlsat_simplify.h"
+#include "nlsat/nlsat_solver.h"
+
+namespace nlsat {
+
+    struct simplify::imp {
+
+        solver&                    s;
+        atom_vector&               m_atoms;
+        clause_vector&             m_clauses, m_learned;
+        pmanager&                  m_pm;
+        literal_vector             m_lemma;
+        vector<ptr_vector<clause>> m_var_occurs;
+        bool_vector                m_var_mark;
+        var_vector                 m_vars;
+
+        imp(solver& s, atom_vector& atoms, clause_vector& clauses, clause_vector& learned, pmanager& pm):
+            s(s),
+            m_atoms(atoms),
+            m_clauses(clauses),
+            m_learned(learned),
+            m_pm(pm) {}
+
+        void operator()(bool elim_vars) {
+            // learned clauses may mention eliminated variables.
+            // Without elimination they remain consequences of the simplified
+            // clauses, and the lemmas kept across checks in incremental mode survive.
+            if (elim_vars) {
+                for (auto c : m_learned)
+                    s.del_clause(c);
+                m_learned.reset();
+            }
+
+            TRACE("nlsat_simplify", s.display(tout << "before\n"););
+            unsigned sz = m_clauses.size();
+            while (true) {
+                subsumption_simplify();
+
+                if (elim_vars && !has_root_atom()) {
+                    while (elim_uncnstr())
+                        ;
+                    while (elim_eqs())
+                        ;
+                }
+
+                if (m_clauses.size() >= sz)
+                    break;
+                sz = m_clauses.size();
+            }
+            TRACE("nlsat_simplify", s.display(tout << "after\n"););
+        }
+
+        bool has_root_atom() const {
+            return std::any_of(m_clauses.begin(), m_clauses.end(), [&](clause* c) { return s.has_root_atom(*c); });
+        }
+
+        //
+        // Variable occurrences
+        //
+
+        void compute_occurs() {
+            m_var_occurs.reset();
+            for (auto c : m_clauses)
+                compute_occurs(*c);
+        }
+
+        void collect_vars(clause const& c) {
+            m_vars.reset();
+            for (auto lit : c) {
+                atom* a = m_atoms[lit.var()];
+                if (!a || !a->is_ineq_atom())
+                    continue;
+                ineq_atom const& ia = *to_ineq_atom(a);
+                for (unsigned i = 0; i < ia.size(); ++i) {
+                    var_vector curr;
+                    m_pm.vars(ia.p(i), curr);
+                    for (var v : curr) {
+                        if (m_var_mark.get(v, false))
+                            continue;
+                        m_var_mark.setx(v, true, false);
+                        m_vars.push_back(v);
+                    }
+                }
+            }
+            for (var v : m_vars)
+                m_var_mark[v] = false;
+        }
+
+        void compute_occurs(clause& c) {
+            collect_vars(c);
+            unsigned h = 0;
+            for (var v : m_vars) {
+                m_var_occurs.reserve(v + 1);
+                m_var_occurs[v].push_back(&c);
+                h |= (1u << (v % 32u));
+            }
+            c.set_var_hash(h);
+        }
+
+        bool cleanup_removed() {
+            unsigned j = 0, sz = m_clauses.size();
+            for (unsigned i = 0; i < sz; ++i) {
+                auto c = m_clauses[i];
+                if (c->is_removed())
+                    s.del_clause(c);
+                else
+                    m_clauses[j++] = c;
+            }
+            m_clauses.shrink(j);
+            return j < sz;
+        }
+
+        //
+        // Subsumption simplification
+        //
+        // Remove D if C subsumes D
+        //
+        // Unit subsumption resolution
+        // u is a unit literal (lit or C) is a clause
+        // u => ~lit, then simplify (lit or C) to C
+        //
+        // Only clauses without assumptions are used to simplify other
+        // clauses, clauses with assumptions are removed after a check.
+        //
+        void subsumption_simplify() {
+            compute_occurs();
+            for (unsigned v = m_var_occurs.size(); v-- > 0; ) {
+                auto& clauses = m_var_occurs[v];
+                unsigned sz = clauses.size();
+                for (unsigned i = 0; i < sz; ++i) {
+                    auto c = clauses[i];
+                    if (c->is_marked() || c->is_removed() || c->assumptions() != nullptr)
+                        continue;
+                    c->mark();
+                    for (unsigned j = 0; j < sz; ++j) {
+                        auto c2 = clauses[j];
+                        if (c == c2 || c2->is_removed())
+                            continue;
+                        if (subsumes(*c, *c2) || unit_subsumption_simplify(*c, *c2)) {
+                            TRACE("nlsat_simplify", s.display(tout << "subsumes ", *c);
+                                  s.display(tout << " ", *c2) << "\n";);
+                            s.inc_simplify();
+                            c2->set_removed();
+                        }
+                    }
+                }
+            }
+            for (auto c : m_clauses)
+                c->unmark();
+
+            cleanup_removed();
+        }
+
+        bool unit_subsumption_simplify(clause& src, clause& c) {
+            if (src.size() != 1)
+                return false;
+            auto u = src[0];
+            for (auto lit : c) {
+                if (subsumes(u, ~lit)) {
+                    literal_vector lits;
+                    for (auto lit2 : c)
+                        if (lit2 != lit)
+                            lits.push_back(lit2);
+                    if (lits.empty())
+                        return false;
+                    auto cls = s.mk_clause(lits.size(), lits.data(), false, c.assumptions());
+                    if (cls)
+                        compute_occurs(*cls);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // does c1 subsume c2?
+        bool subsumes(clause const& c1, clause const& c2) {
+            if (c1.size() > c2.size())
+                return false;
+            if ((c1.var_hash() & c2.var_hash()) != c1.var_hash())
+                return false;
+            for (auto lit1 : c1) {
+                if (!std::any_of(c2.begin(), c2.end(), [&](literal lit2) { return subsumes(lit1, lit2); }))
+                    return false;
+            }
+            return true;
+        }
+
+        // does lit1 imply lit2?
+        bool subsumes(literal lit1, literal lit2) {
+            if (lit1 == lit2)
+                return true;
+
+            atom* a1 = m_atoms[lit1.var()];
+            atom* a2 = m_atoms[lit2.var()];
+            if (!a1 || !a2 || !a1->is_ineq_atom() || !a2->is_ineq_atom())
+                return false;
+            poly* p1, * p2;
+            if (!is_single_poly(*to_ineq_atom(a1), p1) || !is_single_poly(*to_ineq_atom(a2), p2))
+                return false;
+
+            // use ge(p1, p2)
+            // whenever lit1 = p1 < 0,    lit2 = p2 < 0
+            // or       lit1 = p1 < 0,    lit2 = !(p2 > 0)
+            // or       lit1 = !(p1 > 0), lit2 = !(p2 > 0)
+            // use ge(p2, p1)
+            // whenever lit1 = p1 > 0,    lit2 = p2 > 0
+            // or       lit1 = !(p1 < 0), lit2 = !(p2 < 0)
+            // or       lit1 = p1 > 0,    lit2 = !(p2 < 0)
+            auto is_lt1 = !lit1.sign() && a1->get_kind() == atom::LT;
+            auto is_le1 =  lit1.sign() && a1->get_kind() == atom::GT;
+            auto is_gt1 = !lit1.sign() && a1->get_kind() == atom::GT;
+            auto is_ge1 =  lit1.sign() && a1->get_kind() == atom::LT;
+
+            auto is_lt2 = !lit2.sign() && a2->get_kind() == atom::LT;
+            auto is_le2 =  lit2.sign() && a2->get_kind() == atom::GT;
+            auto is_gt2 = !lit2.sign() && a2->get_kind() == atom::GT;
+            auto is_ge2 =  lit2.sign() && a2->get_kind() == atom::LT;
+
+            if ((is_lt1 && (is_lt2 || is_le2)) || (is_le1 && is_le2))
+                return ge(p1, p2);
+            if ((is_gt1 && (is_gt2 || is_ge2)) || (is_ge1 && is_ge2))
+                return ge(p2, p1);
+            return false;
+        }
+
+        /**
+           \brief Return true if p - q is a sum of squared monomials with positive coefficients,
+           that is, p >= q for every assignment.
+        */
+        bool ge(poly* p, poly* q) {
+            polynomial_ref d(m_pm);
+            d = m_pm.sub(p, q);
+            unsigned sz = m_pm.size(d);
+            for (unsigned i = 0; i < sz; ++i) {
+                if (!m_pm.m().is_pos(m_pm.coeff(d, i)))
+                    return false;
+                polynomial::monomial* m = m_pm.get_monomial(d, i);
+                for (unsigned j = 0; j < m_pm.size(m); ++j)
+                    if (m_pm.degree(m, j) % 2 == 1)
+                        return false;
+            }
+            return true;
+        }
+
+        //
+        // Elimination of variables that occur in a single clause containing
+        // a linear equality A*x + B = 0. The clause is satisfied by x = -B/A.
+        //
+        bool elim_uncnstr() {
+            compute_occurs();
+            bool has_removed = false;
+            for (unsigned v = m_var_occurs.size(); v-- > 0; ) {
+                auto& clauses = m_var_occurs[v];
+                if (clauses.size() != 1)
+                    continue;
+                auto& c = *clauses[0];
+                if (c.is_removed())
+                    continue;
+                if (!is_unconstrained(v, c))
+                    continue;
+                TRACE("nlsat_simplify", tout << "unconstrained x" << v << " in "; s.display(tout, c) << "\n";);
+                s.inc_simplify();
+                c.set_removed();
+                has_removed = true;
+            }
+            cleanup_removed();
+            return has_removed;
+        }
+
+        bool is_unconstrained(var x, clause& c) {
+            poly* p;
+            polynomial_ref A(m_pm), B(m_pm);
+            for (auto lit : c) {
+                atom* a = m_atoms[lit.var()];
+                if (!a || lit.sign() || !a->is_eq())
+                    continue;
+                if (!is_single_poly(*to_ineq_atom(a), p))
+                    continue;
+                if (!solve(x, p, A, B))
+                    continue;
+                add_patch(x, A, B);
+                return true;
+            }
+            return false;
+        }
+
+        //
+        // Elimination of variables defined by a unit equality A*x + B = 0,
+        // x is replaced by -B/A in all the other clauses.
+        //
+        bool elim_eqs() {
+            compute_occurs();
+            bool has_removed = false;
+            for (unsigned v = m_var_occurs.size(); v-- > 0; )
+                has_removed |= elim_eq(v, m_var_occurs[v]);
+            cleanup_removed();
+            return has_removed;
+        }
+
+        bool elim_eq(var x, ptr_vector<clause> const& clauses) {
+            polynomial_ref A(m_pm), B(m_pm);
+            poly* p;
+            for (auto c : clauses) {
+                if (c->is_removed() || c->size() != 1 || c->assumptions() != nullptr)
+                    continue;
+                literal lit = (*c)[0];
+                atom* a = m_atoms[lit.var()];
+                if (!a || lit.sign() || !a->is_eq())
+                    continue;
+                if (!is_single_poly(*to_ineq_atom(a), p))
+                    continue;
+                if (!solve(x, p, A, B))
+                    continue;
+                apply_eq(x, clauses, c, A, B);
+                return true;
+            }
+            return false;
+        }
+
+        void apply_eq(var x, ptr_vector<clause> const& clauses, clause* def, polynomial_ref& A, polynomial_ref& B) {
+            TRACE("nlsat_simplify", tout << "eliminate x" << x << " using "; s.display(tout, *def) << "\n";);
+            // compute_occurs may extend m_var_occurs
+            ptr_vector<clause> occs(clauses);
+            for (auto c : occs) {
+                if (c->is_removed())
+                    continue;
+                c->set_removed();
+                if (c == def)
+                    continue;
+                m_lemma.reset();
+                bool is_tautology = false;
+                for (literal lit : *c) {
+                    lit = substitute_var(x, A, B, lit);
+                    if (lit == true_literal)
+                        is_tautology = true;
+                    else if (lit != false_literal)
+                        m_lemma.push_back(lit);
+                }
+                if (is_tautology)
+                    continue;
+                if (m_lemma.empty())
+                    m_lemma.push_back(false_literal);
+                auto cls = s.mk_clause(m_lemma.size(), m_lemma.data(), false, c->assumptions());
+                TRACE("nlsat_simplify", s.display(tout, *c) << " -> "; if (cls) s.display(tout, *cls); tout << "\n";);
+                if (cls)
+                    compute_occurs(*cls);
+            }
+            add_patch(x, A, B);
+            s.inc_simplify();
+        }
+
+        /**
+           \brief Return true if p is A*x + B with a constant A that can be inverted for x.
+           A is made positive.
+        */
+        bool solve(var x, poly* p, polynomial_ref& A, polynomial_ref& B) {
+            if (1 != m_pm.degree(p, x))
+                return false;
+            A = m_pm.coeff(p, x, 1, B);
+            if (!m_pm.is_const(A))
+                return false;
+            if (s.is_int(x)) {
+                // x = -B/A must stay integral
+                if (!is_unit(A))
+                    return false;
+                var_vector vs;
+                m_pm.vars(B, vs);
+                if (std::any_of(vs.begin(), vs.end(), [&](var y) { return !s.is_int(y); }))
+                    return false;
+            }
+            if (m_pm.m().is_neg(m_pm.coeff(A, 0))) {
+                A = neg(A);
+                B = neg(B);
+            }
+            return true;
+        }
+
+        // the models of the simplified clauses are extended with x = -B/A
+        void add_patch(var x, polynomial_ref const& A, polynomial_ref const& B) {
+            polynomial_ref q(m_pm);
+            q = neg(B);
+            s.add_patch(x, A, q);
+        }
+
+        literal substitute_var(var x, poly* A, poly* B, literal lit) {
+            atom* a = m_atoms[lit.var()];
+            if (!a)
+                return lit;
+            SASSERT(a->is_ineq_atom());
+            literal r = substitute_var(x, A, B, *to_ineq_atom(a));
+            if (r == null_literal)
+                return lit;
+            return lit.sign() ? ~r : r;
+        }
+
+        literal substitute_var(var x, poly* A, poly* B, ineq_atom const& a) {
+            unsigned sz = a.size();
+            bool_vector even;
+            polynomial_ref pr(m_pm), qq(m_pm);
+            qq = neg(polynomial_ref(B, m_pm));
+            polynomial_ref_vector ps(m_pm);
+            bool change = false;
+            auto k = a.get_kind();
+            for (unsigned i = 0; i < sz; ++i) {
+                poly* po = a.p(i);
+                // po[x -> -B/A] * A^deg(po, x), A > 0
+                m_pm.substitute(po, x, qq, A, pr);
+                change |= pr != po;
+                if (m_pm.is_zero(pr)) {
+                    ps.reset();
+                    even.reset();
+                    ps.push_back(pr);
+                    even.push_back(false);
+                    break;
+                }
+                if (m_pm.is_const(pr)) {
+                    if (!a.is_even(i) && m_pm.m().is_neg(m_pm.coeff(pr, 0)))
+                        k = atom::flip(k);
+                    continue;
+                }
+                ps.push_back(pr);
+                even.push_back(a.is_even(i));
+            }
+            if (!change)
+                return null_literal;
+            return s.mk_ineq_literal(k, ps.size(), ps.data(), even.data());
+        }
+
+        bool is_single_poly(ineq_atom const& a, poly*& p) {
+            unsigned sz = a.size();
+            return sz == 1 && a.is_odd(0) && (p = a.p(0), true);
+        }
+
+        bool is_unit(polynomial_ref const& p) {
+            if (!m_pm.is_const(p))
+                return false;
+            auto const& c = m_pm.coeff(p, 0);
+            return m_pm.m().is_one(c) || m_pm.m().is_minus_one(c);
+        }
+    };
+
+    simplify::simplify(solver& s, atom_vector& atoms, clause_vector& clauses, clause_vector& learned, pmanager& pm) {
+        m_imp = alloc(imp, s, atoms, clauses, learned, pm);
+    }
+
+    simplify::~simplify() {
+        dealloc(m_imp);
+    }
+
+    void simplify::operator()(bool elim_vars) {
+        (*m_imp)(elim_vars);
+    }
+
+};
@@ -0,0 +1,40 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_simplify.h
+
+Abstract:
+
+    Preprocessing of the nlsat clauses before the dynamic search:
+    subsumption, unit subsumption resolution, and elimination of
+    variables defined by linear or unconstrained equalities.
+
+Revision History:
+
+    Adapted from the z3 nlsat simplifier.
+
+--*/
+#pragma once
+
+#include "nlsat/nlsat_types.h"
+#include "nlsat/nlsat_clause.h"
+
+namespace nlsat {
+    class simplify {
+        struct imp;
+        imp * m_imp;
+    public:
+        simplify(solver& s, atom_vector& atoms, clause_vector& clauses, clause_vector& learned, pmanager & pm);
+        ~simplify();
+
+        /**
+           \brief Simplify the clauses.
+           Variables are only eliminated if elim_vars is true, the eliminated
+           variables are patched in the models of the solver. Learned clauses
+           are removed when variables are eliminated, and kept otherwise.
+        */
+        void operator()(bool elim_vars);
+    };
+}
@@ -57,12 +57,18 @@ Revision History:
  * ---------------------------------------------------------------------------------------------------------------
  **/
 
+#include <fstream>
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 #include "util/z3_exception.h"
 #include "util/chashtable.h"
 #include "util/id_gen.h"
 #include "util/map.h"
 #include "util/dependency.h"
 #include "util/permutation.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/stopwatch.h"
 #include "math/polynomial/algebraic_numbers.h"
 #include "math/polynomial/polynomial_cache.h"
 #include "nlsat/nlsat_solver.h"
@@ -71,12 +77,17 @@ Revision History:
 #include "nlsat/nlsat_justification.h"
 #include "nlsat/nlsat_evaluator.h"
 #include "nlsat/nlsat_explain.h"
+#include "nlsat/nlsat_trace.h"
+#include "nlsat/nlsat_profile.h"
 #include "nlsat/nlsat_params.hpp"
 
 // wzh dynamic
 #include "nlsat/nlsat_dynamic.h"
 // hzw dynamic
 #include "nlsat/nlsat_switch.h"
+#include "nlsat/nlsat_simplify.h"
+#include "nlsat/nlsat_icp.h"
+#include "nlsat/nlsat_local_search.h"
 
 
 #define NLSAT_EXTRA_VERBOSE
@@ -140,6 +151,7 @@ namespace nlsat {
         anum_manager&           m_am;
         mutable assumption_manager     m_asm;
         assignment             m_assignment; // partial interpretation
+        profiler               m_profiler;
         evaluator              m_evaluator;
         interval_set_manager & m_ism;
         ineq_atom_table        m_ineq_atoms;
@@ -214,6 +226,11 @@ namespace nlsat {
         perm_display_var_proc  m_display_var;
 
         display_assumption_proc const* m_display_assumption;
+        linear_relaxation *    m_linear_relaxation;
+        unsigned               m_relax_trail_size;   // trail size at the last check of the relaxation
+        unsigned               m_relax_conflicts;    // conflicts at the last check of the relaxation
+        unsigned               m_relax_num_clauses;  // clauses at the last check of the unit clauses
+        literal_vector         m_relax_lits, m_relax_core;
         struct display_literal_assumption : public display_assumption_proc {
             imp& i;
             literal_vector const& lits;
@@ -242,6 +259,13 @@ namespace nlsat {
 
         explain                m_explain;
         Dynamic_manager        m_dm;
+        nlsat::simplify        m_simplify;
+        icp                    m_icp;
+        scoped_ptr<local_search> m_local_search;
+        vector<rational>       m_ls_values;          // best assignment of the local search, used as a phase
+        svector<lbool>         m_ls_bvalues;
+        bool                   m_ls_has_hint;
+        bool                   m_ls_installed;       // the model of the local search was installed
 
         bool_var               m_bk;       // current Boolean variable we are processing
         var                    m_xk;       // current arith variable we are processing
@@ -283,7 +307,7 @@ namespace nlsat {
             trail(var x, arith_assignment): m_kind(ARITH_ASSIGNMENT), m_x(x) {}
 
             // update infeasible set
-            trail(interval_set * old_set):m_kind(INFEASIBLE_UPDT), m_old_set(old_set) {}
+            trail(interval_set * old_set, var x):m_kind(INFEASIBLE_UPDT), m_x(x), m_old_set(old_set) {}
 
             // update equation
             trail(atom * a):m_kind(UPDT_EQ), m_old_eq(a) {}
@@ -297,6 +321,9 @@ namespace nlsat {
 
         // configuration
         unsigned long long     m_max_memory;
+        unsigned long long     m_soft_max_memory;
+        unsigned long long     m_soft_limit;         // current soft limit, raised when a reduction does not get below m_soft_max_memory
+        bool                   m_memory_pressure;    // the soft limit was reached, reduce at the next restart
         unsigned               m_lazy;  // how lazy the solver is: 0 - satisfy all learned clauses, 1 - process only unit and empty learned clauses, 2 - use only conflict clauses for resolving conflicts
         bool                   m_simplify_cores;
         bool                   m_reorder;
@@ -304,12 +331,27 @@ namespace nlsat {
         bool                   m_random_order;
         unsigned               m_random_seed;
         bool                   m_inline_vars;
+        bool                   m_preprocess;
+        bool                   m_propagate_bounds;
+        bool                   m_use_local_search;
         bool                   m_log_lemmas;
         bool                   m_check_lemmas;
+        bool                   m_assumption_lemmas;
+        bool                   m_family_clauses;
+        unsigned               m_num_families;
+        svector<std::pair<bool_var, bool_var>> m_family_pairs; // family members not yet related by a binary clause
+        bool                   m_simplest_witness;
+        bool                   m_lookahead;
+        unsigned               m_lookahead_max_cells;
+        symbol                 m_trace_file;
+        symbol                 m_profile_trace_file;
+        scoped_ptr<std::ofstream> m_trace_out;
+        scoped_ptr<trace_writer>  m_trace;
         unsigned               m_max_conflicts;
         unsigned               m_lemma_count;
         unsigned               m_curr_stage;
         unsigned               m_switch_cnt;
+        var_vector             m_lbd_stages;   // scratch space of lemma_stage_lbd
 
         // statistics
         unsigned               m_conflicts;
@@ -317,11 +359,27 @@ namespace nlsat {
         unsigned               m_decisions;
         unsigned               m_stages;
         unsigned               m_irrational_assignments; // number of irrational witnesses
+        unsigned               m_witness_bits;           // total bit-size of rational witnesses
+        unsigned               m_witness_max_bits;
+        unsigned               m_lookahead_calls;
+        unsigned               m_lookahead_switches;     // look-ahead picked another cell than the default witness
+        unsigned               m_simplifications;
+        unsigned               m_icp_bounds;         // unit clauses derived by interval propagation
+        unsigned               m_linear_conflicts;   // conflicts closed by the linear relaxation
+        unsigned               m_local_search_models;
+        unsigned               m_local_search_hints;
+        unsigned               m_memory_reductions;
         // wzh restart
         unsigned               m_restarts;
+        unsigned               m_blocked_restarts;
         unsigned               m_learned_added;
         unsigned               m_learned_deleted;
         // hzw restart
+        unsigned               m_assumption_lemmas_kept;
+        unsigned               m_atoms_normalized;   // atoms whose factors had a non-unit content
+        unsigned               m_atoms_merged;       // normalized atoms that already existed
+        unsigned               m_atoms_grouped;      // atoms that joined the family of another atom
+        unsigned               m_family_clauses_added;
 
         unsigned               m_total_vars;
         unsigned               m_bool_vars;
@@ -344,15 +402,23 @@ namespace nlsat {
             m_am(c.m_am),
             m_asm(*this, m_allocator),
             m_assignment(m_am),
-            m_evaluator(s, m_assignment, m_pm, m_allocator), 
+            m_evaluator(s, m_assignment, m_pm, m_allocator, m_profiler), 
             m_ism(m_evaluator.ism()),
             m_patch_num(m_pm),
             m_patch_denom(m_pm),
             m_num_bool_vars(0),
             m_display_var(m_perm),
             m_display_assumption(nullptr),
-            m_dm(m_nlsat_clauses, m_nlsat_atoms, m_am, m_pm, m_assignment, m_evaluator, m_ism, m_bvalues, m_pure_bool_vars, m_pure_bool_convert, s, m_clauses, m_learned, m_atoms, m_restarts, m_learned_deleted, m_random_seed),
-            m_explain(s, m_assignment, m_cache, m_atoms, m_var2eq, m_evaluator, m_dm),
+            m_linear_relaxation(nullptr),
+            m_relax_trail_size(0),
+            m_relax_conflicts(0),
+            m_relax_num_clauses(0),
+            m_dm(m_nlsat_clauses, m_nlsat_atoms, m_am, m_pm, m_assignment, m_evaluator, m_ism, m_bvalues, m_pure_bool_vars, m_pure_bool_convert, s, m_clauses, m_learned, m_atoms, m_restarts, m_blocked_restarts, m_learned_deleted, m_random_seed),
+            m_explain(s, m_assignment, m_cache, m_atoms, m_var2eq, m_evaluator, m_dm, m_profiler),
+            m_simplify(s, m_atoms, m_clauses, m_learned, m_pm),
+            m_icp(s, m_rlimit, m_pm, m_atoms, m_clauses),
+            m_ls_has_hint(false),
+            m_ls_installed(false),
             m_scope_lvl(0),
             m_lemma(s),
             m_lazy_clause(s),
@@ -362,6 +428,7 @@ namespace nlsat {
             reset_statistics();
             mk_true_bvar();
             m_lemma_count = 0;
+            m_num_families = 0;
         }
         
         ~imp() {
@@ -377,7 +444,13 @@ namespace nlsat {
 
         void updt_params(params_ref const & _p) {
             nlsat_params p(_p);
-            m_max_memory     = p.max_memory();
+            m_max_memory     = megabytes_to_bytes(p.max_memory());
+            if (p.soft_max_memory() != 0)
+                m_soft_max_memory = std::min(m_max_memory, static_cast<unsigned long long>(megabytes_to_bytes(p.soft_max_memory())));
+            else
+                m_soft_max_memory = m_max_memory == SIZE_MAX ? m_max_memory : m_max_memory / 10 * 9;
+            m_soft_limit     = m_soft_max_memory;
+            m_memory_pressure = false;
             m_lazy           = p.lazy();
             m_simplify_cores = p.simplify_conflicts();
             bool min_cores   = p.minimize_conflicts();
@@ -387,13 +460,77 @@ namespace nlsat {
             m_random_order   = p.shuffle_vars();
             m_random_seed    = p.seed();
             m_inline_vars    = p.inline_vars();
+            m_preprocess     = p.simplify();
+            m_propagate_bounds = p.icp();
+            m_use_local_search = p.local_search();
+            m_icp.set_max_rounds(p.icp_max_rounds());
             m_log_lemmas     = p.log_lemmas();
             m_check_lemmas   = p.check_lemmas();
+            m_assumption_lemmas = p.assumption_lemmas();
+            m_family_clauses = p.family_clauses();
+            updt_trace_file(p.trace_file());
+            m_profiler.set_enabled(p.profile() || !p.profile_trace_file().str().empty());
+            if (p.profile_trace_file() != m_profile_trace_file) {
+                m_profile_trace_file = p.profile_trace_file();
+                m_profiler.set_trace(m_profile_trace_file.str(), p.profile_trace_seconds());
+            }
             m_ism.set_seed(m_random_seed);
             m_explain.set_simplify_cores(m_simplify_cores);
             m_explain.set_minimize_cores(min_cores);
             m_explain.set_factor(p.factor());
             m_am.updt_params(p.p);
+            updt_restart(p);
+            updt_witness(p);
+            m_lookahead           = p.lookahead();
+            m_lookahead_max_cells = p.lookahead_max_cells();
+            if (m_lookahead_max_cells < 2)
+                throw solver_exception("invalid lookahead.max_cells, at least 2 cells are needed to choose between them");
+        }
+
+        void updt_witness(nlsat_params const & p) {
+            symbol s = p.witness();
+            if (s == "dyadic")
+                m_simplest_witness = false;
+            else if (s == "simplest")
+                m_simplest_witness = true;
+            else
+                throw solver_exception("invalid witness selection, expected dyadic or simplest");
+        }
+
+        void updt_restart(nlsat_params const & p) {
+            symbol s = p.restart();
+            restart_strategy r;
+            if (s == "geometric")
+                r = RESTART_GEOMETRIC;
+            else if (s == "luby")
+                r = RESTART_LUBY;
+            else if (s == "ema")
+                r = RESTART_EMA;
+            else
+                throw solver_exception("invalid restart strategy, expected geometric, luby or ema");
+            m_dm.set_restart_strategy(r, p.restart_margin(), p.restart_blocking(), p.restart_emafastglue(), p.restart_emaslowglue());
+        }
+
+        void updt_trace_file(symbol const & file_name) {
+            if (file_name == m_trace_file)
+                return;
+            m_trace = nullptr;
+            m_trace_out = nullptr;
+            m_trace_file = file_name;
+            if (file_name.is_null() || file_name.str().empty())
+                return;
+            m_trace_out = alloc(std::ofstream, file_name.str(), std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!*m_trace_out)
+                throw solver_exception("could not open nlsat trace file");
+        }
+
+        /**
+           \brief Start the trace opened by updt_trace_file. The writer takes the managers
+           from m_solver, which are not reachable while the solver is constructed.
+        */
+        void open_trace() {
+            if (m_trace_out && !m_trace)
+                m_trace = alloc(trace_writer, m_solver, *m_trace_out);
         }
 
         void reset() {
@@ -402,6 +539,7 @@ namespace nlsat {
             m_lazy_clause.reset();
             undo_until_size(0);
             del_clauses();
+            m_family_pairs.reset();
             del_unref_atoms();
             m_cache.reset();
             m_assignment.reset();
@@ -413,6 +551,7 @@ namespace nlsat {
             m_lazy_clause.reset();
             undo_until_size(0);
             del_clauses();
+            m_family_pairs.reset();
             del_unref_atoms();
         }
 
@@ -421,7 +560,34 @@ namespace nlsat {
                 TRACE("wzh", std::cout << "[checkpoint] throw limit cancel message" << std::endl;);
                 throw solver_exception(m_rlimit.get_cancel_msg()); 
             }
-            if (memory::get_allocation_size() > m_max_memory) throw solver_exception(Z3_MAX_MEMORY_MSG);
+            unsigned long long mem = memory::get_allocation_size();
+            if (mem > m_soft_limit)
+                m_memory_pressure = true;
+            if (mem > m_max_memory) throw solver_exception(Z3_MAX_MEMORY_MSG);
+        }
+
+        /**
+           \brief Called at a restart when the soft memory limit was reached:
+           keep only the binary lemmas and flush the psc and factor caches.
+           If the memory is still above the soft limit, the limit is raised halfway
+           to max_memory so that the search is not restarted at every conflict.
+        */
+        void reduce_memory() {
+            m_memory_pressure = false;
+            m_memory_reductions++;
+            unsigned num_deleted = m_dm.reduce_learned();
+            m_cache.flush();
+            unsigned long long mem = memory::get_allocation_size();
+            if (mem > m_soft_max_memory && mem < m_max_memory)
+                m_soft_limit = mem + (m_max_memory - mem) / 2;
+            else
+                m_soft_limit = m_soft_max_memory;
+            IF_VERBOSE(2, 
+                       unsigned longest = 0;
+                       for (clause* c : m_learned) longest = std::max(longest, c->size());
+                       verbose_stream() << "(nlsat-reduce-memory :deleted " << num_deleted 
+                       << " :kept " << m_learned.size() << " :longest-kept " << longest
+                       << " :memory-mb " << mem / (1024 * 1024) << ")\n";);
         }
 
         // -----------------------
@@ -433,6 +599,10 @@ namespace nlsat {
         unsigned num_bool_vars() const {
             return m_num_bool_vars;
         }
+
+        unsigned num_learned_clauses() const {
+            return m_learned.size();
+        }
         
         unsigned num_vars() const {
             return m_is_int.size();
@@ -626,7 +796,9 @@ namespace nlsat {
             SASSERT(sz >= 1);
             SASSERT(k == atom::LT || k == atom::GT || k == atom::EQ);
             int sign = 1;
+            bool normalized = false;
             polynomial_ref p(m_pm);
+            polynomial::manager::scoped_numeral c(m_pm.m());
             ptr_buffer<poly> uniq_ps;
             // var max = null_var;
             for (unsigned i = 0; i < sz; i++) {
@@ -634,6 +806,12 @@ namespace nlsat {
                 if (p.get() != ps[i] && !is_even[i]) {
                     sign = -sign;
                 }
+                // dividing by the positive integer content does not change the sign of the factor
+                m_pm.int_content(p, c);
+                if (m_pm.m().is_pos(c) && !m_pm.m().is_one(c)) {
+                    p = m_pm.exact_div(p, c);
+                    normalized = true;
+                }
                 // var curr_max = max_var(p.get());
                 // if (curr_max > max || max == null_var)
                     // max = curr_max;
@@ -651,6 +829,11 @@ namespace nlsat {
             // CTRACE("nlsat_table_bug", atom->max_var() != max, display(std::cout << "nonmax: ", *atom, m_display_var) << "\n";);
             // SASSERT(atom->max_var() == max);
             is_new = (atom == tmp_atom);
+            if (normalized) {
+                m_atoms_normalized++;
+                if (!is_new)
+                    m_atoms_merged++;
+            }
             if (is_new) {
                 for (unsigned i = 0; i < sz; i++) {
                     m_pm.inc_ref(atom->p(i));
@@ -674,10 +857,53 @@ namespace nlsat {
                 atom->m_bool_var = b;
                 TRACE("nlsat_verbose", display(std::cout << "create: b" << atom->m_bool_var << " ", *atom) << "\n";);
                 m_dm.register_atom(atom);
+                init_family(atom);
                 return b;
             }
         }
 
+        /**
+           \brief Put a in the family of the atoms with the same factors and another kind.
+           At most one of p<0, p=0, p>0 is true, the members are related by binary
+           clauses at the next check (see nlsat.family_clauses).
+        */
+        void init_family(ineq_atom * a) {
+            atom::kind k = a->m_kind;
+            for (atom::kind k2 : { atom::EQ, atom::LT, atom::GT }) {
+                if (k2 == k)
+                    continue;
+                // a is already in the table, it is only found again on a hash collision
+                a->m_kind = k2;
+                ineq_atom * s = nullptr;
+                bool found = m_ineq_atoms.find(a, s) && s != a;
+                a->m_kind = k;
+                if (!found)
+                    continue;
+                if (a->m_family == UINT_MAX) {
+                    a->m_family = s->m_family;
+                    m_atoms_grouped++;
+                }
+                if (m_family_clauses) {
+                    inc_ref(a->bvar());
+                    inc_ref(s->bvar());
+                    m_family_pairs.push_back(std::make_pair(a->bvar(), s->bvar()));
+                }
+            }
+            if (a->m_family == UINT_MAX)
+                a->m_family = m_num_families++;
+        }
+
+        void add_family_clauses() {
+            for (auto const& p : m_family_pairs) {
+                literal lits[2] = { literal(p.first, true), literal(p.second, true) };
+                mk_clause(2, lits, false, nullptr);
+                dec_ref(p.first);
+                dec_ref(p.second);
+                m_family_clauses_added++;
+            }
+            m_family_pairs.reset();
+        }
+
         literal mk_ineq_literal(atom::kind k, unsigned sz, poly * const * ps, bool const * is_even) {
             SASSERT(k == atom::LT || k == atom::GT || k == atom::EQ);
             bool is_const = true;
@@ -863,6 +1089,9 @@ namespace nlsat {
             checker.m_check_lemmas = false;
             checker.m_log_lemmas = false;
             checker.m_inline_vars = false;
+            checker.m_preprocess = false;
+            checker.m_propagate_bounds = false;
+            checker.m_use_local_search = false;
 
             // need to translate Boolean variables and literals
             scoped_bool_vars tr(checker);
@@ -1017,8 +1246,8 @@ namespace nlsat {
             m_trail.push_back(trail(b, bvar_assignment()));
         }
 
-        void save_set_updt_trail(interval_set * old_set) {
-            m_trail.push_back(trail(old_set));
+        void save_set_updt_trail(interval_set * old_set, var x) {
+            m_trail.push_back(trail(old_set, x));
         }
 
         void save_clause_updt_trail(interval_set * old_set, var x) {
@@ -1119,11 +1348,11 @@ namespace nlsat {
         
         }
 
-        void undo_set_updt(interval_set * old_set) {
+        // x is recorded in the trail: m_xk is no longer the updated variable
+        // when the trail of a finished search is undone by the next check
+        void undo_set_updt(interval_set * old_set, var x) {
             DTRACE(std::cout << "undo set update\n";);
-            DTRACE(std::cout << "m_xk: " << m_xk << std::endl;);
-            if (m_xk == null_var) return;
-            var x = m_xk;
+            DTRACE(std::cout << "x: " << x << std::endl;);
             if (x < m_infeasible.size()) {
                 if(m_infeasible[x] != nullptr){
                     m_ism.dec_ref(m_infeasible[x]);
@@ -1193,7 +1422,7 @@ namespace nlsat {
                     undo_bvar_assignment(t.m_b);
                     break;
                 case trail::INFEASIBLE_UPDT:
-                    undo_set_updt(t.m_old_set);
+                    undo_set_updt(t.m_old_set, t.m_x);
                     break;
                 case trail::NEW_STAGE:
                     undo_new_stage(t.m_x);
@@ -1454,23 +1683,10 @@ namespace nlsat {
             updt_clause_infeasible(curr_st, x);
         }
 
-        interval_set * get_atom_infeasible_set(bool_var b, clause const &cls, var x) {
-            // m_assignment.display(std::cout);
-            // std::cout << std::endl;
-            SASSERT(m_atoms[b] != nullptr);
-            interval_set_ref curr_st(m_ism);
-            curr_st = m_evaluator.infeasible_intervals(m_atoms[b], false, &cls, x);
-            DTRACE(
-                display_atom(std::cout, b); std::cout << std::endl;
-                m_ism.display(std::cout, curr_st); std::cout << std::endl;
-            );
-            m_ism.inc_ref(curr_st);
-            return curr_st;
-        }
-
         interval_set* get_clause_infset(clause const &c, var x) {
             interval_set_ref res_st(m_ism);
             res_st = m_ism.mk_full();
+            m_evaluator.start_clause(x);
             for(literal l: c) {
                 if(value(l) == l_true) {
                     return nullptr;
@@ -1478,12 +1694,8 @@ namespace nlsat {
                 if(value(l) == l_false) {
                     continue;
                 }
-                atom * a   = m_atoms[l.var()];
                 interval_set_ref curr_st(m_ism);
-                curr_st = get_atom_infeasible_set(l.var(), c, x);
-                if(l.sign()) {
-                    curr_st = m_ism.mk_complement(curr_st);
-                }
+                curr_st = m_evaluator.clause_infeasible_intervals(m_atoms[l.var()], l.sign(), &c);
                 res_st = m_ism.mk_intersection(res_st, curr_st);
                 if(m_ism.is_empty(res_st)) {
                     return res_st;
@@ -1499,7 +1711,7 @@ namespace nlsat {
         void updt_infeasible(interval_set const * s) {
             SASSERT(m_xk != null_var);
             interval_set * xk_set = m_infeasible[m_xk];
-            save_set_updt_trail(xk_set);
+            save_set_updt_trail(xk_set, m_xk);
             interval_set_ref new_set(m_ism);
             TRACE("nlsat_inf_set", std::cout << "updating infeasible set\n"; m_ism.display(std::cout, xk_set) << "\n"; m_ism.display(std::cout, s) << "\n";);
             new_set = m_ism.mk_union(s, xk_set);
@@ -1594,6 +1806,7 @@ namespace nlsat {
 
         // m_bk: atom index
         void select_next_hybrid_var(){
+            profiler::scope _ps(m_profiler, PROF_SELECT_VAR);
             DTRACE(std::cout << "start of select next hybrid var\n";);
             // we have finish search
             if(m_dm.finish_status()){
@@ -1670,18 +1883,132 @@ namespace nlsat {
             scoped_anum w(m_am);
             SASSERT(!m_ism.is_full(m_infeasible[m_xk]));
             // m_ism.peek_in_complement(m_infeasible[m_xk], m_is_int[m_xk], w, m_randomize);
-            m_ism.peek_in_complement(m_infeasible[m_xk], m_is_int[m_xk], w, false);
+            if (!peek_hint(w)) {
+                if (m_simplest_witness)
+                    m_ism.peek_simplest_in_complement(m_infeasible[m_xk], m_is_int[m_xk], w);
+                else
+                    m_ism.peek_in_complement(m_infeasible[m_xk], m_is_int[m_xk], w, false);
+                if (m_lookahead)
+                    lookahead_witness(w);
+            }
             TRACE("nlsat", 
                   std::cout << "infeasible intervals: "; m_ism.display(std::cout, m_infeasible[m_xk]); std::cout << "\n";
                   std::cout << "assigning "; m_display_var(std::cout, m_xk) << "(x" << m_xk << ") -> " << w << "\n";);
             TRACE("nlsat_root", std::cout << "value as root object: "; m_am.display_root(std::cout, w); std::cout << "\n";);
             if (!m_am.is_rational(w))
                 m_irrational_assignments++;
+            else
+                update_witness_bits(w);
             m_assignment.set_core(m_xk, w);
             m_dm.do_watched_clauses(m_xk, false);
             save_arith_var_assignment_trail(m_xk);
         }
 
+        /**
+           \brief Use the value of m_xk in the best assignment of the local search
+           if it is feasible.
+        */
+        bool peek_hint(scoped_anum & w) {
+            if (!m_ls_has_hint || m_xk >= m_ls_values.size())
+                return false;
+            scoped_anum h(m_am);
+            m_am.set(h, m_ls_values[m_xk].to_mpq());
+            if (m_ism.contains(m_infeasible[m_xk], h))
+                return false;
+            m_am.set(w, h);
+            m_local_search_hints++;
+            return true;
+        }
+
+        // look-ahead scratch space
+        unsigned_vector             m_la_clauses;
+        var_vector                  m_la_vars;
+        var_vector                  m_la_ys;
+
+        /**
+           \brief Score of the tentative assignment of m_xk: the number of arith vars it blocks
+           (their clause infeasible set becomes full) and the number of clauses it makes infeasible
+           in their last unassigned arith var. Lower is better.
+        */
+        std::pair<unsigned, unsigned> lookahead_score() {
+            unsigned num_blocked = 0, num_infeasible = 0;
+            ptr_vector<interval_set> acc; // clause infeasible set of each var of m_la_ys
+            m_la_ys.reset();
+            for (unsigned i = 0; i < m_la_clauses.size(); i++) {
+                var y = m_la_vars[i];
+                unsigned j = 0;
+                for (; j < m_la_ys.size() && m_la_ys[j] != y; j++);
+                if (j == m_la_ys.size()) {
+                    m_la_ys.push_back(y);
+                    acc.push_back(m_clause_infeasible[y]);
+                    m_ism.inc_ref(acc[j]);
+                }
+                if (m_ism.is_full(acc[j]))
+                    continue;
+                interval_set * s = get_clause_infset(*m_clauses[m_la_clauses[i]], y);
+                if (s == nullptr)
+                    continue;
+                interval_set_ref s_ref(m_ism);
+                s_ref = s;
+                m_ism.dec_ref(s);
+                if (m_ism.is_full(s))
+                    num_infeasible++;
+                interval_set * u = m_ism.mk_union(s, acc[j]);
+                m_ism.inc_ref(u);
+                m_ism.dec_ref(acc[j]);
+                acc[j] = u;
+                if (m_ism.is_full(u))
+                    num_blocked++;
+            }
+            for (interval_set * u : acc)
+                m_ism.dec_ref(u);
+            return std::make_pair(num_blocked, num_infeasible);
+        }
+
+        /**
+           \brief Replace the witness w of m_xk by the sample of the feasible cell that blocks the
+           fewest clauses watched by the unassigned arith vars. w is kept on ties.
+        */
+        void lookahead_witness(scoped_anum & w) {
+            m_assignment.set(m_xk, w);
+            m_dm.collect_unit_clauses_after(m_xk, m_la_clauses, m_la_vars);
+            if (m_la_clauses.empty()) {
+                m_assignment.reset(m_xk);
+                return;
+            }
+            m_lookahead_calls++;
+            std::pair<unsigned, unsigned> best = lookahead_score();
+            scoped_anum_vector cells(m_am);
+            if (best.first + best.second > 0)
+                m_ism.peek_cell_witnesses(m_infeasible[m_xk], m_is_int[m_xk], m_lookahead_max_cells, cells);
+            unsigned best_i = UINT_MAX;
+            for (unsigned i = 0; i < cells.size() && best.first + best.second > 0; i++) {
+                if (m_am.eq(cells[i], w))
+                    continue;
+                m_assignment.set(m_xk, cells[i]);
+                std::pair<unsigned, unsigned> score = lookahead_score();
+                if (score < best) {
+                    best = score;
+                    best_i = i;
+                }
+            }
+            m_assignment.reset(m_xk);
+            TRACE("wzh", std::cout << "[lookahead] x" << m_xk << " " << cells.size() << " cells, best score (" << best.first << ", " << best.second << ")\n";);
+            if (best_i != UINT_MAX) {
+                m_lookahead_switches++;
+                m_am.set(w, cells[best_i]);
+            }
+        }
+
+        void update_witness_bits(anum const & w) {
+            scoped_mpq q(m_qm);
+            m_am.to_rational(w, q);
+            unsigned bits = m_qm.bitsize(q.get().numerator()) + m_qm.bitsize(q.get().denominator());
+            m_witness_bits += bits;
+            if (bits > m_witness_max_bits)
+                m_witness_max_bits = bits;
+        }
+
         void check_dynamic_satisfied() {
             for(unsigned i = 0; i < m_clauses.size(); i++){
                 if(!is_clause_sat(m_clauses[i])){
@@ -1842,6 +2169,7 @@ namespace nlsat {
         }
 
         bool process_hybrid_clause_arith(clause const & cls, bool satisfy_learned){
+            profiler::scope _ps(m_profiler, PROF_PROCESS_ARITH);
             if (!satisfy_learned && m_lazy >= 2 && cls.is_learned()) {
                 TRACE("nlsat", std::cout << "skip learned\n";);
                 return true; // ignore lemmas in super lazy mode
@@ -1858,6 +2186,7 @@ namespace nlsat {
 
             interval_set * xk_set = m_infeasible[m_xk];
             SASSERT(!m_ism.is_full(xk_set));
+            m_evaluator.start_clause(m_xk);
             for(unsigned idx = 0; idx < cls.size(); idx++){
                 literal l = cls[idx];
                 checkpoint();
@@ -1873,7 +2202,7 @@ namespace nlsat {
                 atom * a = m_atoms[b];
                 SASSERT(a != nullptr);
                 interval_set_ref curr_st(m_ism);
-                curr_st = m_evaluator.infeasible_intervals(a, l.sign(), &cls, m_xk);
+                curr_st = m_evaluator.clause_infeasible_intervals(a, l.sign(), &cls);
                 // empty infeasible --> true
                 if(m_ism.is_empty(curr_st)){
                     R_propagate(l, nullptr);
@@ -1968,6 +2297,8 @@ namespace nlsat {
                 CASSERT("nlsat", check_satisfied());
                 // select next hybrid var to process
                 // mode: BOOL or ARITH
+                if (install_local_search_model())
+                    return l_true;
                 select_next_hybrid_var();
                 DTRACE(std::cout << "xk: x" << m_xk << " bk: b" << m_bk << "\n";
                     std::cout << "mode: " << mode2str(m_search_mode) << std::endl;
@@ -1982,7 +2313,10 @@ namespace nlsat {
                     // exactly one is null_var
                     clause_vector clauses;
                     // find clauses unit to this hybrid var
-                    m_dm.find_next_process_clauses(m_xk, m_bk, clauses, m_search_mode);
+                    {
+                        profiler::scope _ps(m_profiler, PROF_FIND_CLAUSES);
+                        m_dm.find_next_process_clauses(m_xk, m_bk, clauses, m_search_mode);
+                    }
                     // TODO: shall we sort clauses here?
                     if(m_search_mode == ARITH){
                         DTRACE(std::cout << "sort clauses for arith mode\n";);
@@ -1996,6 +2330,8 @@ namespace nlsat {
                     DTRACE(std::cout << "start of process hybrid clauses\n";);
                     conflict_clause = process_hybrid_clauses(clauses);
                     DTRACE(std::cout << "end of process hybrid clauses\n";);
+                    if (conflict_clause == nullptr)
+                        conflict_clause = check_linear_relaxation();
                     if (conflict_clause == nullptr){
                         break;
                     }
@@ -2003,7 +2339,7 @@ namespace nlsat {
                         return l_false;                    
 
                     // wzh restart
-                    if(m_dm.check_restart_requirement()){
+                    if(m_dm.check_restart_requirement() || m_memory_pressure){
                         restart();
                         TRACE("wzh", std::cout << "[restart] leave restart, return unknown for this time's search" << std::endl;);
                         return l_undef;
@@ -2016,7 +2352,8 @@ namespace nlsat {
                     SASSERT(m_bk != null_var);
                     if (m_bvalues[m_bk] == l_undef) {
                         DTRACE(std::cout << "decide in while\n";);
-                        decide(literal(m_bk, true));
+                        bool phase = m_ls_has_hint && m_bk < m_ls_bvalues.size() && m_ls_bvalues[m_bk] == l_true;
+                        decide(literal(m_bk, !phase));
                         // m_bk++;
                     }
                 }
@@ -2037,6 +2374,127 @@ namespace nlsat {
         }
 
 
+        /**
+           \brief Check the linear relaxation of the unit clauses before the search.
+           During the search, the literals are assigned one variable at a time and
+           nlsat finds the conflicts of the relaxation first. When the relaxation of
+           the units is infeasible, its negated core is added as a clause falsified
+           by the units.
+        */
+        void check_unit_relaxation() {
+            if (m_linear_relaxation == nullptr || m_clauses.size() == m_relax_num_clauses)
+                return;
+            m_relax_lits.reset();
+            for (clause * c : m_clauses)
+                if (c->size() == 1 && c->assumptions() == nullptr && m_atoms[(*c)[0].var()] != nullptr)
+                    m_relax_lits.push_back((*c)[0]);
+            m_relax_core.reset();
+            if (m_relax_lits.size() >= 2 &&
+                m_linear_relaxation->check(m_relax_lits.size(), m_relax_lits.data(), m_relax_core) == l_false) {
+                SASSERT(!m_relax_core.empty());
+                for (literal & l : m_relax_core)
+                    l.neg();
+                m_linear_conflicts++;
+                mk_clause(m_relax_core.size(), m_relax_core.data(), false, nullptr);
+                TRACE("nlsat", display(std::cout << "linear conflict of the units: ", *m_clauses.back()) << "\n";);
+            }
+            m_relax_num_clauses = m_clauses.size();
+        }
+
+        /**
+           \brief Check the linear relaxation of the asserted arithmetic literals.
+           Return a conflict clause made of the negated Farkas core, or nullptr.
+        */
+        clause * check_linear_relaxation() {
+            if (m_linear_relaxation == nullptr)
+                return nullptr;
+            if (m_trail.size() == m_relax_trail_size && m_conflicts == m_relax_conflicts)
+                return nullptr;
+            m_relax_trail_size = m_trail.size();
+            m_relax_conflicts = m_conflicts;
+            m_relax_lits.reset();
+            for (trail const & t : m_trail) {
+                if (t.m_kind != trail::BVAR_ASSIGNMENT || m_atoms[t.m_b] == nullptr)
+                    continue;
+                m_relax_lits.push_back(literal(t.m_b, m_bvalues[t.m_b] == l_false));
+            }
+            if (m_relax_lits.size() < 2)
+                return nullptr;
+            m_relax_core.reset();
+            if (m_linear_relaxation->check(m_relax_lits.size(), m_relax_lits.data(), m_relax_core) != l_false)
+                return nullptr;
+            SASSERT(!m_relax_core.empty());
+            for (literal & l : m_relax_core)
+                l.neg();
+            m_linear_conflicts++;
+            clause * cls = mk_clause_core(m_relax_core.size(), m_relax_core.data(), false, nullptr);
+            std::sort(cls->begin(), cls->end(), lit_lt(*this));
+            m_valids.push_back(cls);
+            TRACE("nlsat", display(std::cout << "linear conflict: ", *cls) << "\n";);
+            return cls;
+        }
+
+        /**
+           \brief Run the local search next to search_check, in a thread unless
+           SINGLE_THREAD is defined. The local search is canceled and joined on exit.
+        */
+        struct scoped_local_search {
+            imp & m;
+#ifndef SINGLE_THREAD
+            std::thread m_thread;
+#endif
+            scoped_local_search(imp & m): m(m) {
+                m.m_ls_has_hint = false;
+                m.m_ls_installed = false;
+                m.m_local_search = nullptr;
+                if (!m.m_use_local_search)
+                    return;
+                m.m_local_search = alloc(local_search, m.m_solver, m.m_atoms, m.m_clauses, m.m_ctx.m_params);
+                local_search * ls = m.m_local_search.get();
+#ifndef SINGLE_THREAD
+                m_thread = std::thread([ls]() { (*ls)(); });
+#else
+                (*ls)();
+#endif
+            }
+            ~scoped_local_search() {
+                if (!m.m_local_search)
+                    return;
+                m.m_local_search->cancel();
+#ifndef SINGLE_THREAD
+                m_thread.join();
+#endif
+                m.m_ls_has_hint = false;
+            }
+        };
+
+        /**
+           \brief Replace the current search state by the model of the local search.
+        */
+        bool install_local_search_model() {
+            if (!m_local_search || m_ls_installed || !m_local_search->is_sat())
+                return false;
+            if (!m_local_search->get_best(m_ls_values, m_ls_bvalues))
+                return false;
+            TRACE("nlsat", std::cout << "model found by local search\n";);
+            init_search();
+            scoped_anum v(m_am);
+            for (var x = 0; x < num_vars(); ++x) {
+                m_am.set(v, m_ls_values[x].to_mpq());
+                m_assignment.set_core(x, v);
+            }
+            fix_patch();
+            for (bool_var b = 0; b < m_atoms.size(); ++b) {
+                if (m_atoms[b] == nullptr)
+                    m_bvalues[b] = b < m_ls_bvalues.size() ? m_ls_bvalues[b] : l_false;
+                else
+                    m_bvalues[b] = to_lbool(m_evaluator.eval(m_atoms[b], false));
+            }
+            m_local_search_models++;
+            m_ls_installed = true;
+            return true;
+        }
+
         lbool search_check() {
             lbool r = l_undef;
             // wzh restart
@@ -2061,7 +2519,11 @@ namespace nlsat {
                 if(r == l_undef){
                     // restart and continue search
                     m_restarts++;
+                    if (m_memory_pressure)
+                        reduce_memory();
                     m_dm.minimize_learned();
+                    if (m_local_search)
+                        m_ls_has_hint = m_local_search->get_best(m_ls_values, m_ls_bvalues);
                     continue;
                 }
 
@@ -2118,6 +2580,11 @@ namespace nlsat {
         }
 
         lbool check() {
+            // the trail of a previous check is undone with the watches it was built with,
+            // before the clauses and the pure Boolean variables change
+            undo_search();
+            add_family_clauses();
+            open_trace();
             TRACE("nlsat_smt2", display_smt2(std::cout););
             TRACE("nlsat_fd", std::cout << "is_full_dimensional: " << is_full_dimensional() << "\n";);
             DTRACE(display_order_mode(std::cout););
@@ -2126,6 +2593,11 @@ namespace nlsat {
                 if (!simplify()) 
                     return l_false;
             }
+            if (m_preprocess)
+                m_simplify(!m_incremental);
+            if (m_propagate_bounds)
+                m_icp_bounds += m_icp();
+            check_unit_relaxation();
 
             init_pure_bool();
             m_dm.set_arith_num(num_vars());
@@ -2135,7 +2607,11 @@ namespace nlsat {
             bool reordered = false;
             m_dm.init_learnt_management();
             TRACE("wzh", std::cout << "show var order:\n"; display_vars(std::cout););
-            lbool r = search_check();
+            lbool r;
+            {
+                scoped_local_search _ls(*this);
+                r = search_check();
+            }
             CTRACE("nlsat_model", r == l_true, std::cout << "model before restore order\n"; display_assignment(std::cout););
             if (reordered) {
                 restore_order();
@@ -2147,11 +2623,15 @@ namespace nlsat {
             return r;
         }
 
-        void init_search() {
+        void undo_search() {
             undo_until_empty();
             while (m_scope_lvl > 0) {
                 undo_new_level();
             }
+        }
+
+        void init_search() {
+            undo_search();
             m_xk = null_var;
             for (unsigned i = 0; i < m_bvalues.size(); ++i) {
                 m_bvalues[i] = l_undef;
@@ -2216,6 +2696,8 @@ namespace nlsat {
                 }
             }
             collect(assumptions, m_clauses);
+            if (m_assumption_lemmas)
+                keep_assumption_lemmas(assumptions);
             collect(assumptions, m_learned);
             del_clauses(m_valids);
             if (m_check_lemmas) {
@@ -2251,6 +2733,57 @@ namespace nlsat {
             clauses.shrink(j);
         }
 
+        /**
+           \brief Replace the learned clauses C that only depend on assumptions of the
+           current check by C or ~a1 or ... or ~an, where a1, ..., an are these assumptions.
+           The lemmas are kept for the next checks, whatever their assumptions.
+        */
+        void keep_assumption_lemmas(literal_vector const& assumptions) {
+            unsigned sz = assumptions.size();
+            literal const* ptr = assumptions.data();
+            clause_vector kept;
+            literal_vector lits;
+            vector<assumption, false> deps;
+            unsigned j = 0;
+            for (clause * c : m_learned) {
+                _assumption_set asms = static_cast<_assumption_set>(c->assumptions());
+                bool keep = asms != nullptr;
+                if (keep) {
+                    deps.reset();
+                    m_asm.linearize(asms, deps);
+                    lits.reset();
+                    lits.append(c->size(), c->data());
+                    for (auto dep : deps) {
+                        literal const* lp = static_cast<literal const*>(dep);
+                        if (lp < ptr || ptr + sz <= lp) {
+                            keep = false;
+                            break;
+                        }
+                        if (lits.contains(*lp)) {
+                            keep = false;
+                            break;
+                        }
+                        if (!lits.contains(~(*lp)))
+                            lits.push_back(~(*lp));
+                    }
+                }
+                if (!keep) {
+                    m_learned[j++] = c;
+                    continue;
+                }
+                TRACE("nlsat", display(std::cout << "keep lemma: ", lits.size(), lits.data()) << "\n";);
+                kept.push_back(mk_clause_core(lits.size(), lits.data(), true, nullptr));
+                del_clause(c);
+            }
+            m_learned.shrink(j);
+            for (clause * c : kept) {
+                std::sort(c->begin(), c->end(), lit_lt(*this));
+                m_learned.push_back(c);
+                m_dm.clause_bump_act(*c);
+            }
+            m_assumption_lemmas_kept += kept.size();
+        }
+
         bool collect(literal_vector const& assumptions, clause const& c) {
             unsigned sz = assumptions.size();
             literal const* ptr = assumptions.data();            
@@ -2393,8 +2926,13 @@ namespace nlsat {
 
             m_lazy_clause.reset();
             // wzh dynamic
-            m_explain(jst.num_lits(), jst.lits(), m_lazy_clause);
+            {
+                profiler::scope _ps(m_profiler, PROF_EXPLAIN);
+                m_explain(jst.num_lits(), jst.lits(), m_lazy_clause);
+            }
             // hzw dynamic
+            if (m_trace)
+                log_conflict_trace(jst.num_lits(), jst.lits());
             for (unsigned i = 0; i < sz; i++)
                 m_lazy_clause.push_back(~jst.lit(i));
 
@@ -2440,6 +2978,102 @@ namespace nlsat {
             }
         }
         
+        /**
+           \brief Record the conflict explained by the last call to m_explain in the binary trace.
+        */
+        void log_conflict_trace(unsigned n, literal const * core) {
+            var_vector xs;
+            unsigned_vector stages;
+            for (var x = 0; x < num_vars(); ++x) {
+                if (m_assignment.is_assigned(x)) {
+                    xs.push_back(x);
+                    stages.push_back(m_dm.find_stage(x, false));
+                }
+            }
+            m_trace->conflict(m_assignment, xs, stages, n, core, m_lazy_clause.size(), m_lazy_clause.data());
+        }
+
+        /**
+           \brief Re-run explain and evaluator::infeasible_intervals on the conflicts recorded in a trace.
+           The atoms of the trace are rebuilt in this (fresh) solver.
+        */
+        void replay(std::istream & in, statistics & st) {
+            trace_reader reader(m_solver, in);
+            scoped_ptr_vector<trace_conflict> conflicts;
+            while (true) {
+                scoped_ptr<trace_conflict> c = alloc(trace_conflict, m_solver);
+                if (!reader.next(*c))
+                    break;
+                conflicts.push_back(c.detach());
+            }
+            init_pure_bool();
+            m_dm.set_arith_num(num_vars());
+
+            stopwatch explain_watch, infeasible_watch;
+            unsigned num_intervals = 0, recorded_lits = 0, replayed_lits = 0, mismatches = 0;
+            for (trace_conflict * c : conflicts) {
+                checkpoint();
+                set_replay_assignment(*c);
+                for (literal l : c->m_core) {
+                    atom * a = m_atoms[l.var()];
+                    if (a == nullptr)
+                        continue;
+                    infeasible_watch.start();
+                    interval_set_ref inf = m_evaluator.infeasible_intervals(a, l.sign(), nullptr, m_dm.max_stage_or_unassigned_atom(a));
+                    infeasible_watch.stop();
+                    num_intervals += m_ism.num_intervals(inf);
+                }
+                m_lazy_clause.reset();
+                explain_watch.start();
+                m_explain(c->m_core.size(), c->m_core.data(), m_lazy_clause);
+                explain_watch.stop();
+                recorded_lits += c->m_lemma.size();
+                replayed_lits += m_lazy_clause.size();
+                if (!same_literals(c->m_lemma, m_lazy_clause))
+                    mismatches++;
+            }
+            m_lazy_clause.reset();
+            init_search();
+            st.update("nlsat replay conflicts", conflicts.size());
+            st.update("nlsat replay explain time", explain_watch.get_seconds());
+            st.update("nlsat replay infeasible time", infeasible_watch.get_seconds());
+            st.update("nlsat replay intervals", num_intervals);
+            st.update("nlsat replay recorded lits", recorded_lits);
+            st.update("nlsat replay lits", replayed_lits);
+            st.update("nlsat replay mismatches", mismatches);
+        }
+
+        /**
+           \brief Install the recorded assignment, assigning the variables in stage order.
+        */
+        void set_replay_assignment(trace_conflict const & c) {
+            init_search();
+            unsigned_vector order;
+            for (unsigned i = 0; i < c.m_vars.size(); ++i)
+                order.push_back(i);
+            std::sort(order.begin(), order.end(), [&](unsigned i, unsigned j) { return c.m_stages[i] < c.m_stages[j]; });
+            unsigned stage = 0;
+            for (unsigned i : order) {
+                // stages without an arithmetic variable (mode switches)
+                for (; stage + 1 < c.m_stages[i]; ++stage)
+                    m_dm.push_assigned_var(null_var, false);
+                m_dm.push_assigned_var(c.m_vars[i], false);
+                ++stage;
+                m_assignment.set(c.m_vars[i], c.m_values[i]);
+            }
+        }
+
+        static bool same_literals(scoped_literal_vector const & a, scoped_literal_vector const & b) {
+            if (a.size() != b.size())
+                return false;
+            literal_vector la, lb;
+            for (literal l : a) la.push_back(l);
+            for (literal l : b) lb.push_back(l);
+            std::sort(la.begin(), la.end());
+            std::sort(lb.begin(), lb.end());
+            return la == lb;
+        }
+
         /**
            \brief Return true if all literals in ls are from previous stages.
         */
@@ -2452,6 +3086,24 @@ namespace nlsat {
             return true;
         }
 
+        /**
+           \brief Return the number of distinct stages of the literals in ls (the stage analogue of the LBD).
+        */
+        unsigned lemma_stage_lbd(unsigned num, literal const * ls) {
+            m_lbd_stages.reset();
+            for (unsigned i = 0; i < num; i++) {
+                var s = m_dm.max_stage_literal(ls[i]);
+                if (s != null_var)
+                    m_lbd_stages.push_back(s);
+            }
+            std::sort(m_lbd_stages.begin(), m_lbd_stages.end());
+            unsigned lbd = 0;
+            for (unsigned i = 0; i < m_lbd_stages.size(); i++)
+                if (i == 0 || m_lbd_stages[i] != m_lbd_stages[i-1])
+                    lbd++;
+            return lbd;
+        }
+
         /**
            \brief Return the maximum scope level in ls. 
            
@@ -2558,6 +3210,7 @@ namespace nlsat {
         */
        // remember here we delete const clause
         bool resolve(clause & conflict) {
+            profiler::scope _ps(m_profiler, PROF_RESOLVE);
             DTRACE(display_trails(std::cout););
             clause * conflict_clause = &conflict;
             m_lemma_assumptions = nullptr;
@@ -2577,6 +3230,7 @@ namespace nlsat {
             // hzw vsids
             m_conflicts++;
             m_dm.inc_curr_conflicts();
+            unsigned trail_size = m_dm.assigned_size();
             TRACE("nlsat", std::cout << "resolve, conflicting clause:\n"; display(std::cout, *conflict_clause) << "\n";
                   std::cout << "xk: "; if (m_xk != null_var) m_display_var(std::cout, m_xk); else std::cout << "<null>"; std::cout << "\n";
                   std::cout << "scope_lvl: " << scope_lvl() << "\n";
@@ -2709,6 +3363,7 @@ namespace nlsat {
             }
 
             reset_marks(); // remove marks from the literals in m_lemmas.
+            m_dm.update_restart_averages(lemma_stage_lbd(m_lemma.size(), m_lemma.data()), trail_size);
             TRACE("nlsat", std::cout << "new lemma:\n"; display(std::cout, m_lemma.size(), m_lemma.data()); std::cout << "\n";
                   std::cout << "found_decision: " << found_decision << "\n";);
             
@@ -2986,6 +3641,18 @@ namespace nlsat {
             st.update("nlsat decisions", m_decisions);
             st.update("nlsat stages", m_stages);
             st.update("nlsat irrational assignments", m_irrational_assignments);
+            st.update("nlsat witness bits", m_witness_bits);
+            st.update("nlsat witness max bits", m_witness_max_bits);
+            st.update("nlsat lookahead calls", m_lookahead_calls);
+            st.update("nlsat lookahead switches", m_lookahead_switches);
+            st.update("nlsat simplifications", m_simplifications);
+            st.update("nlsat icp bounds", m_icp_bounds);
+            st.update("nlsat linear conflicts", m_linear_conflicts);
+            st.update("nlsat local search models", m_local_search_models);
+            st.update("nlsat local search hints", m_local_search_hints);
+            if (m_local_search)
+                m_local_search->collect_statistics(st);
+            collect_memory_statistics(st);
             // basic information
             st.update("nlsat bool vars", m_bool_vars);
             st.update("nlsat arith vars", m_arith_vars);
@@ -2996,9 +3663,46 @@ namespace nlsat {
             st.update("nlsat blocked based branching", m_block_based_branching);
             // wzh restart
             st.update("nlsat restarts", m_restarts);
+            st.update("nlsat blocked restarts", m_blocked_restarts);
             st.update("nlsat learned added", m_learned_added);
             st.update("nlsat learned deleted", m_learned_deleted);
+            st.update("nlsat assumption lemmas kept", m_assumption_lemmas_kept);
+            st.update("nlsat atoms normalized", m_atoms_normalized);
+            st.update("nlsat atoms merged", m_atoms_merged);
+            st.update("nlsat atoms grouped", m_atoms_grouped);
+            st.update("nlsat family clauses", m_family_clauses_added);
             // hzw restart
+            m_profiler.collect_statistics(st);
+            m_am.collect_statistics(st);
+        }
+
+        static size_t clauses_memory_size(clause_vector const & cs) {
+            size_t r = 0;
+            for (clause const * c : cs)
+                r += clause::get_obj_size(c->size());
+            return r;
+        }
+
+        /**
+           \brief Memory of the subsystems in megabytes. The polynomials are the part
+           of the shared allocator not used by clauses, interval sets and algebraic cells.
+        */
+        void collect_memory_statistics(statistics & st) {
+            auto mb = [](size_t n) { return static_cast<double>(n) / (1024.0 * 1024.0); };
+            size_t lemmas   = clauses_memory_size(m_learned);
+            size_t clauses  = clauses_memory_size(m_clauses);
+            size_t isets    = m_ism.memory_size();
+            size_t cells    = m_am.memory_size();
+            size_t used     = lemmas + clauses + isets + cells;
+            size_t total    = m_allocator.get_allocation_size();
+            st.update("nlsat memory lemmas", mb(lemmas));
+            st.update("nlsat memory clauses", mb(clauses));
+            st.update("nlsat memory interval sets", mb(isets));
+            st.update("nlsat memory algebraic cells", mb(cells));
+            st.update("nlsat memory polynomials", mb(total > used ? total - used : 0));
+            st.update("nlsat memory cache", mb(m_cache.memory_size()));
+            st.update("nlsat memory evaluator", mb(m_evaluator.memory_size()));
+            st.update("nlsat memory reductions", m_memory_reductions);
         }
 
         void reset_statistics() {
@@ -3007,10 +3711,26 @@ namespace nlsat {
             m_decisions              = 0;
             m_stages                 = 0;
             m_irrational_assignments = 0;
+            m_witness_bits           = 0;
+            m_witness_max_bits       = 0;
+            m_lookahead_calls        = 0;
+            m_lookahead_switches     = 0;
+            m_simplifications        = 0;
+            m_icp_bounds             = 0;
+            m_linear_conflicts       = 0;
+            m_local_search_models    = 0;
+            m_local_search_hints     = 0;
+            m_memory_reductions      = 0;
             // wzh restart
             m_restarts               = 0;
+            m_blocked_restarts       = 0;
             m_learned_added          = 0;
             m_learned_deleted        = 0;
+            m_assumption_lemmas_kept = 0;
+            m_atoms_normalized       = 0;
+            m_atoms_merged           = 0;
+            m_atoms_grouped          = 0;
+            m_family_clauses_added   = 0;
             // hzw restart
             m_total_vars             = 0;
             m_bool_vars              = 0;
@@ -3019,6 +3739,8 @@ namespace nlsat {
             m_pick_arith             = 0;
             m_unit_propagate         = 0;
             m_block_based_branching = 0;
+            m_profiler.reset();
+            m_am.reset_statistics();
         }
 
         // -----------------------
@@ -4421,7 +5143,7 @@ namespace nlsat {
                         break;
 
                     case trail::INFEASIBLE_UPDT:
-                        out << "[INFEASIBLE UPDT]: "; m_ism.display(out, ele.m_old_set); out << std::endl;
+                        out << "[INFEASIBLE UPDT]: " << ele.m_x << " "; m_ism.display(out, ele.m_old_set); out << std::endl;
                         break;
 
                     case trail::NEW_LEVEL:
@@ -4580,11 +5302,19 @@ namespace nlsat {
         m_imp->m_display_assumption = &proc;
     }
 
+    void solver::set_linear_relaxation(linear_relaxation * r) {
+        m_imp->m_linear_relaxation = r;
+    }
+
 
     unsigned solver::num_vars() const {
         return m_imp->num_vars();
     }
 
+    unsigned solver::num_learned_clauses() const {
+        return m_imp->num_learned_clauses();
+    }
+
     bool solver::is_int(var x) const {
         return m_imp->is_int(x);
     }
@@ -4778,6 +5508,24 @@ namespace nlsat {
         m_imp->del_clause(cls);
     }
 
+    clause * solver::mk_clause(unsigned num_lits, literal const * lits, bool learned, assumption_set a) {
+        return m_imp->mk_clause(num_lits, lits, learned, static_cast<imp::_assumption_set>(a));
+    }
+
+    bool solver::has_root_atom(clause const & c) const {
+        return m_imp->has_root_atom(c);
+    }
+
+    void solver::add_patch(var x, poly * p, poly * q) {
+        m_imp->m_patch_var.push_back(x);
+        m_imp->m_patch_num.push_back(q);
+        m_imp->m_patch_denom.push_back(p);
+    }
+
+    void solver::inc_simplify() {
+        m_imp->m_simplifications++;
+    }
+
     std::ostream & solver::display(std::ostream & out, clause const & cls) const {
         return m_imp->display(out, cls);
     }
@@ -4798,4 +5546,8 @@ namespace nlsat {
         m_imp->incremental_compute_clause_infset(x, cls);
     }
     // dnlsat
+
+    void solver::replay(std::istream & in, statistics & st) {
+        m_imp->replay(in, st);
+    }
 };
\ No newline at end of file
@@ -37,6 +37,21 @@ namespace nlsat {
         virtual std::ostream& operator()(std::ostream& out, assumption a) const = 0;
     };
 
+    /**
+       \brief Linear relaxation of the asserted arithmetic literals, where the
+       nonlinear monomials are abstracted as fresh variables.
+    */
+    class linear_relaxation {
+    public:
+        virtual ~linear_relaxation() = default;
+        /**
+           \brief Return l_false if the conjunction of the literals is infeasible
+           in the relaxation, core receives the literals of the Farkas explanation.
+           Literals that cannot be relaxed are ignored.
+        */
+        virtual lbool check(unsigned n, literal const * lits, literal_vector & core) = 0;
+    };
+
     class solver {
         struct imp;
         struct ctx;
@@ -66,6 +81,11 @@ namespace nlsat {
 
         void set_display_assumption(display_assumption_proc const& proc);
 
+        /**
+           \brief Check the relaxation at each stage of the search, the solver does not own r.
+        */
+        void set_linear_relaxation(linear_relaxation * r);
+
         // -----------------------
         //
         // Variable, Atoms, Clauses & Assumption creation
@@ -121,6 +141,11 @@ namespace nlsat {
         */
         void mk_clause(unsigned num_lits, literal * lits, assumption a = nullptr);
 
+        /**
+           \brief Create a new clause that depends on the assumption set \c a.
+        */
+        clause * mk_clause(unsigned num_lits, literal const * lits, bool learned, assumption_set a);
+
         // -----------------------
         //
         // Basic
@@ -184,6 +209,11 @@ namespace nlsat {
         */
         unsigned num_vars() const;
 
+        /**
+           \brief Return the number of learned clauses.
+        */
+        unsigned num_learned_clauses() const;
+
         bool is_int(var x) const;
 
         // -----------------------
@@ -266,6 +296,15 @@ namespace nlsat {
         // dnlsat
          void del_clause(clause *);
 
+         bool has_root_atom(clause const & c) const;
+
+         /**
+            \brief Record that models must assign x to q/p, x was eliminated by the simplifier.
+         */
+         void add_patch(var x, poly * p, poly * q);
+
+         void inc_simplify();
+
          std::ostream & display(std::ostream & out, clause const & cls) const;
          std::ostream & display_bool_assignment(std::ostream & out) const;
 
@@ -275,6 +314,13 @@ namespace nlsat {
 
          void incremental_compute_clause_infset(var x, clause const *cls);
         // dnlsat
+
+        /**
+           \brief Replay a binary conflict trace (see nlsat.trace_file) on this fresh solver.
+           Only explain and evaluator::infeasible_intervals are executed; timings and
+           lemma differences are stored in st.
+        */
+        void replay(std::istream & in, statistics & st);
     };
 
 };
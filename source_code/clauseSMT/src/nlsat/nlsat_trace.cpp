@@ -0,0 +1,463 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_trace.cpp
+
+Abstract:
+
+    Compact binary trace of the conflicts explained by the nlsat search.
+
+Revision History:
+
+--*/
+#include <cstring>
+#include "util/map.h"
+#include "util/ref_buffer.h"
+#include "util/uint_set.h"
+#include "nlsat/nlsat_trace.h"
+#include "nlsat/nlsat_solver.h"
+
+namespace nlsat {
+
+    static const char     TRACE_MAGIC[4]   = { 'N', 'L', 'T', 'R' };
+    static const unsigned TRACE_VERSION    = 2;
+
+    enum trace_record {
+        TR_VAR      = 'V',
+        TR_POLY     = 'P',
+        TR_CONFLICT = 'C'
+    };
+
+    enum trace_value {
+        TV_RATIONAL  = 0,
+        TV_ALGEBRAIC = 1
+    };
+
+    enum trace_literal {
+        TL_BOOL = 0,
+        TL_INEQ = 1,
+        TL_ROOT = 2
+    };
+
+    // --------------------------------
+    //
+    // trace_writer
+    //
+    // --------------------------------
+
+    struct trace_writer::imp {
+        solver &              m_solver;
+        std::ostream &        m_out;
+        pmanager &            m_pm;
+        anum_manager &        m_am;
+        unsynch_mpq_manager & m_qm;
+        polynomial_ref_vector m_pinned;   // keeps written polynomials (and their ids) alive
+        uint_set              m_written;
+        unsigned              m_num_vars;
+        unsigned              m_num_conflicts;
+        svector<mpz>          m_coeffs;
+        svector<digit_t>      m_digits;
+
+        imp(solver & s, std::ostream & out):
+            m_solver(s),
+            m_out(out),
+            m_pm(s.pm()),
+            m_am(s.am()),
+            m_qm(s.qm()),
+            m_pinned(m_pm),
+            m_num_vars(0),
+            m_num_conflicts(0) {
+            m_out.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+            write_uint(TRACE_VERSION);
+        }
+
+        ~imp() {
+            for (mpz & c : m_coeffs)
+                m_qm.del(c);
+            m_out.flush();
+        }
+
+        void write_byte(unsigned char b) {
+            m_out.put(static_cast<char>(b));
+        }
+
+        void write_uint(unsigned u) {
+            m_out.write(reinterpret_cast<char const*>(&u), sizeof(u));
+        }
+
+        // the sign, the number of limbs and the limbs of the magnitude, least significant first
+        void write_mpz(mpz const & a) {
+            write_byte(m_qm.decompose(a, m_digits));
+            write_uint(m_digits.size());
+            for (digit_t d : m_digits)
+                write_uint(static_cast<unsigned>(d));
+        }
+
+        void write_mpq(mpq const & a) {
+            write_mpz(a.numerator());
+            write_mpz(a.denominator());
+        }
+
+        void write_vars() {
+            unsigned n = m_solver.num_vars();
+            if (n == m_num_vars)
+                return;
+            write_byte(TR_VAR);
+            write_uint(n - m_num_vars);
+            for (var x = m_num_vars; x < n; ++x)
+                write_byte(m_solver.is_int(x));
+            m_num_vars = n;
+        }
+
+        unsigned write_poly(poly * p) {
+            unsigned id = m_pm.id(p);
+            if (m_written.contains(id))
+                return id;
+            m_written.insert(id);
+            m_pinned.push_back(p);
+            write_byte(TR_POLY);
+            write_uint(id);
+            unsigned sz = m_pm.size(p);
+            write_uint(sz);
+            for (unsigned i = 0; i < sz; ++i) {
+                write_mpz(m_pm.coeff(p, i));
+                polynomial::monomial * m = m_pm.get_monomial(p, i);
+                unsigned msz = m_pm.size(m);
+                write_uint(msz);
+                for (unsigned j = 0; j < msz; ++j) {
+                    write_uint(m_pm.get_var(m, j));
+                    write_uint(m_pm.degree(m, j));
+                }
+            }
+            return id;
+        }
+
+        // polynomials must be written before the conflict record that refers to them.
+        void write_polys(literal l) {
+            atom * a = m_solver.bool_var2atom(l.var());
+            if (a == nullptr)
+                return;
+            if (a->is_ineq_atom()) {
+                ineq_atom * ia = to_ineq_atom(a);
+                for (unsigned i = 0; i < ia->size(); ++i)
+                    write_poly(ia->p(i));
+            }
+            else {
+                write_poly(to_root_atom(a)->p());
+            }
+        }
+
+        void write_literal(literal l) {
+            atom * a = m_solver.bool_var2atom(l.var());
+            if (a == nullptr) {
+                write_byte(TL_BOOL);
+                write_uint(l.index());
+                return;
+            }
+            write_byte(a->is_ineq_atom() ? TL_INEQ : TL_ROOT);
+            write_byte(l.sign());
+            write_byte(a->get_kind());
+            if (a->is_ineq_atom()) {
+                ineq_atom * ia = to_ineq_atom(a);
+                write_uint(ia->size());
+                for (unsigned i = 0; i < ia->size(); ++i) {
+                    write_uint(m_pm.id(ia->p(i)));
+                    write_byte(ia->is_even(i));
+                }
+            }
+            else {
+                root_atom * ra = to_root_atom(a);
+                write_uint(ra->x());
+                write_uint(ra->i());
+                write_uint(m_pm.id(ra->p()));
+            }
+        }
+
+        void write_value(anum const & v) {
+            if (m_am.is_rational(v)) {
+                scoped_mpq q(m_qm);
+                m_am.to_rational(v, q);
+                write_byte(TV_RATIONAL);
+                write_mpq(q);
+            }
+            else {
+                m_am.get_polynomial(v, m_coeffs);
+                write_byte(TV_ALGEBRAIC);
+                write_uint(m_coeffs.size());
+                for (mpz const & c : m_coeffs)
+                    write_mpz(c);
+                write_uint(m_am.get_i(v));
+            }
+        }
+
+        void conflict(assignment const & as, var_vector const & xs, unsigned_vector const & stages,
+                      unsigned n, literal const * core, unsigned m, literal const * lemma) {
+            SASSERT(xs.size() == stages.size());
+            write_vars();
+            for (unsigned i = 0; i < n; ++i)
+                write_polys(core[i]);
+            for (unsigned i = 0; i < m; ++i)
+                write_polys(lemma[i]);
+            write_byte(TR_CONFLICT);
+            write_uint(xs.size());
+            for (unsigned i = 0; i < xs.size(); ++i) {
+                write_uint(xs[i]);
+                write_uint(stages[i]);
+                write_value(as.value(xs[i]));
+            }
+            write_uint(n);
+            for (unsigned i = 0; i < n; ++i)
+                write_literal(core[i]);
+            write_uint(m);
+            for (unsigned i = 0; i < m; ++i)
+                write_literal(lemma[i]);
+            m_num_conflicts++;
+        }
+    };
+
+    trace_writer::trace_writer(solver & s, std::ostream & out) {
+        m_imp = alloc(imp, s, out);
+    }
+
+    trace_writer::~trace_writer() {
+        dealloc(m_imp);
+    }
+
+    void trace_writer::conflict(assignment const & as, var_vector const & xs, unsigned_vector const & stages,
+                                unsigned n, literal const * core, unsigned m, literal const * lemma) {
+        m_imp->conflict(as, xs, stages, n, core, m, lemma);
+    }
+
+    unsigned trace_writer::num_conflicts() const {
+        return m_imp->m_num_conflicts;
+    }
+
+    unsigned trace_writer::num_polynomials() const {
+        return m_imp->m_pinned.size();
+    }
+
+    // --------------------------------
+    //
+    // trace_reader
+    //
+    // --------------------------------
+
+    trace_conflict::trace_conflict(solver & s):
+        m_values(s.am()),
+        m_core(s),
+        m_lemma(s) {
+    }
+
+    struct trace_reader::imp {
+        solver &              m_solver;
+        std::istream &        m_in;
+        pmanager &            m_pm;
+        anum_manager &        m_am;
+        unsynch_mpq_manager & m_qm;
+        polynomial_ref_vector m_polys;
+        u_map<poly*>          m_id2poly;
+        u_map<bool_var>       m_bool2var;
+        svector<digit_t>      m_digits;
+
+        imp(solver & s, std::istream & in):
+            m_solver(s),
+            m_in(in),
+            m_pm(s.pm()),
+            m_am(s.am()),
+            m_qm(s.qm()),
+            m_polys(m_pm) {
+            char magic[sizeof(TRACE_MAGIC)];
+            m_in.read(magic, sizeof(magic));
+            if (!m_in || memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0)
+                throw default_exception("not an nlsat trace");
+            if (read_uint() != TRACE_VERSION)
+                throw default_exception("unsupported nlsat trace version");
+        }
+
+        void check() {
+            if (!m_in)
+                throw default_exception("truncated nlsat trace");
+        }
+
+        unsigned char read_byte() {
+            int c = m_in.get();
+            check();
+            return static_cast<unsigned char>(c);
+        }
+
+        unsigned read_uint() {
+            unsigned u = 0;
+            m_in.read(reinterpret_cast<char*>(&u), sizeof(u));
+            check();
+            return u;
+        }
+
+        void read_mpz(mpz & a) {
+            bool neg = read_byte() != 0;
+            unsigned sz = read_uint();
+            m_digits.reset();
+            for (unsigned i = 0; i < sz; ++i)
+                m_digits.push_back(read_uint());
+            m_qm.set_digits(a, m_digits.size(), m_digits.data());
+            if (neg)
+                m_qm.neg(a);
+        }
+
+        void read_mpq(mpq & a) {
+            scoped_mpz n(m_qm), d(m_qm);
+            read_mpz(n);
+            read_mpz(d);
+            m_qm.set(a, n, d);
+        }
+
+        void read_vars() {
+            unsigned n = read_uint();
+            for (unsigned i = 0; i < n; ++i)
+                m_solver.mk_var(read_byte() != 0);
+        }
+
+        void read_poly() {
+            unsigned id = read_uint();
+            unsigned sz = read_uint();
+            scoped_mpz_vector coeffs(m_qm);
+            ref_buffer<polynomial::monomial, pmanager> ms(m_pm);
+            var_vector xs;
+            for (unsigned i = 0; i < sz; ++i) {
+                coeffs.push_back(mpz());
+                read_mpz(coeffs.back());
+                unsigned msz = read_uint();
+                xs.reset();
+                for (unsigned j = 0; j < msz; ++j) {
+                    var x = read_uint();
+                    unsigned k = read_uint();
+                    if (x >= m_solver.num_vars())
+                        throw default_exception("nlsat trace refers to an undeclared variable");
+                    for (unsigned l = 0; l < k; ++l)
+                        xs.push_back(x);
+                }
+                ms.push_back(m_pm.mk_monomial(xs.size(), xs.data()));
+            }
+            polynomial_ref p(m_pm);
+            p = m_pm.mk_polynomial(sz, coeffs.data(), ms.data());
+            m_polys.push_back(p);
+            m_id2poly.insert(id, p.get());
+        }
+
+        poly * get_poly(unsigned id) {
+            poly * p = nullptr;
+            if (!m_id2poly.find(id, p))
+                throw default_exception("nlsat trace refers to an undefined polynomial");
+            return p;
+        }
+
+        literal read_literal() {
+            unsigned char tag = read_byte();
+            if (tag == TL_BOOL) {
+                // Boolean variables without atoms are only identified within the trace.
+                literal l = to_literal(read_uint());
+                bool_var b;
+                if (!m_bool2var.find(l.var(), b)) {
+                    b = m_solver.mk_bool_var();
+                    m_bool2var.insert(l.var(), b);
+                }
+                return literal(b, l.sign());
+            }
+            bool sign = read_byte() != 0;
+            atom::kind k = static_cast<atom::kind>(read_byte());
+            bool_var b;
+            if (tag == TL_INEQ) {
+                unsigned sz = read_uint();
+                ptr_buffer<poly> ps;
+                bool_vector is_even;
+                for (unsigned i = 0; i < sz; ++i) {
+                    ps.push_back(get_poly(read_uint()));
+                    is_even.push_back(read_byte() != 0);
+                }
+                b = m_solver.mk_ineq_atom(k, sz, ps.data(), is_even.data());
+            }
+            else {
+                var x = read_uint();
+                unsigned i = read_uint();
+                poly * p = get_poly(read_uint());
+                b = m_solver.mk_root_atom(k, x, i, p);
+            }
+            return literal(b, sign);
+        }
+
+        void read_value(anum & v) {
+            if (read_byte() == TV_RATIONAL) {
+                scoped_mpq q(m_qm);
+                read_mpq(q);
+                m_am.set(v, q);
+                return;
+            }
+            unsigned sz = read_uint();
+            scoped_mpz_vector coeffs(m_qm);
+            for (unsigned i = 0; i < sz; ++i) {
+                coeffs.push_back(mpz());
+                read_mpz(coeffs.back());
+            }
+            unsigned i = read_uint();
+            polynomial_ref p(m_pm);
+            p = m_pm.to_polynomial(sz, coeffs.data(), 0);
+            m_am.mk_root(p, i, v);
+        }
+
+        void read_conflict(trace_conflict & c) {
+            c.m_vars.reset();
+            c.m_stages.reset();
+            c.m_values.reset();
+            c.m_core.reset();
+            c.m_lemma.reset();
+            unsigned n = read_uint();
+            for (unsigned i = 0; i < n; ++i) {
+                c.m_vars.push_back(read_uint());
+                c.m_stages.push_back(read_uint());
+                c.m_values.push_back(anum());
+                read_value(c.m_values.back());
+            }
+            n = read_uint();
+            for (unsigned i = 0; i < n; ++i)
+                c.m_core.push_back(read_literal());
+            n = read_uint();
+            for (unsigned i = 0; i < n; ++i)
+                c.m_lemma.push_back(read_literal());
+        }
+
+        bool next(trace_conflict & c) {
+            while (true) {
+                int tag = m_in.get();
+                if (tag == EOF)
+                    return false;
+                switch (tag) {
+                case TR_VAR:
+                    read_vars();
+                    break;
+                case TR_POLY:
+                    read_poly();
+                    break;
+                case TR_CONFLICT:
+                    read_conflict(c);
+                    return true;
+                default:
+                    throw default_exception("unknown nlsat trace record");
+                }
+            }
+        }
+    };
+
+    trace_reader::trace_reader(solver & s, std::istream & in) {
+        m_imp = alloc(imp, s, in);
+    }
+
+    trace_reader::~trace_reader() {
+        dealloc(m_imp);
+    }
+
+    bool trace_reader::next(trace_conflict & c) {
+        return m_imp->next(c);
+    }
+
+};
@@ -0,0 +1,85 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_trace.h
+
+Abstract:
+
+    Compact binary trace of the conflicts explained by the nlsat search,
+    and the reader used to replay them offline.
+
+    A trace is a sequence of records:
+      - polynomial records: every polynomial is written once, the first
+        time an atom refers to it. Later records refer to it by id.
+      - conflict records: the core literals handed to explain, the
+        arithmetic assignment (with the stage of every assigned variable)
+        and the literals explain produced.
+      Numbers are written as a sign byte, the number of limbs and the
+      32 bit limbs of their magnitude, least significant first.
+
+    The replay (see solver::replay) rebuilds the atoms inside a fresh
+    solver and re-runs only explain and evaluator::infeasible_intervals
+    on the recorded inputs.
+
+Revision History:
+
+--*/
+#pragma once
+
+#include <iostream>
+#include "nlsat/nlsat_types.h"
+#include "nlsat/nlsat_assignment.h"
+#include "nlsat/nlsat_scoped_literal_vector.h"
+
+namespace nlsat {
+
+    class solver;
+
+    class trace_writer {
+        struct imp;
+        imp * m_imp;
+    public:
+        trace_writer(solver & s, std::ostream & out);
+        ~trace_writer();
+
+        /**
+           \brief Record a conflict: core[0], ..., core[n-1] is infeasible in the
+           assignment \c as, and explain produced lemma[0], ..., lemma[m-1].
+           xs/stages give the stage of every assigned arithmetic variable.
+        */
+        void conflict(assignment const & as, var_vector const & xs, unsigned_vector const & stages,
+                      unsigned n, literal const * core, unsigned m, literal const * lemma);
+
+        unsigned num_conflicts() const;
+        unsigned num_polynomials() const;
+    };
+
+    /**
+       \brief A decoded conflict record. Atoms are rebuilt in the solver given to the reader.
+    */
+    struct trace_conflict {
+        var_vector            m_vars;    // assigned arithmetic variables
+        unsigned_vector       m_stages;  // stage of m_vars[i]
+        scoped_anum_vector    m_values;  // value of m_vars[i]
+        scoped_literal_vector m_core;
+        scoped_literal_vector m_lemma;
+        trace_conflict(solver & s);
+    };
+
+    class trace_reader {
+        struct imp;
+        imp * m_imp;
+    public:
+        trace_reader(solver & s, std::istream & in);
+        ~trace_reader();
+
+        /**
+           \brief Decode the next conflict record into c.
+           Return false at the end of the trace. Throws default_exception if the trace is malformed.
+        */
+        bool next(trace_conflict & c);
+    };
+
+};
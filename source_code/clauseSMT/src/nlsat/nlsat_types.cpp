@@ -27,7 +27,8 @@ namespace nlsat {
     ineq_atom::ineq_atom(kind k, unsigned sz, poly * const * ps, bool const * is_even):
         // atom(k, max_var),
         atom(k),
-        m_size(sz) {
+        m_size(sz),
+        m_family(UINT_MAX) {
         for (unsigned i = 0; i < m_size; i++) {
             m_ps[i] = TAG(poly *, ps[i], is_even[i] ? 1 : 0);
         }
@@ -100,12 +100,14 @@ namespace nlsat {
     class ineq_atom : public atom {
         friend class solver;
         unsigned     m_size;
+        unsigned     m_family;   // atoms p<0, p=0, p>0 over the same factors share their family
         poly *       m_ps[0];
         // ineq_atom(kind k, unsigned sz, poly * const * ps, bool const * is_even, var max_var);
         ineq_atom(kind k, unsigned sz, poly * const * ps, bool const * is_even);
         static unsigned get_obj_size(unsigned sz) { return sizeof(ineq_atom) + sizeof(poly*)*sz; }
     public:
         unsigned size() const { return m_size; }
+        unsigned family() const { return m_family; }
         poly * p(unsigned i) const { SASSERT(i < size()); return UNTAG(poly*, m_ps[i]); }
         // Return true if i-th factor has odd degree
         bool is_odd(unsigned i) const { SASSERT(i < size()); return GET_TAG(m_ps[i]) == 0; }
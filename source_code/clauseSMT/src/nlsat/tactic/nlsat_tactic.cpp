@@ -19,6 +19,8 @@ Notes:
 #include "tactic/tactical.h"
 #include "nlsat/tactic/goal2nlsat.h"
 #include "nlsat/nlsat_solver.h"
+#include "nlsat/nlsat_params.hpp"
+#include "math/lp/nra_relaxation.h"
 #include "model/model.h"
 #include "ast/expr2var.h"
 #include "ast/arith_decl_plugin.h"
@@ -45,6 +47,7 @@ class nlsat_tactic : public tactic {
         params_ref            m_params;
         expr_display_var_proc m_display_var;
         nlsat::solver         m_solver;
+        scoped_ptr<nra::relaxation> m_relaxation;
         goal2nlsat            m_g2nl;
 
         imp(ast_manager & _m, params_ref const & p):
@@ -156,6 +159,11 @@ class nlsat_tactic : public tactic {
             IF_VERBOSE(10000, g->display(verbose_stream()));
 
 
+            if (nlsat_params(m_params).linear_relaxation() && !m_relaxation) {
+                m_relaxation = alloc(nra::relaxation, m_solver, m.limit());
+                m_solver.set_linear_relaxation(m_relaxation.get());
+            }
+
             lbool st = m_solver.check();
             if (st == l_undef) {
             }
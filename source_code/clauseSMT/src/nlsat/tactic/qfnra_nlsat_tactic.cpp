@@ -42,28 +42,31 @@ tactic * mk_qfnra_nlsat_tactic(ast_manager & m, params_ref const & p) {
     else
         factor = mk_skip_tactic();
 
+    // simplify, purify-arith and solve-eqs run several times, a run is skipped
+    // when no other stage changed the goal since the previous run.
+    stage_history * simplify_h = alloc(stage_history, m, "simplify");
+    stage_history * purify_h = alloc(stage_history, m, "purify-arith");
+    stage_history * solve_eqs_h = alloc(stage_history, m, "solve-eqs");
+    auto simplify = [&]() { return stage_tactic(simplify_h, using_params(mk_simplify_tactic(m, p), main_p)); };
+    auto purify = [&]() { return stage_tactic(purify_h, using_params(mk_purify_arith_tactic(m, p), purify_p)); };
+    auto solve_eqs = [&]() { return stage_tactic(solve_eqs_h, mk_solve_eqs_tactic(m, p)); };
+    auto stage = [&](char const * name, tactic * t) { return stage_tactic(alloc(stage_history, m, name), t); };
+
     return and_then(
         mk_report_verbose_tactic("(qfnra-nlsat-tactic)", 10),
-        and_then(using_params(mk_simplify_tactic(m, p),
-                              main_p),
-                 using_params(mk_purify_arith_tactic(m, p),
-                              purify_p),
-                 mk_propagate_values_tactic(m, p),
-                 mk_solve_eqs_tactic(m, p),
-                 mk_elim_uncnstr_tactic(m, p),
-                 mk_elim_term_ite_tactic(m, p),
-                 using_params(mk_purify_arith_tactic(m, p),
-                              purify_p)),
+        and_then(simplify(),
+                 purify(),
+                 stage("propagate-values", mk_propagate_values_tactic(m, p)),
+                 solve_eqs(),
+                 stage("elim-uncnstr", mk_elim_uncnstr_tactic(m, p)),
+                 stage("elim-term-ite", mk_elim_term_ite_tactic(m, p)),
+                 purify()),
         and_then(/* mk_degree_shift_tactic(m, p), */ // may affect full dimensionality detection
-            factor,
-            mk_solve_eqs_tactic(m, p),
-            using_params(mk_purify_arith_tactic(m, p),
-                         purify_p),
-            using_params(mk_simplify_tactic(m, p),
-                         main_p),
-            mk_tseitin_cnf_core_tactic(m, p),
-            using_params(mk_simplify_tactic(m, p),
-                         main_p),
+            stage("factor", factor),
+            solve_eqs(),
+            purify(),
+            simplify(),
+            stage("tseitin-cnf", mk_tseitin_cnf_core_tactic(m, p)),
+            simplify(),
             mk_nlsat_tactic(m, p)));
 }
-
@@ -0,0 +1,420 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    smt2_nlsat.cpp
+
+Abstract:
+
+    Load pure polynomial QF_NRA benchmarks directly into nlsat.
+
+    The script is scanned once and its assertions are compiled into
+    nlsat polynomials, atoms and clauses without creating expressions,
+    so the parser, the rewriters and the preprocessing tactics of the
+    regular front-end are skipped. The compilation follows goal2nlsat:
+    an atom t1 op t2 is the polynomial d1*t1 - d2*t2 compared with zero,
+    and it is factored.
+
+    Conjunctions (and negated disjunctions) at the top-level are split
+    into clauses, disjunctions (and negated conjunctions) below them are
+    flattened into a single clause. Anything else, including malformed
+    input, is rejected, and the script is then processed by the regular
+    front-end.
+
+Revision History:
+
+--*/
+#include "util/map.h"
+#include "util/symbol.h"
+#include "parsers/smt2/smt2scanner.h"
+#include "nlsat/nlsat_solver.h"
+#include "nlsat/tactic/smt2_nlsat.h"
+
+namespace {
+
+    // the script uses a construct that is not handled by the loader
+    struct unsupported {};
+
+    class nlsat_loader {
+        typedef smt2::scanner scanner;
+        typedef map<symbol, unsigned, symbol_hash_proc, symbol_eq_proc> symbol2var;
+
+        scanner                   m_scanner;
+        scanner::token            m_curr;
+        nlsat::solver &           m_solver;
+        nlsat::pmanager &         m_pm;
+        polynomial::factor_params m_fparams;
+        bool                      m_factor;
+        symbol2var                m_arith_vars;
+        symbol2var                m_bool_vars;
+        bool                      m_logic;
+        bool                      m_check_sat;
+
+        void next() { m_curr = m_scanner.scan(); }
+
+        void check(scanner::token t) const {
+            if (m_curr != t)
+                throw unsupported();
+        }
+
+        // and, or take at least two arguments, the other forms are left to the regular front-end
+        void check_num_args(unsigned n) const {
+            if (n < 2)
+                throw unsupported();
+        }
+
+        void check_rparen() {
+            check(scanner::RIGHT_PAREN);
+            next();
+        }
+
+        symbol read_symbol() {
+            check(scanner::SYMBOL_TOKEN);
+            symbol r = m_scanner.get_id();
+            next();
+            return r;
+        }
+
+        void skip_sexpr() {
+            unsigned depth = 0;
+            do {
+                if (m_curr == scanner::LEFT_PAREN)
+                    depth++;
+                else if (m_curr == scanner::RIGHT_PAREN) {
+                    if (depth == 0)
+                        throw unsupported();
+                    depth--;
+                }
+                else if (m_curr == scanner::EOF_TOKEN)
+                    throw unsupported();
+                next();
+            }
+            while (depth > 0);
+        }
+
+        //
+        // Commands
+        //
+
+        void declare(symbol const & name, symbol const & sort) {
+            if (!m_logic || m_arith_vars.contains(name) || m_bool_vars.contains(name))
+                throw unsupported();
+            if (sort == "Real")
+                m_arith_vars.insert(name, m_solver.mk_var(false));
+            else if (sort == "Bool")
+                m_bool_vars.insert(name, m_solver.mk_bool_var());
+            else
+                throw unsupported();
+        }
+
+        void parse_declare_fun() {
+            symbol name = read_symbol();
+            check(scanner::LEFT_PAREN);
+            next();
+            check_rparen();
+            declare(name, read_symbol());
+            check_rparen();
+        }
+
+        void parse_declare_const() {
+            symbol name = read_symbol();
+            declare(name, read_symbol());
+            check_rparen();
+        }
+
+        void parse_set_logic() {
+            if (m_logic || read_symbol() != "QF_NRA")
+                throw unsupported();
+            m_logic = true;
+            check_rparen();
+        }
+
+        void parse_set_info() {
+            check(scanner::KEYWORD_TOKEN);
+            next();
+            if (m_curr != scanner::RIGHT_PAREN)
+                skip_sexpr();
+            check_rparen();
+        }
+
+        void parse_set_option() {
+            check(scanner::KEYWORD_TOKEN);
+            if (m_scanner.get_id() != ":produce-models")
+                throw unsupported();
+            next();
+            skip_sexpr();
+            check_rparen();
+        }
+
+        //
+        // Formulas
+        //
+
+        void mk_clause(nlsat::literal_vector & lits) {
+            unsigned j = 0;
+            for (nlsat::literal l : lits) {
+                if (l == nlsat::true_literal)
+                    return;
+                if (l != nlsat::false_literal)
+                    lits[j++] = l;
+            }
+            lits.shrink(j);
+            m_solver.mk_clause(lits.size(), lits.data(), nullptr);
+        }
+
+        void parse_top(bool sign) {
+            nlsat::literal_vector lits;
+            if (m_curr != scanner::LEFT_PAREN) {
+                parse_lits(sign, lits);
+                mk_clause(lits);
+                return;
+            }
+            next();
+            symbol head = read_symbol();
+            if ((head == "and" && !sign) || (head == "or" && sign)) {
+                unsigned n = 0;
+                for (; m_curr != scanner::RIGHT_PAREN; ++n)
+                    parse_top(sign);
+                check_num_args(n);
+                next();
+            }
+            else if (head == "not") {
+                parse_top(!sign);
+                check_rparen();
+            }
+            else {
+                parse_app_lits(head, sign, lits);
+                mk_clause(lits);
+            }
+        }
+
+        void parse_lits(bool sign, nlsat::literal_vector & lits) {
+            if (m_curr == scanner::LEFT_PAREN) {
+                next();
+                symbol head = read_symbol();
+                parse_app_lits(head, sign, lits);
+                return;
+            }
+            symbol s = read_symbol();
+            unsigned b;
+            if (s == "true")
+                lits.push_back(sign ? nlsat::false_literal : nlsat::true_literal);
+            else if (s == "false")
+                lits.push_back(sign ? nlsat::true_literal : nlsat::false_literal);
+            else if (m_bool_vars.find(s, b))
+                lits.push_back(nlsat::literal(b, sign));
+            else
+                throw unsupported();
+        }
+
+        void parse_app_lits(symbol const & head, bool sign, nlsat::literal_vector & lits) {
+            if ((head == "or" && !sign) || (head == "and" && sign)) {
+                unsigned n = 0;
+                for (; m_curr != scanner::RIGHT_PAREN; ++n)
+                    parse_lits(sign, lits);
+                check_num_args(n);
+                next();
+                return;
+            }
+            if (head == "not") {
+                parse_lits(!sign, lits);
+                check_rparen();
+                return;
+            }
+            nlsat::literal l;
+            if (head == "<")
+                l = parse_atom(nlsat::atom::LT);
+            else if (head == ">")
+                l = parse_atom(nlsat::atom::GT);
+            else if (head == "<=")
+                l = ~parse_atom(nlsat::atom::GT);
+            else if (head == ">=")
+                l = ~parse_atom(nlsat::atom::LT);
+            else if (head == "=")
+                l = parse_atom(nlsat::atom::EQ);
+            else
+                throw unsupported();
+            lits.push_back(sign ? ~l : l);
+        }
+
+        nlsat::atom::kind flip(nlsat::atom::kind k) {
+            switch (k) {
+            case nlsat::atom::EQ: return k;
+            case nlsat::atom::LT: return nlsat::atom::GT;
+            case nlsat::atom::GT: return nlsat::atom::LT;
+            default:
+                UNREACHABLE();
+                return k;
+            }
+        }
+
+        nlsat::literal parse_atom(nlsat::atom::kind k) {
+            polynomial_ref p1(m_pm), p2(m_pm), p(m_pm);
+            rational d1, d2;
+            parse_term(p1, d1);
+            parse_term(p2, d2);
+            check_rparen();
+            rational l = lcm(d1, d2);
+            p1 = m_pm.mul(l / d1, p1);
+            p2 = m_pm.mul(l / d2, p2);
+            p = m_pm.sub(p1, p2);
+            if (m_pm.is_const(p)) {
+                int sign = m_pm.is_zero(p) ? 0 : (m_pm.m().is_pos(m_pm.coeff(p, 0)) ? 1 : -1);
+                bool r = k == nlsat::atom::EQ ? sign == 0 : (k == nlsat::atom::LT ? sign < 0 : sign > 0);
+                return r ? nlsat::true_literal : nlsat::false_literal;
+            }
+            if (!m_factor) {
+                bool is_even = false;
+                polynomial::polynomial * _p = p.get();
+                return nlsat::literal(m_solver.mk_ineq_atom(k, 1, &_p, &is_even), false);
+            }
+            sbuffer<bool> is_even;
+            ptr_buffer<polynomial::polynomial> ps;
+            polynomial::factors fs(m_pm);
+            m_pm.factor(p, fs, m_fparams);
+            for (unsigned i = 0; i < fs.distinct_factors(); i++) {
+                ps.push_back(fs[i]);
+                is_even.push_back(fs.get_degree(i) % 2 == 0);
+            }
+            if (m_pm.m().is_neg(fs.get_constant()))
+                k = flip(k);
+            return nlsat::literal(m_solver.mk_ineq_atom(k, ps.size(), ps.data(), is_even.data()), false);
+        }
+
+        //
+        // Terms, the value of a term is p / d for a positive integer d
+        //
+
+        void parse_term(polynomial_ref & p, rational & d) {
+            if (m_curr == scanner::INT_TOKEN || m_curr == scanner::FLOAT_TOKEN) {
+                rational r = m_scanner.get_number();
+                next();
+                p = m_pm.mk_const(numerator(r));
+                d = denominator(r);
+                return;
+            }
+            if (m_curr == scanner::SYMBOL_TOKEN) {
+                unsigned x;
+                if (!m_arith_vars.find(m_scanner.get_id(), x))
+                    throw unsupported();
+                next();
+                p = m_pm.mk_polynomial(x);
+                d = rational::one();
+                return;
+            }
+            check(scanner::LEFT_PAREN);
+            next();
+            symbol head = read_symbol();
+            polynomial_ref q(m_pm);
+            rational e;
+            if (head == "/") {
+                parse_term(p, d);
+                parse_term(q, e);
+                check_rparen();
+                if (!m_pm.is_const(q) || m_pm.is_zero(q))
+                    throw unsupported();
+                // p/d divided by c is p*denominator(c) / (d*numerator(c))
+                rational c = rational(m_pm.coeff(q, 0)) / e;
+                rational n = numerator(c), m = denominator(c);
+                if (n.is_neg()) {
+                    n.neg();
+                    m.neg();
+                }
+                p = m_pm.mul(m, p);
+                d *= n;
+                return;
+            }
+            if (head != "+" && head != "-" && head != "*")
+                throw unsupported();
+            parse_term(p, d);
+            if (head == "-" && m_curr == scanner::RIGHT_PAREN) {
+                p = m_pm.neg(p);
+                next();
+                return;
+            }
+            while (m_curr != scanner::RIGHT_PAREN) {
+                parse_term(q, e);
+                if (head == "*") {
+                    p = m_pm.mul(p, q);
+                    d *= e;
+                    continue;
+                }
+                rational l = lcm(d, e);
+                p = m_pm.mul(l / d, p);
+                q = m_pm.mul(l / e, q);
+                p = head == "+" ? m_pm.add(p, q) : m_pm.sub(p, q);
+                d = l;
+            }
+            next();
+        }
+
+    public:
+        nlsat_loader(cmd_context & ctx, char const * begin, char const * end, nlsat::solver & s, params_ref const & p):
+            m_scanner(ctx, begin, end),
+            m_curr(scanner::NULL_TOKEN),
+            m_solver(s),
+            m_pm(s.pm()),
+            m_factor(p.get_bool("factor", true)),
+            m_logic(false),
+            m_check_sat(false) {
+            m_fparams.updt_params(p);
+        }
+
+        /**
+           \brief Compile the script into the solver, return false if it has no check-sat.
+        */
+        bool operator()() {
+            next();
+            while (m_curr != scanner::EOF_TOKEN) {
+                check(scanner::LEFT_PAREN);
+                next();
+                symbol cmd = read_symbol();
+                if (cmd == "exit") {
+                    check_rparen();
+                    break;
+                }
+                // the answer is only printed at the end, so check-sat must be the last command
+                if (m_check_sat)
+                    throw unsupported();
+                if (cmd == "set-logic")
+                    parse_set_logic();
+                else if (cmd == "set-info")
+                    parse_set_info();
+                else if (cmd == "set-option")
+                    parse_set_option();
+                else if (cmd == "declare-fun")
+                    parse_declare_fun();
+                else if (cmd == "declare-const")
+                    parse_declare_const();
+                else if (cmd == "assert") {
+                    if (!m_logic)
+                        throw unsupported();
+                    parse_top(false);
+                    check_rparen();
+                }
+                else if (cmd == "check-sat") {
+                    check_rparen();
+                    m_check_sat = true;
+                }
+                else
+                    throw unsupported();
+            }
+            return m_check_sat;
+        }
+    };
+}
+
+bool load_smt2_nlsat(cmd_context & ctx, char const * begin, char const * end, nlsat::solver & s, params_ref const & p) {
+    try {
+        nlsat_loader loader(ctx, begin, end, s, p);
+        return loader();
+    }
+    catch (unsupported) {
+        return false;
+    }
+    catch (z3_exception &) {
+        // malformed input is reported by the regular front-end
+        return false;
+    }
+}
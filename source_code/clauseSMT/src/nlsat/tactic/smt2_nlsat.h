@@ -0,0 +1,31 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    smt2_nlsat.h
+
+Abstract:
+
+    Load pure polynomial QF_NRA benchmarks directly into nlsat.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+
+class cmd_context;
+namespace nlsat {
+    class solver;
+};
+
+/**
+   \brief Compile the SMT-LIB2 script in [begin, end) into s when it only
+   declares arithmetic and Boolean constants and asserts Boolean combinations
+   of polynomial constraints, followed by a single check-sat.
+
+   Return false if the script uses any other construct, is malformed, or has
+   no check-sat. s must then be discarded and the script processed by the
+   regular front-end, which also reports the errors.
+*/
+bool load_smt2_nlsat(cmd_context & ctx, char const * begin, char const * end, nlsat::solver & s, params_ref const & p);
@@ -19,6 +19,8 @@ struct rewriter_params {
     d.insert("cache_all", CPK_BOOL, "cache all intermediate results.", "false","rewriter");
     d.insert("rewrite_patterns", CPK_BOOL, "rewrite patterns.", "false","rewriter");
     d.insert("ignore_patterns_on_ground_qbody", CPK_BOOL, "ignores patterns on quantifiers that don't mention their bound variables.", "true","rewriter");
+    d.insert("shared_cache", CPK_BOOL, "share the simplification results of ground terms with the other rewriters of the same configuration during a check-sat.", "false","rewriter");
+    d.insert("shared_cache.max_size", CPK_UINT, "maximum number of entries of the shared simplification cache, it is flushed when it is full.", "1000000","rewriter");
   }
   /*
      REG_MODULE_PARAMS('rewriter', 'rewriter_params::collect_param_descrs')
@@ -34,5 +36,7 @@ struct rewriter_params {
   bool cache_all() const { return p.get_bool("cache_all", g, false); }
   bool rewrite_patterns() const { return p.get_bool("rewrite_patterns", g, false); }
   bool ignore_patterns_on_ground_qbody() const { return p.get_bool("ignore_patterns_on_ground_qbody", g, true); }
+  bool shared_cache() const { return p.get_bool("shared_cache", g, false); }
+  unsigned shared_cache_max_size() const { return p.get_uint("shared_cache.max_size", g, 1000000u); }
 };
 #endif
@@ -17,6 +17,7 @@ Revision History:
 
 --*/
 #include "util/stack.h"
+#include "util/mapped_file.h"
 #include "ast/datatype_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
 #include "ast/arith_decl_plugin.h"
@@ -3016,11 +3017,11 @@ namespace smt2 {
             parse_ext_cmd(line, pos);
         }
 
-    public:
-        parser(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & p, char const * filename=nullptr):
+        template<typename... Input>
+        parser(params_ref const & p, char const * filename, cmd_context & ctx, Input&&... input):
             m_ctx(ctx),
             m_params(p),
-            m_scanner(ctx, is, interactive),
+            m_scanner(ctx, std::forward<Input>(input)...),
             m_curr(scanner::NULL_TOKEN),
             m_curr_cmd(nullptr),
             m_num_bindings(0),
@@ -3071,6 +3072,15 @@ namespace smt2 {
             updt_params();
         }
 
+    public:
+        parser(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & p, char const * filename=nullptr):
+            parser(p, filename, ctx, is, interactive) {
+        }
+
+        parser(cmd_context & ctx, char const * begin, char const * end, params_ref const & p, char const * filename=nullptr):
+            parser(p, filename, ctx, begin, end) {
+        }
+
         ~parser() {
             reset_stack();
         }
@@ -3211,6 +3221,18 @@ bool parse_smt2_commands(cmd_context & ctx, std::istream & is, bool interactive,
     return p();
 }
 
+bool parse_smt2_commands(cmd_context & ctx, char const * begin, char const * end, params_ref const & ps, char const * filename) {
+    smt2::parser p(ctx, begin, end, ps, filename);
+    return p();
+}
+
+bool parse_smt2_file(cmd_context & ctx, char const * filename, params_ref const & ps) {
+    mapped_file f;
+    if (!f.open(filename))
+        throw default_exception(std::string("failed to open file '") + filename + "'");
+    return parse_smt2_commands(ctx, f.begin(), f.end(), ps, filename);
+}
+
 sort_ref parse_smt2_sort(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & ps, char const * filename) {
     smt2::parser p(ctx, is, interactive, ps, filename);
     return p.parse_sort_ref(filename);
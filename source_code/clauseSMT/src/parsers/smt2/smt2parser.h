@@ -22,6 +22,17 @@ Revision History:
 
 bool parse_smt2_commands(cmd_context & ctx, std::istream & is, bool interactive = false, params_ref const & p = params_ref(), char const * filename = nullptr);
 
+/**
+   \brief Parse the commands in [begin, end), the symbols and numerals are read directly from the range.
+*/
+bool parse_smt2_commands(cmd_context & ctx, char const * begin, char const * end, params_ref const & p = params_ref(), char const * filename = nullptr);
+
+/**
+   \brief Parse the commands of a file, the file is memory mapped when possible.
+   Throws default_exception if the file cannot be opened.
+*/
+bool parse_smt2_file(cmd_context & ctx, char const * filename, params_ref const & p = params_ref());
+
 sexpr_ref parse_sexpr(cmd_context& ctx, std::istream& is, params_ref const& ps, char const* filename);
 
 sort_ref parse_smt2_sort(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & ps, char const * filename);
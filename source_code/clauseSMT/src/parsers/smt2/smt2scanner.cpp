@@ -16,19 +16,34 @@ Author:
 Revision History:
 
 --*/
+#include <cstring>
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define SCANNER_USE_SSE2
+#endif
 #include "parsers/smt2/smt2scanner.h"
 #include "parsers/util/parser_params.hpp"
 
 namespace smt2 {
 
     void scanner::next() {
+        if (m_data) {
+            if (m_at_eof)
+                throw scanner_exception("unexpected end of file");
+            if (m_dpos < m_data_end)
+                m_curr = *m_dpos++;
+            else
+                m_at_eof = true;
+            m_spos++;
+            return;
+        }
         if (m_cache_input)
             m_cache.push_back(m_curr);
         if (m_at_eof)
             throw scanner_exception("unexpected end of file");
         if (m_interactive) {
-            m_curr = m_stream.get();
-            if (m_stream.eof())
+            m_curr = m_stream->get();
+            if (m_stream->eof())
                 m_at_eof = true;
         }
         else if (m_bpos < m_bend) {
@@ -36,8 +51,8 @@ namespace smt2 {
             m_bpos++;
         }
         else {
-            m_stream.read(m_buffer, SCANNER_BUFFER_SIZE);
-            m_bend = static_cast<unsigned>(m_stream.gcount());
+            m_stream->read(m_buffer, SCANNER_BUFFER_SIZE);
+            m_bend = static_cast<unsigned>(m_stream->gcount());
             m_bpos = 0;
             if (m_bpos == m_bend) {
                 m_at_eof = true;
@@ -50,6 +65,127 @@ namespace smt2 {
         m_spos++;
     }
 
+    void scanner::set_curr_ptr(char const * p) {
+        SASSERT(is_mapped());
+        if (p < m_data_end) {
+            m_curr = *p;
+            m_dpos = p + 1;
+        }
+        else {
+            m_dpos   = m_data_end;
+            m_at_eof = true;
+        }
+    }
+
+    // first character in [p, e) that is not a space
+    static char const * skip_spaces(char const * p, char const * e) {
+#ifdef SCANNER_USE_SSE2
+        __m128i const spaces = _mm_set1_epi8(' ');
+        while (e - p >= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(p));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, spaces))) ^ 0xFFFFu;
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+            p += 16;
+        }
+#endif
+        while (p < e && *p == ' ')
+            ++p;
+        return p;
+    }
+
+    /**
+       \brief Skip white spaces and comments in the mapped input, comments are
+       skipped with memchr.
+    */
+    void scanner::skip_mapped_blanks() {
+        char const * p = curr_ptr();
+        char const * e = m_data_end;
+        while (p < e) {
+            char c = *p;
+            if (c == ' ' || c == '\t' || c == '\r') {
+                char const * q = skip_spaces(p + 1, e);
+                m_spos += static_cast<int>(q - p);
+                p = q;
+            }
+            else if (c == '\n') {
+                ++p;
+                new_line();
+            }
+            else if (c == ';') {
+                char const * nl = static_cast<char const *>(memchr(p, '\n', e - p));
+                if (nl == nullptr) {
+                    m_spos += static_cast<int>(e - p);
+                    p = e;
+                }
+                else {
+                    p = nl + 1;
+                    new_line();
+                    m_spos = 1;
+                }
+            }
+            else {
+                break;
+            }
+        }
+        set_curr_ptr(p);
+    }
+
+    scanner::token scanner::read_mapped_symbol() {
+        char const * start = curr_ptr();
+        char const * p = start + 1;
+        char const * e = m_data_end;
+        while (p < e) {
+            signed char n = m_normalized[static_cast<unsigned char>(*p)];
+            if (n != 'a' && n != '0' && n != '-')
+                break;
+            ++p;
+        }
+        m_string.reset();
+        m_string.append(static_cast<unsigned>(p - start), start);
+        m_string.push_back(0);
+        m_id = m_string.begin();
+        m_spos += static_cast<int>(p - start);
+        set_curr_ptr(p);
+        TRACE("scanner", tout << "new symbol: " << m_id << "\n";);
+        return SYMBOL_TOKEN;
+    }
+
+    scanner::token scanner::read_mapped_number() {
+        char const * start = curr_ptr();
+        char const * p = start;
+        char const * e = m_data_end;
+        char const * dot = nullptr;
+        while (p < e && '0' <= *p && *p <= '9')
+            ++p;
+        if (p < e && *p == '.') {
+            dot = p++;
+            while (p < e && '0' <= *p && *p <= '9')
+                ++p;
+        }
+        if (!dot && p - start <= 9) {
+            unsigned v = 0;
+            for (char const * q = start; q < p; ++q)
+                v = 10 * v + (*q - '0');
+            m_number = rational(v);
+        }
+        else {
+            // the digits without the dot, scaled back below
+            m_string.reset();
+            m_string.append(static_cast<unsigned>((dot ? dot : p) - start), start);
+            if (dot)
+                m_string.append(static_cast<unsigned>(p - dot - 1), dot + 1);
+            m_string.push_back(0);
+            m_number = rational(m_string.begin());
+            if (dot)
+                m_number /= power(rational(10), static_cast<unsigned>(p - dot - 1));
+        }
+        m_spos += static_cast<int>(p - start);
+        set_curr_ptr(p);
+        TRACE("scanner", tout << "new number: " << m_number << "\n";);
+        return dot ? FLOAT_TOKEN : INT_TOKEN;
+    }
+
     void scanner::read_comment() {
         SASSERT(curr() == ';');
         next();
@@ -137,6 +273,8 @@ namespace smt2 {
 
     scanner::token scanner::read_symbol() {
         SASSERT(m_normalized[static_cast<unsigned>(curr())] == 'a' || curr() == ':' || curr() == '-');
+        if (is_mapped())
+            return read_mapped_symbol();
         m_string.reset();
         m_string.push_back(curr());
         next();
@@ -145,6 +283,8 @@ namespace smt2 {
 
     scanner::token scanner::read_number() {
         SASSERT('0' <= curr() && curr() <= '9');
+        if (is_mapped())
+            return read_mapped_number();
         rational q(1);
         m_number = rational(curr() - '0');
         next();
@@ -281,10 +421,37 @@ namespace smt2 {
         m_bv_size(UINT_MAX),
         m_bpos(0),
         m_bend(0),
-        m_stream(stream),
-        m_cache_input(false) {
+        m_stream(&stream),
+        m_data(nullptr),
+        m_data_end(nullptr),
+        m_dpos(nullptr),
+        m_cache_input(false),
+        m_cache_begin(nullptr) {
+        init();
+    }
 
+    scanner::scanner(cmd_context & ctx, char const * begin, char const * end) :
+        ctx(ctx),
+        m_interactive(false),
+        m_spos(0),
+        m_curr(0),
+        m_at_eof(false),
+        m_line(1),
+        m_pos(0),
+        m_bv_size(UINT_MAX),
+        m_bpos(0),
+        m_bend(0),
+        m_stream(nullptr),
+        m_data(begin),
+        m_data_end(end),
+        m_dpos(begin),
+        m_cache_input(false),
+        m_cache_begin(begin) {
+        SASSERT(begin != nullptr);
+        init();
+    }
 
+    void scanner::init() {
         for (int i = 0; i < 256; ++i) {
             m_normalized[i] = (signed char) i;
         }
@@ -335,14 +502,17 @@ namespace smt2 {
 
             switch (m_normalized[(unsigned char) c]) {
             case ' ':
-                next();
-                break;
             case '\n':
-                next();
-                new_line();
-                break;
             case ';':
-                read_comment();
+                if (is_mapped())
+                    skip_mapped_blanks();
+                else if (c == ';')
+                    read_comment();
+                else {
+                    next();
+                    if (c == '\n')
+                        new_line();
+                }
                 break;
             case ':':
                 read_symbol();
@@ -380,6 +550,17 @@ namespace smt2 {
 
     char const * scanner::cached_str(unsigned begin, unsigned end) {
         m_cache_result.reset();
+        if (is_mapped()) {
+            char const * b = m_cache_begin + begin;
+            char const * e = m_cache_begin + end;
+            while (b < e && isspace(*b))
+                b++;
+            while (b < e && isspace(e[-1]))
+                e--;
+            m_cache_result.append(static_cast<unsigned>(e - b), b);
+            m_cache_result.push_back(0);
+            return m_cache_result.begin();
+        }
         while (begin < end && isspace(m_cache[begin]))
             begin++;
         while (begin < end && isspace(m_cache[end-1]))
@@ -49,16 +49,27 @@ namespace smt2 {
         unsigned           m_bpos;
         unsigned           m_bend;
         svector<char>      m_string;
-        std::istream&      m_stream;
+        std::istream*      m_stream;
+        // mapped input: the tokens are read directly from [m_data, m_data_end),
+        // m_dpos is the position after the current character.
+        char const *       m_data;
+        char const *       m_data_end;
+        char const *       m_dpos;
         
         bool               m_cache_input;
         svector<char>      m_cache;
+        char const *       m_cache_begin;  // start of the cached input in mapped mode
         svector<char>      m_cache_result;
         
         
         char curr() const { return m_curr; }
         void new_line() { m_line++; m_spos = 0; }
         void next();
+        void init();
+        bool is_mapped() const { return m_data != nullptr; }
+        char const * curr_ptr() const { return m_at_eof ? m_data_end : m_dpos - 1; }
+        void set_curr_ptr(char const * p);
+        void skip_mapped_blanks();
         
     public:
         
@@ -76,6 +87,13 @@ namespace smt2 {
         };
         
         scanner(cmd_context & ctx, std::istream& stream, bool interactive = false);  
+
+        /**
+           \brief Scan the characters in [begin, end), e.g., a memory mapped file.
+           The range must outlive the scanner, symbols and numerals are read
+           directly from it.
+        */
+        scanner(cmd_context & ctx, char const * begin, char const * end);
         
         int get_line() const { return m_line; }
         int get_pos() const { return m_pos; }
@@ -94,11 +112,13 @@ namespace smt2 {
         token read_signed_number();
         token read_string();
         token read_bv_literal();
+        token read_mapped_symbol();
+        token read_mapped_number();
 
-        void start_caching() { m_cache_input = true; m_cache.reset(); }
+        void start_caching() { m_cache_input = true; m_cache.reset(); if (is_mapped()) m_cache_begin = curr_ptr(); }
         void stop_caching() { m_cache_input = false; }
-        unsigned cache_size() const { return m_cache.size(); }
-        void reset_cache() { m_cache.reset(); }
+        unsigned cache_size() const { return is_mapped() ? static_cast<unsigned>(curr_ptr() - m_cache_begin) : m_cache.size(); }
+        void reset_cache() { m_cache.reset(); if (is_mapped()) m_cache_begin = curr_ptr(); }
 
         char const * cached_str(unsigned begin, unsigned end);
     };
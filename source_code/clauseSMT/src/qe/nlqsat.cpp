@@ -18,6 +18,7 @@ Revision History:
 
 --*/
 
+#include "util/gparams.h"
 #include "util/uint_set.h"
 #include "util/scoped_ptr_vector.h"
 #include "ast/expr2var.h"
@@ -52,6 +53,8 @@ namespace qe {
 
         struct stats {
             unsigned m_num_rounds;        
+            unsigned m_num_blocking_clauses;
+            unsigned m_num_reused_lemmas;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }            
         };
@@ -81,7 +84,7 @@ namespace qe {
             solver_state(ast_manager& m, params_ref const& p):
                 m(m),
                 m_params(p),
-                m_solver(m.limit(), p, true),
+                m_solver(m.limit(), solver_params(p), true),
                 m_rmodel(m_solver.am()),
                 m_rmodel0(m_solver.am()),
                 m_valid_model(false),
@@ -93,6 +96,18 @@ namespace qe {
                 reset();
             }
 
+            /**
+               \brief The solver is shared by all quantifier levels and all rounds.
+               The lemmas learned under the assumptions of a round are kept
+               by default, an explicit nlsat.assumption_lemmas is respected.
+            */
+            static params_ref solver_params(params_ref const& p) {
+                params_ref r(p);
+                if (!p.contains("assumption_lemmas") && !gparams::get_module("nlsat").contains("assumption_lemmas"))
+                    r.set_bool("assumption_lemmas", true);
+                return r;
+            }
+
             void g2s(goal const& g) {
                 goal2nlsat gs;
                 gs(g, m_params, m_solver, m_a2b, m_t2x);
@@ -266,6 +281,7 @@ namespace qe {
                 ++m_stats.m_num_rounds;
                 check_cancel();
                 init_assumptions();   
+                m_stats.m_num_reused_lemmas += s.m_solver.num_learned_clauses();
                 lbool res = s.m_solver.check(s.m_asms);
                 TRACE("qe", s.display(tout << res << "\n"); );
                 switch (res) {
@@ -415,6 +431,7 @@ namespace qe {
             SASSERT(!cl.empty());
             nlsat::literal_vector lits(cl.size(), cl.data());
             s.m_solver.mk_clause(lits.size(), lits.data());
+            ++m_stats.m_num_blocking_clauses;
         }
 
         max_level get_level(clause const& cl) {
@@ -842,7 +859,7 @@ namespace qe {
         char const* name() const override { return "nlqsat"; }
 
         void updt_params(params_ref const & p) override {
-            params_ref p2(p);
+            params_ref p2(solver_state::solver_params(p));
             p2.set_bool("factor", false);
             s.m_solver.updt_params(p2);
         }
@@ -936,6 +953,8 @@ namespace qe {
         void collect_statistics(statistics & st) const override {
             st.copy(m_st);
             st.update("qsat num rounds", m_stats.m_num_rounds); 
+            st.update("qsat blocking clauses", m_stats.m_num_blocking_clauses);
+            st.update("qsat reused lemmas", m_stats.m_num_reused_lemmas);
         }
 
         void reset_statistics() override {
@@ -0,0 +1,285 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    batch_frontend.cpp
+
+Abstract:
+
+    Solve the SMT-LIB2 files of a list in a single process.
+
+    The tactics and parameter modules are registered once for the
+    process, and every instance is solved in its own command context by
+    one of the worker threads.
+
+    The limits are enforced by the main thread, which polls the running
+    instances and cancels their resource limit, which is the parent of
+    the limit of the manager that the command context creates. The time
+    limit is per instance. The allocation counter of the memory manager is
+    shared by the workers, so the memory limit is enforced on their sum:
+    when it exceeds the limit times the number of workers, the instance
+    that runs the longest is canceled. Without threads (SINGLE_THREAD)
+    the limits are not enforced.
+
+    The output of an instance is written to <name>.txt, with the result
+    on the first line, and its errors are written to <name>.err. The
+    result is the first answer of a check-sat, or timeout, memoryout,
+    error (the instance failed before an answer) or unknown.
+
+--*/
+#include<iostream>
+#include<fstream>
+#include<sstream>
+#include<string>
+#include<vector>
+#include<chrono>
+#ifndef SINGLE_THREAD
+#include<thread>
+#endif
+#include "util/mutex.h"
+#include "util/rlimit.h"
+#include "util/mapped_file.h"
+#include "util/error_codes.h"
+#include "util/memory_manager.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "shell/smtlib_frontend.h"
+#include "shell/batch_frontend.h"
+
+namespace {
+
+    typedef std::chrono::steady_clock batch_clock;
+
+    struct batch_job {
+        std::string m_path;   // path as written in the list
+        std::string m_file;   // path of the file
+        std::string m_name;   // file name without extension
+    };
+
+    class batch_runner {
+
+        // instance solved by a worker
+        struct running {
+            reslimit *              m_limit;
+            batch_clock::time_point m_start;
+            bool                    m_timeout;
+            bool                    m_memout;
+            running(): m_limit(nullptr), m_timeout(false), m_memout(false) {}
+        };
+
+        std::vector<batch_job> m_jobs;
+        std::string            m_output_dir;
+        unsigned               m_num_threads;
+        unsigned               m_timeout;
+        unsigned               m_memory;
+        mutex                  m_mux;       // protects m_running and the progress output
+        std::vector<running>   m_running;   // indexed by worker
+        atomic<unsigned>       m_next;
+        atomic<unsigned>       m_finished;
+
+        static std::string dir_name(std::string const & path) {
+            size_t pos = path.find_last_of('/');
+            return pos == std::string::npos ? "." : path.substr(0, pos);
+        }
+
+        static std::string join_path(std::string const & dir, std::string const & file) {
+            if (!file.empty() && file[0] == '/')
+                return file;
+            if (dir.empty() || dir.back() == '/')
+                return dir + file;
+            return dir + "/" + file;
+        }
+
+        static std::string base_name(std::string const & path) {
+            size_t pos = path.find_last_of('/');
+            std::string file = pos == std::string::npos ? path : path.substr(pos + 1);
+            size_t dot = file.find_last_of('.');
+            return dot == std::string::npos ? file : file.substr(0, dot);
+        }
+
+        //
+        // Workers
+        //
+
+        static bool is_answer(std::string const & line) {
+            return line == "sat" || line == "unsat" || line == "unknown";
+        }
+
+        // move the error messages that the commands print on the regular output to err
+        static std::string split_errors(std::string const & text, std::ostream & err) {
+            std::istringstream in(text);
+            std::string line, out;
+            while (std::getline(in, line)) {
+                if (line.compare(0, 7, "(error ") == 0)
+                    err << line << "\n";
+                else
+                    out += line + "\n";
+            }
+            return out;
+        }
+
+        void solve(unsigned worker, batch_job const & job) {
+            // the manager of ctx is created by the first command that needs it, after
+            // set-logic, and its limit is canceled through this parent
+            reslimit limit;
+            cmd_context ctx;
+            install_smtlib2_commands(ctx);
+            ctx.set_limit_parent(&limit);
+            std::ostringstream out, err;
+            ctx.set_regular_stream(out);
+            ctx.set_diagnostic_stream(err);
+            {
+                lock_guard lock(m_mux);
+                running & r = m_running[worker];
+                r = running();
+                r.m_limit = &limit;
+                r.m_start = batch_clock::now();
+            }
+            mapped_file in;
+            if (!in.open(job.m_file.c_str()))
+                err << "(error \"failed to open file '" << job.m_file << "'\")" << std::endl;
+            else {
+                try {
+                    parse_smt2_commands(ctx, in.begin(), in.end(), params_ref(), job.m_file.c_str());
+                }
+                catch (z3_exception & ex) {
+                    err << "(error \"" << ex.msg() << "\")" << std::endl;
+                }
+            }
+            running r;
+            {
+                lock_guard lock(m_mux);
+                r = m_running[worker];
+                m_running[worker].m_limit = nullptr;
+            }
+            double seconds = std::chrono::duration<double>(batch_clock::now() - r.m_start).count();
+            if (m_timeout > 0 && seconds >= m_timeout)
+                r.m_timeout = true;
+
+            // the verdict of the runner, or the missing answer, is put before what the solver printed
+            std::string text = split_errors(out.str(), err);
+            std::string first = text.substr(0, text.find('\n'));
+            std::string result = first;
+            if (r.m_timeout)
+                result = "timeout";
+            else if (r.m_memout)
+                result = "memoryout";
+            else if (!is_answer(first))
+                result = err.str().empty() ? "unknown" : "error";
+            if (result != first)
+                text = result + "\n" + text;
+            std::ostringstream stats;
+            ctx.set_regular_stream(stats);
+            ctx.display_statistics(true, seconds);
+            text += stats.str();
+            std::ofstream txt(join_path(m_output_dir, job.m_name + ".txt"));
+            txt << text;
+            if (!txt)
+                err << "(error \"failed to write the output of '" << job.m_file << "'\")" << std::endl;
+            if (!err.str().empty()) {
+                std::ofstream errs(join_path(m_output_dir, job.m_name + ".err"));
+                errs << err.str();
+            }
+
+            lock_guard lock(m_mux);
+            unsigned n = ++m_finished;
+            std::cout << "finish [" << n << "/" << m_jobs.size() << "]: " << job.m_path << " " << result
+                      << " time " << seconds << std::endl;
+        }
+
+        void work(unsigned worker) {
+            while (true) {
+                unsigned i = m_next++;
+                if (i >= m_jobs.size())
+                    return;
+                solve(worker, m_jobs[i]);
+            }
+        }
+
+        //
+        // Limits
+        //
+
+        void check_limits() {
+            lock_guard lock(m_mux);
+            batch_clock::time_point now = batch_clock::now();
+            running * oldest = nullptr;
+            bool memout_pending = false;
+            for (running & r : m_running) {
+                if (!r.m_limit)
+                    continue;
+                // the limit is canceled again at every poll, in case a solver resets it
+                if (m_timeout > 0 && now - r.m_start >= std::chrono::seconds(m_timeout)) {
+                    r.m_timeout = true;
+                    r.m_limit->cancel();
+                }
+                if (r.m_memout) {
+                    r.m_limit->cancel();
+                    memout_pending = true;
+                }
+                else if (!r.m_timeout && (!oldest || r.m_start < oldest->m_start))
+                    oldest = &r;
+            }
+            if (m_memory == 0 || memout_pending || !oldest)
+                return;
+            unsigned long long max_size = static_cast<unsigned long long>(m_memory) * 1024 * 1024 * m_num_threads;
+            if (memory::get_allocation_size() > max_size) {
+                oldest->m_memout = true;
+                oldest->m_limit->cancel();
+            }
+        }
+
+    public:
+        batch_runner(char const * output_dir, unsigned num_threads, unsigned timeout, unsigned memory):
+            m_output_dir(output_dir),
+            m_num_threads(num_threads == 0 ? 1 : num_threads),
+            m_timeout(timeout),
+            m_memory(memory),
+            m_next(0),
+            m_finished(0) {}
+
+        bool load(char const * list_file) {
+            std::ifstream in(list_file);
+            if (!in)
+                return false;
+            std::string dir = dir_name(list_file);
+            std::string path;
+            while (in >> path) {
+                batch_job job;
+                job.m_path = path;
+                job.m_file = std::ifstream(path).good() ? path : join_path(dir, path);
+                job.m_name = base_name(path);
+                m_jobs.push_back(job);
+            }
+            return true;
+        }
+
+        void operator()() {
+            m_running.resize(m_num_threads);
+#ifdef SINGLE_THREAD
+            work(0);
+#else
+            std::vector<std::thread> threads;
+            for (unsigned i = 0; i < m_num_threads; ++i)
+                threads.push_back(std::thread([this, i]() { work(i); }));
+            while (m_finished < m_jobs.size()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                check_limits();
+            }
+            for (std::thread & t : threads)
+                t.join();
+#endif
+        }
+    };
+}
+
+unsigned run_smtlib2_batch(char const * list_file, char const * output_dir, unsigned num_threads, unsigned timeout, unsigned memory) {
+    batch_runner runner(output_dir, num_threads, timeout, memory);
+    if (!runner.load(list_file)) {
+        std::cerr << "(error \"failed to open file '" << list_file << "'\")" << std::endl;
+        return ERR_OPEN_FILE;
+    }
+    runner();
+    return 0;
+}
@@ -0,0 +1,28 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    batch_frontend.h
+
+Abstract:
+
+    Solve the SMT-LIB2 files of a list in a single process.
+
+--*/
+#pragma once
+
+/**
+   \brief Solve every SMT-LIB2 file of list_file, one path per line, each in a
+   fresh command context. Relative paths that cannot be opened are resolved
+   against the directory of the list.
+
+   The output and the statistics of an instance are written to
+   output_dir/<name>.txt, where name is the file name without extension, as for
+   a run with -st. The first line is "timeout" or "memoryout" when the instance
+   was stopped by a limit. Errors are written to output_dir/<name>.err.
+
+   num_threads instances are solved at a time. timeout (in seconds) and
+   memory (in megabytes) limit each instance, 0 means no limit.
+*/
+unsigned run_smtlib2_batch(char const * list_file, char const * output_dir, unsigned num_threads, unsigned timeout, unsigned memory);
@@ -39,6 +39,7 @@ Revision History:
 #include "util/file_path.h"
 #include "shell/lp_frontend.h"
 #include "shell/drat_frontend.h"
+#include "shell/batch_frontend.h"
 
 // wzh
 #include <vector>
@@ -57,6 +58,11 @@ static input_kind   g_input_kind          = IN_UNSPECIFIED;
 bool                g_display_statistics  = false;
 bool                g_display_model       = false;
 static bool         g_display_istatistics = false;
+static char const * g_batch_list          = nullptr;
+static char const * g_batch_output        = ".";
+static unsigned     g_batch_threads       = 1;
+static unsigned     g_timeout             = 0;
+static char const * g_memory              = nullptr;
 
 static void error(const char * msg) {
     std::cerr << "Error: " << msg << "\n";
@@ -91,6 +97,10 @@ void display_usage() {
     std::cout << "  -log        use parser for Z3 log input format.\n";
     std::cout << "  -in         read formula from standard input.\n";
     std::cout << "  -model      display model for satisfiable SMT.\n";
+    std::cout << "\nBatch mode:\n";
+    std::cout << "  -batch:list       solve the SMT 2 files of 'list' (one path per line) in this process, -T and -memory are per file.\n";
+    std::cout << "  -batch_out:dir    write the output and statistics of every file to 'dir' (default: current directory).\n";
+    std::cout << "  -batch_threads:n  solve 'n' files at a time (default: 1).\n";
     std::cout << "\nMiscellaneous:\n";
     std::cout << "  -h, -?      prints this message.\n";
     std::cout << "  -version    prints version number of Z3.\n";
@@ -128,7 +138,6 @@ void display_usage() {
 }
    
 static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv) {
-    long timeout = 0;
     int i = 1;
     char * eq_pos = nullptr;
     while (i < argc) {
@@ -232,7 +241,7 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             else if (strcmp(opt_name, "T") == 0) {
                 if (!opt_arg)
                     error("option argument (-T:timeout) is missing.");
-                timeout = strtol(opt_arg, nullptr, 10);
+                g_timeout = strtol(opt_arg, nullptr, 10);
             }
             else if (strcmp(opt_name, "t") == 0) {
                 if (!opt_arg)
@@ -281,7 +290,22 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             else if (strcmp(opt_name, "memory") == 0) {
                 if (!opt_arg)
                     error("option argument (-memory:val) is missing.");
-                gparams::set("memory_max_size", opt_arg);
+                g_memory = opt_arg;
+            }
+            else if (strcmp(opt_name, "batch") == 0) {
+                if (!opt_arg)
+                    error("option argument (-batch:list) is missing.");
+                g_batch_list = opt_arg;
+            }
+            else if (strcmp(opt_name, "batch_out") == 0) {
+                if (!opt_arg)
+                    error("option argument (-batch_out:dir) is missing.");
+                g_batch_output = opt_arg;
+            }
+            else if (strcmp(opt_name, "batch_threads") == 0) {
+                if (!opt_arg)
+                    error("option argument (-batch_threads:n) is missing.");
+                g_batch_threads = strtol(opt_arg, nullptr, 10);
             }
             else if (strcmp(opt_name, "tactics") == 0) {
                 if (!opt_arg)
@@ -317,8 +341,13 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
         i++;
     }
 
-    if (timeout)
-        set_timeout(timeout * 1000);
+    // in batch mode the limits apply to every file
+    if (g_batch_list)
+        return;
+    if (g_memory)
+        gparams::set("memory_max_size", g_memory);
+    if (g_timeout)
+        set_timeout(g_timeout * 1000);
 }
 
 // wzh
@@ -369,6 +398,15 @@ int STD_CALL main(int argc, char ** argv) {
         parse_cmd_line_args(input_file, argc, argv);
         env_params::updt_params();
 
+        if (g_batch_list) {
+            if (g_input_file || g_standard_input)
+                error("an input file cannot be specified in batch mode.");
+            return_value = run_smtlib2_batch(g_batch_list, g_batch_output, g_batch_threads, g_timeout, g_memory ? strtol(g_memory, nullptr, 10) : 0);
+            memory::finalize();
+            clear_trace_tag_vector();
+            return return_value;
+        }
+
         if (g_input_file && g_standard_input) {
             error("using standard input to read formula.");
         }
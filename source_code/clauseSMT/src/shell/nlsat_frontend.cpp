@@ -0,0 +1,71 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_frontend.cpp
+
+Abstract:
+
+    Solve pure polynomial QF_NRA benchmarks directly with nlsat.
+
+    The script is compiled by load_smt2_nlsat, without creating
+    expressions. The resource limit of the command line (rlimit) applies
+    to the solver, and its statistics are displayed when the solver is
+    interrupted by a timeout or Ctrl-C.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include "util/gparams.h"
+#include "util/mutex.h"
+#include "util/rlimit.h"
+#include "util/statistics.h"
+#include "cmd_context/cmd_context.h"
+#include "nlsat/nlsat_solver.h"
+#include "nlsat/tactic/smt2_nlsat.h"
+#include "shell/nlsat_frontend.h"
+
+static mutex *           g_solver_mux = new mutex;
+static nlsat::solver *   g_solver = nullptr;
+
+bool collect_nlsat_statistics(statistics & st) {
+    lock_guard lock(*g_solver_mux);
+    if (!g_solver)
+        return false;
+    g_solver->collect_statistics(st);
+    return true;
+}
+
+bool read_nlsat_smtlib2(cmd_context & ctx, char const * begin, char const * end, statistics & st) {
+    params_ref p = gparams::get_module("nlsat");
+    reslimit lim;
+    nlsat::solver s(lim, p, false);
+    if (!load_smt2_nlsat(ctx, begin, end, s, p))
+        return false;
+    {
+        lock_guard lock(*g_solver_mux);
+        g_solver = &s;
+    }
+    lbool r;
+    try {
+        scoped_rlimit _rlimit(lim, ctx.params().rlimit());
+        r = s.check();
+    }
+    catch (z3_exception & ex) {
+        // an exhausted resource limit is reported as unknown, like in the regular front-end
+        if (lim.inc())
+            std::cerr << "(error \"" << ex.msg() << "\")" << std::endl;
+        r = l_undef;
+    }
+    switch (r) {
+    case l_true:  std::cout << "sat" << std::endl; break;
+    case l_false: std::cout << "unsat" << std::endl; break;
+    default:      std::cout << "unknown" << std::endl; break;
+    }
+    lock_guard lock(*g_solver_mux);
+    s.collect_statistics(st);
+    g_solver = nullptr;
+    return true;
+}
@@ -0,0 +1,34 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_frontend.h
+
+Abstract:
+
+    Load pure polynomial QF_NRA benchmarks directly into nlsat.
+
+--*/
+#pragma once
+
+class cmd_context;
+class statistics;
+
+/**
+   \brief Solve the SMT-LIB2 script in [begin, end) with nlsat when it only
+   declares arithmetic and Boolean constants and asserts Boolean combinations
+   of polynomial constraints, followed by a single check-sat.
+
+   The result is printed and the statistics of nlsat are stored in st.
+   Return false, without printing anything, if the script uses any other
+   construct or is malformed. It must then be processed by the regular
+   front-end. The rlimit of the command context applies to the solver.
+*/
+bool read_nlsat_smtlib2(cmd_context & ctx, char const * begin, char const * end, statistics & st);
+
+/**
+   \brief Store the statistics of the solver of read_nlsat_smtlib2 in st while
+   it is running (on a timeout or Ctrl-C). Return false if no solver is running.
+*/
+bool collect_nlsat_statistics(statistics & st);
@@ -23,6 +23,8 @@ Revision History:
 #include<signal.h>
 #include "util/timeout.h"
 #include "util/mutex.h"
+#include "util/mapped_file.h"
+#include "util/gparams.h"
 #include "parsers/smt2/smt2parser.h"
 #include "muz/fp/dl_cmds.h"
 #include "cmd_context/extra_cmds/dbg_cmds.h"
@@ -31,6 +33,8 @@ Revision History:
 #include "cmd_context/extra_cmds/subpaving_cmds.h"
 #include "smt/smt2_extra_cmds.h"
 #include "smt/smt_solver.h"
+#include "nlsat/nlsat_params.hpp"
+#include "shell/nlsat_frontend.h"
 
 static mutex *display_stats_mux = new mutex;
 
@@ -39,9 +43,22 @@ extern bool g_display_model;
 static clock_t             g_start_time;
 static cmd_context *       g_cmd_context = nullptr;
 
+static void display_nlsat_statistics(statistics & st) {
+    st.update("total time", (static_cast<double>(clock()) - static_cast<double>(g_start_time)) / CLOCKS_PER_SEC);
+    get_memory_statistics(st);
+    st.display_smt2(std::cout);
+}
+
 static void display_statistics() {
     lock_guard lock(*display_stats_mux);
     clock_t end_time = clock();
+    statistics st;
+    if (g_display_statistics && collect_nlsat_statistics(st)) {
+        std::cout.flush();
+        std::cerr.flush();
+        display_nlsat_statistics(st);
+        return;
+    }
     if (g_cmd_context && g_display_statistics) {
         std::cout.flush();
         std::cerr.flush();
@@ -115,12 +132,7 @@ void help_probes() {
         std::cout << "- " << cmd->get_name() << " " << cmd->get_descr() << "\n";
 }
 
-unsigned read_smtlib2_commands(char const * file_name) {
-    g_start_time = clock();
-    register_on_timeout_proc(on_timeout);
-    signal(SIGINT, on_ctrl_c);
-    cmd_context ctx;
-
+void install_smtlib2_commands(cmd_context & ctx) {
     ctx.set_solver_factory(mk_smt_strategic_solver_factory());
     install_dl_cmds(ctx);
     install_dbg_cmds(ctx);
@@ -128,18 +140,36 @@ unsigned read_smtlib2_commands(char const * file_name) {
     install_subpaving_cmds(ctx);
     install_opt_cmds(ctx);
     install_smt2_extra_cmds(ctx);
+}
+
+unsigned read_smtlib2_commands(char const * file_name) {
+    g_start_time = clock();
+    register_on_timeout_proc(on_timeout);
+    signal(SIGINT, on_ctrl_c);
+    cmd_context ctx;
+
+    install_smtlib2_commands(ctx);
 
     g_cmd_context = &ctx;
     signal(SIGINT, on_ctrl_c);
 
     bool result = true;
     if (file_name) {
-        std::ifstream in(file_name);
-        if (in.bad() || in.fail()) {
+        // the file is scanned in place, the istream path is kept for stdin
+        mapped_file in;
+        if (!in.open(file_name)) {
             std::cerr << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
             exit(ERR_OPEN_FILE);
         }
-        result = parse_smt2_commands(ctx, in);
+        statistics st;
+        if (!g_display_model && nlsat_params(gparams::get_module("nlsat")).fast_load() &&
+            read_nlsat_smtlib2(ctx, in.begin(), in.end(), st)) {
+            if (g_display_statistics)
+                display_nlsat_statistics(st);
+            g_cmd_context = nullptr;
+            return 0;
+        }
+        result = parse_smt2_commands(ctx, in.begin(), in.end());
     }
     else {
         result = parse_smt2_commands(ctx, std::cin, true);
@@ -18,8 +18,11 @@ Revision History:
 --*/
 #pragma once
 
+class cmd_context;
+
 unsigned read_smtlib_file(char const * benchmark_file);
 unsigned read_smtlib2_commands(char const * command_file);
+void install_smtlib2_commands(cmd_context & ctx);
 void help_tactics();
 void help_probes();
 void help_tactic(char const* name);
@@ -47,6 +47,9 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_threads       = p.threads();
     m_threads_max_conflicts  = p.threads_max_conflicts();
     m_threads_cube_frequency = p.threads_cube_frequency();
+    m_threads_share = p.threads_share();
+    m_threads_share_max_size = p.threads_share_max_size();
+    m_threads_share_max_glue = p.threads_share_max_glue();
     m_core_validate = p.core_validate();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
@@ -114,6 +117,10 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_threads);
     DISPLAY_PARAM(m_threads_max_conflicts);
     DISPLAY_PARAM(m_threads_cube_frequency);
+    DISPLAY_PARAM(m_threads_share);
+    DISPLAY_PARAM(m_threads_share_max_size);
+    DISPLAY_PARAM(m_threads_share_max_glue);
+    DISPLAY_PARAM(m_threads_per_core);
     DISPLAY_PARAM(m_simplify_clauses);
     DISPLAY_PARAM(m_tick);
     DISPLAY_PARAM(m_display_features);
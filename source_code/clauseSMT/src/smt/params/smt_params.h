@@ -105,6 +105,10 @@ struct smt_params : public preprocessor_params,
     unsigned         m_threads;
     unsigned         m_threads_max_conflicts;
     unsigned         m_threads_cube_frequency;
+    bool             m_threads_share;
+    unsigned         m_threads_share_max_size;
+    unsigned         m_threads_share_max_glue;
+    bool             m_threads_per_core;    // at most one thread per hardware thread; not a parameter, lifted by the tests
     bool             m_simplify_clauses;
     unsigned         m_tick;
     bool             m_display_features;
@@ -260,6 +264,10 @@ struct smt_params : public preprocessor_params,
         m_threads(1),
         m_threads_max_conflicts(UINT_MAX),
         m_threads_cube_frequency(2),
+        m_threads_share(false),
+        m_threads_share_max_size(8),
+        m_threads_share_max_glue(4),
+        m_threads_per_core(true),
         m_simplify_clauses(true),
         m_tick(1000),
         m_display_features(false),
@@ -34,6 +34,9 @@ struct smt_params_helper {
     d.insert("threads", CPK_UINT, "maximal number of parallel threads.", "1","smt");
     d.insert("threads.max_conflicts", CPK_UINT, "maximal number of conflicts between rounds of cubing for parallel SMT", "400","smt");
     d.insert("threads.cube_frequency", CPK_UINT, "frequency for using cubing", "2","smt");
+    d.insert("threads.share", CPK_BOOL, "share units and short learned clauses between the threads at their restarts, instead of synchronizing the threads in rounds", "false","smt");
+    d.insert("threads.share.max_size", CPK_UINT, "maximal size of the learned clauses shared between the threads (threads.share)", "8","smt");
+    d.insert("threads.share.max_glue", CPK_UINT, "maximal number of decision levels (LBD) of the learned clauses shared between the threads (threads.share)", "4","smt");
     d.insert("mbqi", CPK_BOOL, "model based quantifier instantiation (MBQI)", "true","smt");
     d.insert("mbqi.max_cexs", CPK_UINT, "initial maximal number of counterexamples used in MBQI, each counterexample generates a quantifier instantiation", "1","smt");
     d.insert("mbqi.max_cexs_incr", CPK_UINT, "increment for MBQI_MAX_CEXS, the increment is performed after each round of MBQI", "0","smt");
@@ -164,6 +167,9 @@ struct smt_params_helper {
   unsigned threads() const { return p.get_uint("threads", g, 1u); }
   unsigned threads_max_conflicts() const { return p.get_uint("threads.max_conflicts", g, 400u); }
   unsigned threads_cube_frequency() const { return p.get_uint("threads.cube_frequency", g, 2u); }
+  bool threads_share() const { return p.get_bool("threads.share", g, false); }
+  unsigned threads_share_max_size() const { return p.get_uint("threads.share.max_size", g, 8u); }
+  unsigned threads_share_max_glue() const { return p.get_uint("threads.share.max_glue", g, 4u); }
   bool mbqi() const { return p.get_bool("mbqi", g, true); }
   unsigned mbqi_max_cexs() const { return p.get_uint("mbqi.max_cexs", g, 1u); }
   unsigned mbqi_max_cexs_incr() const { return p.get_uint("mbqi.max_cexs_incr", g, 0u); }
@@ -117,9 +117,7 @@ namespace smt {
         return std::min(m_relevancy_lvl, m_fparams.m_relevancy_lvl);
     }
 
-    void context::copy(context& src_ctx, context& dst_ctx, bool override_base) {
-        ast_manager& dst_m = dst_ctx.get_manager();
-        ast_manager& src_m = src_ctx.get_manager();
+    void context::copy_setup(context& src_ctx, context& dst_ctx, bool override_base) {
         src_ctx.pop_to_base_lvl();
 
         if (!override_base && src_ctx.m_base_lvl > 0) {
@@ -127,10 +125,47 @@ namespace smt {
         }
         SASSERT(src_ctx.m_base_lvl == 0 || override_base);
 
-        ast_translation tr(src_m, dst_m, false);
-
         dst_ctx.set_logic(src_ctx.m_setup.get_logic());
         dst_ctx.copy_plugins(src_ctx, dst_ctx);
+        src_ctx.m_asserted_formulas.get_macro_manager().copy_to(dst_ctx.m_asserted_formulas.get_macro_manager());
+    }
+
+    void context::get_copy_formulas(expr_ref_vector& fmls) {
+        SASSERT(!m.proofs_enabled());
+        pop_to_base_lvl();
+        for (unsigned i = 0; i < m_asserted_formulas.get_num_formulas(); ++i) {
+            expr* f = m_asserted_formulas.get_formula(i);
+            if (!m.is_true(f))
+                fmls.push_back(f);
+        }
+        if (!m_setup.already_configured())
+            return;
+        expr_ref fml(m);
+        for (literal lit : m_assigned_literals) {
+            bool_var_data const & d = get_bdata(lit.var());
+            if (d.is_theory_atom() && !m_theories.get_plugin(d.get_theory())->is_safe_to_copy(lit.var())) 
+                continue;
+            literal2expr(lit, fml);
+            if (!m.is_true(fml))
+                fmls.push_back(fml);
+        }
+    }
+
+    void context::copy_formulas(context& src_ctx, expr_ref_vector const& fmls, ast_translation& tr) {
+        for (expr* f : fmls) 
+            m_asserted_formulas.assert_expr(tr(f));
+        if (!src_ctx.m_setup.already_configured()) 
+            return;
+        setup_context(m_fparams.m_auto_config);
+        internalize_assertions();
+    }
+
+    void context::copy(context& src_ctx, context& dst_ctx, bool override_base) {
+        ast_manager& dst_m = dst_ctx.get_manager();
+        ast_manager& src_m = src_ctx.get_manager();
+        copy_setup(src_ctx, dst_ctx, override_base);
+
+        ast_translation tr(src_m, dst_m, false);
 
         asserted_formulas& src_af = src_ctx.m_asserted_formulas;
         asserted_formulas& dst_af = dst_ctx.m_asserted_formulas;
@@ -149,8 +184,6 @@ namespace smt {
             dst_af.assert_expr(fml, pr);
         }
 
-        src_af.get_macro_manager().copy_to(dst_af.get_macro_manager());
-
         if (!src_ctx.m_setup.already_configured()) {
             return;
         }
@@ -3772,6 +3805,11 @@ namespace smt {
             return false;
         }
         inc_limits();
+        if (m_par) {
+            // exchange clauses with the other threads, also when the restart is skipped,
+            // the imported clauses are added once the restart pops to the search level
+            m_par->share(*this);
+        }
         if (status == l_true || !m_fparams.m_restart_adaptive || m_agility < m_fparams.m_restart_agility_threshold) {
             SASSERT(!inconsistent());
             log_stats();
@@ -3782,6 +3820,8 @@ namespace smt {
                 pop_scope(m_scope_lvl - curr_lvl);
                 SASSERT(at_search_level());
             }
+            if (m_par)
+                m_par->import(*this);
             for (theory* th : m_theory_set) 
                 if (!inconsistent()) 
                     th->restart_eh();
@@ -4132,6 +4172,8 @@ namespace smt {
                       static ast_mark visited;
                       ast_ll_pp(tout, m, pr, visited););
             }
+            if (m_par)
+                m_par->export_lemma(*this, num_lits, lits);
             // I invoke pop_scope_core instead of pop_scope because I don't want
             // to reset cached generations... I need them to rebuild the literals
             // of the new conflict clause.
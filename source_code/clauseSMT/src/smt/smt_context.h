@@ -1597,6 +1597,19 @@ namespace smt {
 
         static void copy(context& src, context& dst, bool override_base = false);
 
+        /**
+           \brief Copy in steps, for copies made by other threads. copy_setup and
+           get_copy_formulas run in the thread of src: they copy the theories and
+           macros, and collect the formulas asserted in the copy (the copy of the
+           proofs is not supported). copy_formulas runs in the thread of the copy,
+           with a translation from the manager of src that is frozen meanwhile.
+        */
+        static void copy_setup(context& src, context& dst, bool override_base = false);
+
+        void get_copy_formulas(expr_ref_vector& fmls);
+
+        void copy_formulas(context& src, expr_ref_vector const& fmls, ast_translation& tr);
+
         /**
            \brief Translate context to use new manager m.
          */
@@ -31,18 +31,227 @@ namespace smt {
     lbool parallel::operator()(expr_ref_vector const& asms) {
         return l_undef;
     }
+
+    void parallel::export_lemma(context& pctx, unsigned num_lits, literal const* lits) {
+    }
+
+    void parallel::share(context& pctx) {
+    }
+
+    void parallel::import(context& pctx) {
+    }
 }
 
 #else
 
 #include <thread>
+#include "util/mutex.h"
 
 namespace smt {
+
+    /**
+       \brief State of the clause sharing between the threads (threads.share).
+
+       Every thread records the short clauses it learns, and publishes them at its
+       next restart in its export ring. The clauses of the rings are expressions of
+       the manager of the main context. The manager is not thread safe, so the
+       translations from and to it are done under m_mux, with translators that are
+       kept for the whole run. The number of clauses published in a ring is read
+       without the lock, and a thread that has nothing to publish and nothing new
+       to import does not wait for the others.
+
+       A ring keeps the last ring_size clauses: a thread that imports less often
+       than another one exports skips the oldest clauses of that thread.
+    */
+    struct parallel::sharing {
+        static const unsigned ring_size = 1024;
+
+        struct ring {
+            vector<expr_ref_vector> m_clauses;
+            atomic<unsigned>        m_published { 0 };   // number of clauses published so far
+            ring(ast_manager& m) {
+                for (unsigned i = 0; i < ring_size; ++i)
+                    m_clauses.push_back(expr_ref_vector(m));
+            }
+        };
+
+        struct stats {
+            unsigned m_exported_units;
+            unsigned m_exported_clauses;
+            unsigned m_imported;
+            unsigned m_skipped;
+            unsigned m_dropped;
+            stats() { memset(this, 0, sizeof(*this)); }
+        };
+
+        struct worker {
+            expr_ref_vector             m_lits;        // clauses learned since the last restart
+            unsigned_vector             m_lim;         // end of each clause in m_lits
+            ast_translation             m_to_main;
+            ast_translation             m_from_main;
+            unsigned_vector             m_imported;    // number of clauses imported from the ring of every thread
+            vector<expr_ref_vector>     m_pending;     // imported clauses, added at the next restart
+            stats                       m_stats;
+            worker(ast_manager& pm, ast_manager& m, unsigned num_threads):
+                m_lits(pm), m_to_main(pm, m), m_from_main(m, pm) {
+                m_imported.resize(num_threads, 0);
+            }
+        };
+
+        ast_manager&               m;
+        unsigned                   m_max_size;
+        unsigned                   m_max_glue;
+        mutex                      m_mux;          // protects m, m_units and the clauses of the rings
+        scoped_ptr_vector<ring>    m_rings;
+        scoped_ptr_vector<worker>  m_workers;
+        obj_hashtable<expr>        m_units;
+        expr_ref_vector            m_pinned;
+
+        sharing(ast_manager& m, smt_params const& p, scoped_ptr_vector<ast_manager> const& pms):
+            m(m),
+            m_max_size(p.m_threads_share_max_size),
+            m_max_glue(p.m_threads_share_max_glue),
+            m_pinned(m) {
+            for (ast_manager* pm : pms) {
+                m_rings.push_back(alloc(ring, m));
+                m_workers.push_back(alloc(worker, *pm, m, pms.size()));
+            }
+        }
+
+        void collect_statistics(::statistics& st) {
+            for (worker* w : m_workers) {
+                st.update("threads shared units", w->m_stats.m_exported_units);
+                st.update("threads shared clauses", w->m_stats.m_exported_clauses);
+                st.update("threads imported clauses", w->m_stats.m_imported);
+                st.update("threads skipped clauses", w->m_stats.m_skipped);
+                st.update("threads dropped clauses", w->m_stats.m_dropped);
+                st.update("threads translation hits", w->m_to_main.hit_count() + w->m_from_main.hit_count());
+                st.update("threads translation misses", w->m_to_main.miss_count() + w->m_from_main.miss_count());
+            }
+        }
+    };
+
+    void parallel::export_lemma(context& pctx, unsigned num_lits, literal const* lits) {
+        sharing& s = *m_sharing;
+        if (num_lits > s.m_max_size)
+            return;
+        unsigned glue = 0;
+        for (unsigned i = 0; i < num_lits; ++i) {
+            unsigned lvl = pctx.get_assign_level(lits[i]);
+            unsigned j = 0;
+            for (; j < i && pctx.get_assign_level(lits[j]) != lvl; ++j)
+                ;
+            if (j == i && ++glue > s.m_max_glue)
+                return;
+        }
+        sharing::worker& w = *s.m_workers[pctx.m_par_index];
+        if (w.m_lim.size() >= sharing::ring_size)
+            return;
+        ast_manager& pm = pctx.m;
+        for (unsigned i = 0; i < num_lits; ++i) {
+            expr* e = pctx.bool_var2expr(lits[i].var());
+            w.m_lits.push_back(lits[i].sign() ? pm.mk_not(e) : e);
+        }
+        w.m_lim.push_back(w.m_lits.size());
+    }
+
+    void parallel::share(context& pctx) {
+        sharing& s = *m_sharing;
+        unsigned idx = pctx.m_par_index;
+        sharing::worker& w = *s.m_workers[idx];
+        bool has_new = !w.m_lim.empty();
+        for (unsigned j = 0; !has_new && j < s.m_rings.size(); ++j)
+            has_new = j != idx && s.m_rings[j]->m_published != w.m_imported[j];
+        if (!has_new)
+            return;
+
+        {
+            lock_guard lock(s.m_mux);
+            sharing::ring& out = *s.m_rings[idx];
+            unsigned published = out.m_published;
+            unsigned start = 0;
+            for (unsigned end : w.m_lim) {
+                if (end == start + 1) {
+                    expr_ref u(w.m_to_main(w.m_lits.get(start)), s.m);
+                    if (s.m_units.contains(u)) {
+                        start = end;
+                        continue;
+                    }
+                    s.m_units.insert(u);
+                    s.m_pinned.push_back(u);
+                    w.m_stats.m_exported_units++;
+                }
+                else 
+                    w.m_stats.m_exported_clauses++;
+                expr_ref_vector& cls = out.m_clauses[published % sharing::ring_size];
+                cls.reset();
+                for (; start < end; ++start)
+                    cls.push_back(w.m_to_main(w.m_lits.get(start)));
+                ++published;
+            }
+            out.m_published = published;
+
+            for (unsigned j = 0; j < s.m_rings.size(); ++j) {
+                if (j == idx)
+                    continue;
+                sharing::ring& in = *s.m_rings[j];
+                unsigned first = w.m_imported[j], last = in.m_published;
+                if (last - first > sharing::ring_size) {
+                    w.m_stats.m_dropped += last - first - sharing::ring_size;
+                    first = last - sharing::ring_size;
+                }
+                for (; first < last; ++first) 
+                    w.m_pending.push_back(w.m_from_main(in.m_clauses[first % sharing::ring_size]));
+                w.m_imported[j] = last;
+            }
+        }
+        w.m_lits.reset();
+        w.m_lim.reset();
+    }
+
+    void parallel::import(context& pctx) {
+        SASSERT(pctx.at_search_level());
+        sharing::worker& w = *m_sharing->m_workers[pctx.m_par_index];
+        ast_manager& pm = pctx.m;
+        // only the clauses over atoms known to the thread are added
+        literal_vector lits;
+        for (expr_ref_vector const& cls : w.m_pending) {
+            if (pctx.inconsistent())
+                break;
+            lits.reset();
+            bool ok = true;
+            for (expr* e : cls) {
+                bool sign = pm.is_not(e, e);
+                if (!pctx.b_internalized(e)) {
+                    ok = false;
+                    break;
+                }
+                literal l = pctx.get_literal(e);
+                if (sign)
+                    l.neg();
+                if (l == true_literal) {
+                    ok = false;
+                    break;
+                }
+                if (l != false_literal)
+                    lits.push_back(l);
+            }
+            if (!ok || lits.empty()) {
+                w.m_stats.m_skipped++;
+                continue;
+            }
+            w.m_stats.m_imported++;
+            pctx.mk_clause(lits.size(), lits.data(), nullptr, CLS_TH_LEMMA);
+        }
+        w.m_pending.reset();
+    }
     
     lbool parallel::operator()(expr_ref_vector const& asms) {
 
         lbool result = l_undef;
-        unsigned num_threads = std::min((unsigned) std::thread::hardware_concurrency(), ctx.get_fparams().m_threads);
+        unsigned num_threads = ctx.get_fparams().m_threads;
+        if (ctx.get_fparams().m_threads_per_core)
+            num_threads = std::min((unsigned) std::thread::hardware_concurrency(), num_threads);
         flet<unsigned> _nt(ctx.m_fparams.m_threads, 1);
         unsigned thread_max_conflicts = ctx.get_fparams().m_threads_max_conflicts;
         unsigned max_conflicts = ctx.get_fparams().m_max_conflicts;
@@ -73,23 +282,77 @@ namespace smt {
         unsigned error_code = 0;
         bool done = false;
         unsigned num_rounds = 0;
+        std::mutex mux;
         if (m.has_trace_stream())
             throw default_exception("trace streams have to be off in parallel mode");
 
+        // with clause sharing, the threads run without rounds until one of them finishes
+        bool share = ctx.get_fparams().m_threads_share && !m.proofs_enabled();
+        if (share)
+            thread_max_conflicts = UINT_MAX;
+
         
         for (unsigned i = 0; i < num_threads; ++i) {
             smt_params.push_back(ctx.get_fparams());
         }
+        // The formulas of ctx are collected once, and every thread translates them
+        // in its own manager. The manager of ctx is frozen meanwhile, so the threads
+        // copy concurrently instead of one after the other.
+        bool copy_in_threads = !m.proofs_enabled() && !ctx.m_user_propagator;
+        expr_ref_vector fmls(m);
+        if (copy_in_threads)
+            ctx.get_copy_formulas(fmls);
         for (unsigned i = 0; i < num_threads; ++i) {
             ast_manager* new_m = alloc(ast_manager, m, true);
             pms.push_back(new_m);
             pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params())); 
             context& new_ctx = *pctxs.back();
-            context::copy(ctx, new_ctx, true);
             new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
-            ast_translation tr(m, *new_m);
-            pasms.push_back(tr(asms));
+            pasms.push_back(expr_ref_vector(*new_m));
             sl.push_child(&(new_m->limit()));
+            if (copy_in_threads) {
+                context::copy_setup(ctx, new_ctx, true);
+                continue;
+            }
+            context::copy(ctx, new_ctx, true);
+            ast_translation tr(m, *new_m);
+            pasms.back().append(tr(asms));
+        }
+        if (copy_in_threads) {
+            std::string copy_ex;
+            auto copy_thread = [&](unsigned i) {
+                try {
+                    ast_translation tr(m, *pms[i], false, true);
+                    pctxs[i]->copy_formulas(ctx, fmls, tr);
+                    for (expr* a : asms)
+                        pasms[i].push_back(tr(a));
+                }
+                catch (z3_exception& ex) {
+                    std::lock_guard<std::mutex> lock(mux);
+                    copy_ex = ex.msg();
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(mux);
+                    copy_ex = "unknown exception";
+                }
+            };
+            vector<std::thread> threads(num_threads);
+            for (unsigned i = 0; i < num_threads; ++i) 
+                threads[i] = std::thread([&, i]() { copy_thread(i); });
+            for (auto & th : threads) 
+                th.join();
+            if (!copy_ex.empty())
+                throw default_exception(std::move(copy_ex));
+        }
+
+        scoped_ptr<sharing> shared;
+        if (share) {
+            shared = alloc(sharing, m, ctx.get_fparams(), pms);
+            m_sharing = shared.get();
+            for (unsigned i = 0; i < num_threads; ++i) {
+                pctxs[i]->m_par = this;
+                pctxs[i]->m_par_index = i;
+            }
         }
 
         auto cube = [](context& ctx, expr_ref_vector& lasms, expr_ref& c) {
@@ -139,8 +402,6 @@ namespace smt {
             IF_VERBOSE(1, verbose_stream() << "(smt.thread :units " << sz << ")\n");
         };
 
-        std::mutex mux;
-
         auto worker_thread = [&](int i) {
             try {
                 context& pctx = *pctxs[i];
@@ -233,6 +494,10 @@ namespace smt {
         for (context* c : pctxs) {
             c->collect_statistics(ctx.m_aux_stats);
         }
+        if (shared) {
+            shared->collect_statistics(ctx.m_aux_stats);
+            m_sharing = nullptr;
+        }
 
         if (finished_id == UINT_MAX) {
             switch (ex_kind) {
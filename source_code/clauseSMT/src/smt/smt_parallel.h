@@ -23,12 +23,33 @@ Revision History:
 namespace smt {
 
     class parallel {
+        struct sharing;
         context& ctx;
+        sharing* m_sharing { nullptr };
     public:
         parallel(context& ctx): ctx(ctx) {}
 
         lbool operator()(expr_ref_vector const& asms);
 
+        /**
+           \brief Record a clause learned by the thread pctx, to be shared with
+           the other threads (threads.share). The literals are assigned to false.
+        */
+        void export_lemma(context& pctx, unsigned num_lits, literal const* lits);
+
+        /**
+           \brief Publish the clauses recorded by the thread pctx, and collect the
+           clauses published by the other threads since its last restart.
+        */
+        void share(context& pctx);
+
+        /**
+           \brief Add the clauses collected by share to the thread pctx.
+           It is at its search level, so that the imported units are not undone
+           by the next backtrack.
+        */
+        void import(context& pctx);
+
     };
 
 }
@@ -24,6 +24,7 @@ Notes:
 #include <thread>
 #endif
 #include <vector>
+#include <chrono>
 
 class binary_tactical : public tactic {
 protected:
@@ -1108,6 +1109,121 @@ tactic * annotate_tactic(char const* name, tactic * t) {
     return alloc(annotate_tactical, name, t);
 }
 
+bool stage_history::is_last(goal const & g) const {
+    if (!m_valid || g.size() != m_last.size())
+        return false;
+    for (unsigned i = 0; i < g.size(); ++i)
+        if (g.form(i) != m_last.get(i))
+            return false;
+    return true;
+}
+
+stage_history::~stage_history() {
+    if (m_translation)
+        m_translation->m_source = nullptr;
+    if (m_source)
+        m_source->m_translation = nullptr;
+}
+
+stage_history * stage_history::translate(ast_manager & m) {
+    if (m_translation && &m_translation->m() == &m)
+        return m_translation;
+    if (m_translation)
+        m_translation->m_source = nullptr;
+    m_translation = alloc(stage_history, m, m_name.bare_str());
+    m_translation->m_source = this;
+    return m_translation;
+}
+
+void stage_history::set_last(goal const & g) {
+    m_last.reset();
+    for (unsigned i = 0; i < g.size(); ++i)
+        m_last.push_back(g.form(i));
+    m_valid = true;
+}
+
+class stage_tactical : public unary_tactical {
+    ref<stage_history> m_history;
+    char const *       m_time_key;
+    char const *       m_input_key;
+    char const *       m_output_key;
+    char const *       m_skip_key;
+    double             m_time;        // seconds, summed at a finer resolution than stopwatch
+    unsigned           m_input_size;
+    unsigned           m_output_size;
+    unsigned           m_skipped;
+
+    // statistics keep the key pointers, and symbols are never deallocated
+    static char const * mk_key(symbol const & name, char const * suffix) {
+        std::string key = name.str() + suffix;
+        return symbol(key.c_str()).bare_str();
+    }
+
+public:
+    stage_tactical(stage_history * h, tactic * t):
+        unary_tactical(t),
+        m_history(h),
+        m_time_key(mk_key(h->name(), " stage time")),
+        m_input_key(mk_key(h->name(), " stage input size")),
+        m_output_key(mk_key(h->name(), " stage output size")),
+        m_skip_key(mk_key(h->name(), " stage skipped")),
+        m_time(0),
+        m_input_size(0),
+        m_output_size(0),
+        m_skipped(0) {}
+
+    void operator()(goal_ref const & in, goal_ref_buffer& result) override {
+        if (m_history->is_last(*in)) {
+            IF_VERBOSE(TACTIC_VERBOSITY_LVL, verbose_stream() << "(" << m_history->name() << " skipped)\n";);
+            m_skipped++;
+            result.reset();
+            result.push_back(in.get());
+            return;
+        }
+        unsigned input_size = in->num_exprs();
+        auto start = std::chrono::steady_clock::now();
+        m_t->operator()(in, result);
+        m_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        m_input_size += input_size;
+        if (result.size() == 1) {
+            m_output_size += result[0]->num_exprs();
+            m_history->set_last(*result[0]);
+        }
+        else
+            m_history->reset();
+    }
+
+    void cleanup() override {
+        m_t->cleanup();
+        m_history->reset();
+    }
+
+    void collect_statistics(statistics & st) const override {
+        m_t->collect_statistics(st);
+        st.update(m_time_key, m_time);
+        st.update(m_input_key, m_input_size);
+        st.update(m_output_key, m_output_size);
+        st.update(m_skip_key, m_skipped);
+    }
+
+    void reset_statistics() override {
+        m_t->reset_statistics();
+        m_time = 0;
+        m_input_size = m_output_size = m_skipped = 0;
+    }
+
+    tactic * translate(ast_manager & m) override {
+        tactic * new_t = m_t->translate(m);
+        return alloc(stage_tactical, m_history->translate(m), new_t);
+    }
+
+    char const* name() const override { return "stage"; }
+};
+
+tactic * stage_tactic(stage_history * h, tactic * t) {
+    return alloc(stage_tactical, h, t);
+}
+
 class cond_tactical : public binary_tactical {
     probe_ref m_p;
 public:
@@ -64,6 +64,44 @@ tactic * clean(tactic * t);
 tactic * using_params(tactic * t, params_ref const & p);
 tactic * annotate_tactic(char const* name, tactic * t);
 
+/**
+   \brief Formulas of the goal produced the last time a stage sharing this
+   history ran. Stages share a history when they run the same tactic with the
+   same parameters, see stage_tactic.
+*/
+class stage_history {
+    unsigned        m_ref_count;
+    symbol          m_name;
+    expr_ref_vector m_last;
+    bool            m_valid;
+    stage_history * m_translation; // history of the stages translated last, see translate
+    stage_history * m_source;
+public:
+    stage_history(ast_manager & m, char const * name): m_ref_count(0), m_name(name), m_last(m), m_valid(false), m_translation(nullptr), m_source(nullptr) {}
+    ~stage_history();
+    void inc_ref() { ++m_ref_count; }
+    void dec_ref() { SASSERT(m_ref_count > 0); if (--m_ref_count == 0) dealloc(this); }
+    symbol const & name() const { return m_name; }
+    ast_manager & m() const { return m_last.get_manager(); }
+    bool is_last(goal const & g) const;
+    void set_last(goal const & g);
+    void reset() { m_last.reset(); m_valid = false; }
+    /**
+       \brief History of the stages translated to m. The stages sharing this
+       history share the returned one, as long as no stage is translated to
+       another manager meanwhile.
+    */
+    stage_history * translate(ast_manager & m);
+};
+
+/**
+   \brief Run \c t as a stage of a preprocessing pipeline. The time and the goal
+   sizes before and after the stage are recorded in the statistics, and the goal
+   is returned unchanged when it is the goal produced the last time a stage of the
+   same history ran.
+*/
+tactic * stage_tactic(stage_history * h, tactic * t);
+
 // Create a tactic that fails if the result returned by probe p is true.
 tactic * fail_if(probe * p);
 tactic * fail_if_not(probe * p);
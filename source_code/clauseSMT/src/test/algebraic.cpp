@@ -20,6 +20,7 @@ Notes:
 #include "math/polynomial/polynomial_var2value.h"
 #include "util/mpbq.h"
 #include "util/rlimit.h"
+#include "util/statistics.h"
 
 static void display_anums(std::ostream & out, scoped_anum_vector const & rs) {
     out << "numbers in decimal:\n";
@@ -628,6 +629,56 @@ static void tst_sturm() {
 
 
 
+static ::sign exact_compare(anum_manager & am, anum const & a, anum const & b) {
+    scoped_anum d(am);
+    am.sub(a, b, d);
+    return am.is_zero(d) ? sign_zero : am.is_pos(d) ? sign_pos : sign_neg;
+}
+
+// comparisons decided by the double enclosures agree with the sign of the difference
+static void tst_double_enclosure() {
+    reslimit rl;
+    unsynch_mpq_manager nm;
+    polynomial::manager m(rl, nm);
+    polynomial_ref x(m);
+    x = m.mk_polynomial(m.mk_var());
+    algebraic_numbers::manager am(rl, nm);
+    scoped_anum_vector nums(am), rs(am);
+    polynomial_ref p(m);
+    for (int k = 2; k <= 9; k++) {
+        for (unsigned d = 2; d <= 3; d++) {
+            p = (x^d) - k;
+            rs.reset();
+            am.isolate_roots(p, rs);
+            for (unsigned i = 0; i < rs.size(); i++)
+                nums.push_back(rs[i]);
+        }
+    }
+    // rationals close to the irrational numbers
+    scoped_mpq q(nm);
+    scoped_anum a(am);
+    for (int k = 1; k <= 30; k++) {
+        nm.set(q, 10 * k + 1, 7);
+        am.set(a, q);
+        nums.push_back(a);
+        nm.set(q, -k, 3);
+        am.set(a, q);
+        nums.push_back(a);
+    }
+    am.reset_statistics();
+    for (unsigned i = 0; i < nums.size(); i++)
+        for (unsigned j = 0; j < nums.size(); j++)
+            ENSURE(am.compare(nums[i], nums[j]) == exact_compare(am, nums[i], nums[j]));
+    statistics st;
+    am.collect_statistics(st);
+    st.display(std::cout);
+    unsigned decided = 0;
+    for (unsigned i = 0; i < st.size(); i++)
+        if (st.is_uint(i) && strcmp(st.get_key(i), "algebraic compare double") == 0)
+            decided = st.get_uint_value(i);
+    ENSURE(decided > 0);
+}
+
 void tst_algebraic() {
     tst_sturm();
 
@@ -646,4 +697,5 @@ void tst_algebraic() {
     tst_wilkinson();
     tst1();
     tst_refine_mpbq();
+    tst_double_enclosure();
 }
@@ -9,7 +9,11 @@ Copyright (c) 2015 Microsoft Corporation
 #include "ast/reg_decl_plugins.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "model/model.h"
+#include "ast/rewriter/simplify_cache.h"
+#include "ast/macros/macro_manager.h"
 #include "parsers/smt2/smt2parser.h"
+#include "solver/solver.h"
+#include "util/gparams.h"
 
 
 static expr_ref parse_fml(ast_manager& m, char const* str) {
@@ -34,7 +38,94 @@ static char const* example1 = "(<= (+ (* 1.3 x y) (* 2.3 y y) (* (- 1.1 x x))) 2
 static char const* example2 = "(= (+ 4 3 (- (* 3 x x) (* 5 y)) y) 0)";
 
 
+static unsigned get_stat(simplify_cache const& c, char const* key) {
+    statistics st;
+    c.collect_statistics(st);
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static std::string run_script(char const* script) {
+    cmd_context ctx;
+    ctx.set_solver_factory(mk_smt_strategic_solver_factory());
+    std::ostringstream out;
+    ctx.set_regular_stream(out);
+    ctx.set_diagnostic_stream(out);
+    std::istringstream is(script);
+    parse_smt2_commands(ctx, is);
+    return out.str();
+}
+
+static void tst_shared_cache() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    simplify_cache c(m);
+    scoped_simplify_cache _sc(c);
+    params_ref p;
+    p.set_bool("shared_cache", true);
+    expr_ref fml = parse_fml(m, example1), r1(m), r2(m);
+    // a rewriter with the same configuration reuses the results of the first one
+    th_rewriter rw1(m, p), rw2(m, p);
+    rw1(fml, r1);
+    unsigned inserts = get_stat(c, "rewriter shared cache inserts");
+    ENSURE(inserts > 0 && c.size() == inserts);
+    unsigned hits = get_stat(c, "rewriter shared cache hits");
+    rw2(fml, r2);
+    ENSURE(r1 == r2);
+    ENSURE(get_stat(c, "rewriter shared cache hits") == hits + 1);
+    ENSURE(get_stat(c, "rewriter shared cache inserts") == inserts);
+    // another configuration rewrites the formula again
+    params_ref p2(p);
+    p2.set_bool("som", true);
+    th_rewriter rw3(m, p2);
+    rw3(fml, r2);
+    ENSURE(get_stat(c, "rewriter shared cache inserts") > inserts);
+    // a new macro invalidates the entries
+    arith_util a(m);
+    sort * int_s = a.mk_int();
+    func_decl_ref f(m.mk_func_decl(symbol("f"), int_s, int_s), m);
+    expr_ref x(m.mk_var(0, int_s), m);
+    symbol name("x");
+    quantifier_ref q(m.mk_forall(1, &int_s, &name, m.mk_eq(m.mk_app(f, x.get()), a.mk_add(x, a.mk_int(1)))), m);
+    macro_manager mm(m);
+    VERIFY(mm.insert(f, q, nullptr));
+    ENSURE(c.size() == 0);
+    ENSURE(get_stat(c, "rewriter shared cache invalidations") == 1);
+
+    // check-sat shares the cache between the simplification stages of the tactics, and the
+    // answers follow the definitions of the macros; without rewriter.shared_cache there is
+    // no cache, and no statistics of it
+    char const * script =
+        "(set-logic QF_NRA)\n"
+        "(declare-const x Real)\n(declare-const y Real)\n"
+        "(assert (> (+ (* x x) (* 2 y) 1 2) (* 3 x y)))\n"
+        "(assert (< (+ x (* 2 y) 1 2) 7))\n"
+        "(check-sat)\n(get-info :all-statistics)\n";
+    std::string out = run_script(script);
+    ENSURE(out.find("sat\n") == 0);
+    ENSURE(out.find(":rewriter-shared-cache") == std::string::npos);
+    gparams::set("rewriter.shared_cache", "true");
+    out = run_script(script);
+    ENSURE(out.find("sat\n") == 0);
+    size_t i = out.find(":rewriter-shared-cache-hits");
+    ENSURE(i != std::string::npos && atoi(out.c_str() + out.find_first_of("0123456789", i)) > 0);
+    out = run_script(
+        "(declare-const x Int)\n"
+        "(define-fun f ((a Int)) Int (+ (* 2 a) 1))\n"
+        "(push)\n(define-fun g () Int 1)\n(assert (= (+ (f x) g) (+ 2 (* 2 x))))\n(check-sat)\n(pop)\n"
+        "(push)\n(define-fun g () Int 2)\n(assert (= (+ (f x) g) (+ 2 (* 2 x))))\n(check-sat)\n(pop)\n"
+        "(define-fun-rec h ((a Int)) Int (ite (<= a 0) 0 (+ 1 (h (- a 1)))))\n"
+        "(assert (= (h 3) 3))\n(check-sat)\n");
+    std::cout << out;
+    ENSURE(out == "sat\nunsat\nsat\n");
+    gparams::set("rewriter.shared_cache", "false");
+}
+
 void tst_arith_rewriter() {
+    tst_shared_cache();
+
     ast_manager m;
     reg_decl_plugins(m);
     arith_rewriter ar(m);
@@ -0,0 +1,76 @@
+/*++
+Copyright (c) 2015 Microsoft Corporation
+
+Module Name:
+
+    cmd_context_limit.cpp
+
+Abstract:
+
+    The batch front-end solves every file in its own command context and
+    cancels it through a parent of the limit of its manager. The manager
+    is created after set-logic, which must still be accepted.
+
+--*/
+
+#include "util/rlimit.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "solver/solver.h"
+
+static std::string run_script(cmd_context & ctx, char const * script) {
+    std::ostringstream out;
+    ctx.set_regular_stream(out);
+    std::istringstream is(script);
+    parse_smt2_commands(ctx, is);
+    return out.str();
+}
+
+static std::string run_script(reslimit & limit, char const * script) {
+    cmd_context ctx;
+    ctx.set_solver_factory(mk_smt_strategic_solver_factory());
+    ctx.set_limit_parent(&limit);
+    return run_script(ctx, script);
+}
+
+static char const * batch[][2] = {
+    { "(set-logic QF_NRA)\n"
+      "(declare-const x Real)\n"
+      "(assert (= (* x x) 2.0))\n"
+      "(check-sat)\n", "sat\n" },
+    { "(set-logic QF_NRA)\n"
+      "(declare-const x Real)\n"
+      "(declare-const y Real)\n"
+      "(assert (< (+ (* x x) (* y y)) 0.0))\n"
+      "(check-sat)\n", "unsat\n" },
+    { "(set-logic QF_LRA)\n"
+      "(declare-const x Real)\n"
+      "(assert (and (< x 1.0) (> x 0.0)))\n"
+      "(check-sat)\n", "sat\n" },
+};
+
+void tst_cmd_context_limit() {
+    for (auto const & b : batch) {
+        reslimit limit;
+        std::string out = run_script(limit, b[0]);
+        std::cout << out;
+        ENSURE(out.find("(error") == std::string::npos);
+        ENSURE(out == b[1]);
+    }
+    // the limit of the manager created by set-logic is canceled with its parent,
+    // also when the parent was canceled before
+    for (unsigned canceled = 0; canceled < 2; ++canceled) {
+        reslimit limit;
+        cmd_context ctx;
+        ctx.set_solver_factory(mk_smt_strategic_solver_factory());
+        ctx.set_limit_parent(&limit);
+        if (canceled)
+            limit.cancel();
+        std::string out = run_script(ctx, "(set-logic QF_NRA)\n(declare-const x Real)\n");
+        ENSURE(out.find("(error") == std::string::npos);
+        ENSURE(ctx.has_manager());
+        ENSURE(ctx.m().limit().is_canceled() == (canceled != 0));
+        limit.cancel();
+        ENSURE(ctx.m().limit().is_canceled());
+    }
+}
@@ -215,6 +215,7 @@ int main(int argc, char ** argv) {
     TST(prime_generator);
     TST(permutation);
     TST(nlsat);
+    TST_ARGV(nlsat_replay);
     TST(zstring);
     if (test_all) return 0;
     TST(ext_numeral);
@@ -242,6 +243,9 @@ int main(int argc, char ** argv) {
     TST(quant_solve);
     TST(rcf);
     TST(polynorm);
+    TST(cmd_context_limit);
+    TST(stage_tactic);
+    TST(smt2_nlsat);
     TST(qe_arith);
     TST(expr_substitution);
     TST(sorting_network);
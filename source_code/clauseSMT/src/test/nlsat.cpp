@@ -22,8 +22,18 @@ Notes:
 #include "nlsat/nlsat_solver.h"
 #include "util/util.h"
 #include "nlsat/nlsat_explain.h"
+#include "nlsat/nlsat_local_search.h"
+#include "nlsat/nlsat_trace.h"
+#include "nlsat/nlsat_profile.h"
 #include "math/polynomial/polynomial_cache.h"
 #include "util/rlimit.h"
+#include "ast/reg_decl_plugins.h"
+#include "parsers/smt2/smt2parser.h"
+#include "solver/tactic2solver.h"
+#include "qe/nlqsat.h"
+#include "math/lp/nra_relaxation.h"
+#include <fstream>
+#include <sstream>
 
 nlsat::interval_set_ref tst_interval(nlsat::interval_set_ref const & s1,
                                      nlsat::interval_set_ref const & s2,
@@ -279,7 +289,8 @@ static void tst5() {
     nlsat::assignment           as(am);
     small_object_allocator      allocator;
     nlsat::interval_set_manager ism(am, allocator);
-    nlsat::evaluator            ev(s, as, pm, allocator);
+    nlsat::profiler             prof;
+    nlsat::evaluator            ev(s, as, pm, allocator, prof);
     nlsat::var                  x0, x1;
     x0 = pm.mk_var();
     x1 = pm.mk_var();
@@ -297,10 +308,10 @@ static void tst5() {
     scoped_anum zero(am);
     am.set(zero, 0);
     as.set(0, zero);
-    auto i = ev.infeasible_intervals(a, true, nullptr);
+    auto i = ev.infeasible_intervals(a, true, nullptr, x1);
     std::cout << "1) " << i << "\n";
     as.set(1, zero);
-    auto i2 = ev.infeasible_intervals(a, true, nullptr);
+    auto i2 = ev.infeasible_intervals(a, true, nullptr, x1);
     std::cout << "2) " << i2 << "\n";
 }
 
@@ -789,7 +800,1129 @@ x7 := 1
 
 }
 
+static void tst12() {
+    // a conflict record survives a write/read round trip into a different solver,
+    // also with coefficients and values that do not fit into 64 bits
+    params_ref      ps;
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps, false);
+    anum_manager & am     = s.am();
+    nlsat::pmanager & pm  = s.pm();
+    nlsat::var x = s.mk_var(false);
+    nlsat::var y = s.mk_var(false);
+    nlsat::var z = s.mk_var(false);
+    polynomial_ref _x(pm), _y(pm), _z(pm), p(pm), q(pm);
+    _x = pm.mk_polynomial(x);
+    _y = pm.mk_polynomial(y);
+    _z = pm.mk_polynomial(z);
+    p = _x*_x + _y*_y - 1;
+    q = _z - _x;
+
+    nlsat::assignment as(am);
+    scoped_anum half(am), sqrt2(am);
+    rational h(1, 2);
+    am.set(half, h.to_mpq());
+    polynomial_ref two_x(pm);
+    two_x = _x*_x - 2;
+    am.mk_root(two_x, 2, sqrt2);
+    as.set(x, half);
+    as.set(y, sqrt2);
+    nlsat::var_vector xs;
+    unsigned_vector stages;
+    xs.push_back(x); stages.push_back(1);
+    xs.push_back(y); stages.push_back(3);
+
+    nlsat::scoped_literal_vector core(s), lemma(s);
+    core.push_back(mk_gt(s, p));
+    core.push_back(mk_lt(s, q));
+    lemma.push_back(~mk_eq(s, p));
+
+    rational big = power(rational(2), 100) + rational(3);
+    rational big_value = -big / (power(rational(2), 70) + rational(1));
+    polynomial_ref big_c(pm), big_p(pm);
+    big_c = pm.mk_const(big);
+    big_p = big_c * _z - 1;
+    nlsat::assignment big_as(am);
+    scoped_anum big_v(am);
+    am.set(big_v, big_value.to_mpq());
+    big_as.set(z, big_v);
+    nlsat::var_vector big_xs;
+    unsigned_vector big_stages;
+    big_xs.push_back(z); big_stages.push_back(1);
+    nlsat::literal big_lit = mk_gt(s, big_p);
+
+    std::stringstream strm;
+    {
+        nlsat::trace_writer w(s, strm);
+        w.conflict(as, xs, stages, core.size(), core.data(), lemma.size(), lemma.data());
+        w.conflict(as, xs, stages, 1, core.data(), 0, nullptr);
+        w.conflict(big_as, big_xs, big_stages, 1, &big_lit, 0, nullptr);
+        ENSURE(w.num_conflicts() == 3);
+        ENSURE(w.num_polynomials() == 3);
+    }
+
+    nlsat::solver s2(rlim, ps, false);
+    nlsat::trace_reader r(s2, strm);
+    nlsat::trace_conflict c(s2);
+    ENSURE(r.next(c));
+    ENSURE(s2.num_vars() == 3);
+    ENSURE(c.m_vars.size() == 2 && c.m_stages[1] == 3);
+    rational v;
+    s2.am().to_rational(c.m_values[0], v);
+    ENSURE(v == h);
+    ENSURE(!s2.am().is_rational(c.m_values[1]));
+    scoped_anum sqrt2_2(s2.am());
+    polynomial_ref two_x2(s2.pm());
+    two_x2 = s2.pm().mk_polynomial(x);
+    two_x2 = two_x2*two_x2 - 2;
+    s2.am().mk_root(two_x2, 2, sqrt2_2);
+    ENSURE(s2.am().eq(c.m_values[1], sqrt2_2));
+    ENSURE(c.m_core.size() == 2 && c.m_lemma.size() == 1);
+    nlsat::atom * a = s2.bool_var2atom(c.m_core[0].var());
+    ENSURE(a && a->get_kind() == nlsat::atom::GT && !c.m_core[0].sign());
+    ENSURE(c.m_lemma[0].sign());
+    ENSURE(r.next(c));
+    ENSURE(c.m_core.size() == 1 && c.m_lemma.empty());
+    ENSURE(r.next(c));
+    ENSURE(c.m_vars.size() == 1 && c.m_vars[0] == z);
+    s2.am().to_rational(c.m_values[0], v);
+    ENSURE(v == big_value);
+    a = s2.bool_var2atom(c.m_core[0].var());
+    ENSURE(a && a->is_ineq_atom() && nlsat::to_ineq_atom(a)->size() == 1);
+    polynomial_ref big_c2(s2.pm()), _z2(s2.pm()), big_p2(s2.pm());
+    big_c2 = s2.pm().mk_const(big);
+    _z2 = s2.pm().mk_polynomial(z);
+    big_p2 = big_c2 * _z2 - 1;
+    ENSURE(s2.pm().eq(nlsat::to_ineq_atom(a)->p(0), big_p2));
+    ENSURE(!r.next(c));
+}
+
+static unsigned get_stat(statistics const& st, char const* key) {
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            return st.get_uint_value(i);
+    return 0;
+}
+
+static unsigned get_stat(nlsat::solver& s, char const* key) {
+    statistics st;
+    s.collect_statistics(st);
+    return get_stat(st, key);
+}
+
+static void tst13() {
+    // the bounds derived by interval propagation are added once over repeated checks
+    params_ref      ps;
+    ps.set_bool("icp", true);
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps, true);
+    nlsat::pmanager & pm  = s.pm();
+    nlsat::var x = s.mk_var(false);
+    nlsat::var y = s.mk_var(false);
+    polynomial_ref _x(pm), _y(pm), p(pm);
+    _x = pm.mk_polynomial(x);
+    _y = pm.mk_polynomial(y);
+    nlsat::literal lits[1];
+    p = _x - 1;
+    lits[0] = mk_gt(s, p);
+    s.mk_clause(1, lits, nullptr);
+    p = _y - 2*_x;
+    lits[0] = mk_gt(s, p);
+    s.mk_clause(1, lits, nullptr);
+    p = _x*_y - 1;
+    lits[0] = mk_lt(s, p);
+    nlsat::literal lits2[2] = { lits[0], mk_gt(s, _x*_x - 4) };
+    s.mk_clause(2, lits2, nullptr);
+
+    ENSURE(s.check() == l_true);
+    unsigned bounds = get_stat(s, "nlsat icp bounds");
+    std::cout << "icp bounds: " << bounds << "\n";
+    ENSURE(bounds > 0);
+    ENSURE(s.check() == l_true);
+    ENSURE(get_stat(s, "nlsat icp bounds") == bounds);
+    ENSURE(s.check() == l_true);
+    ENSURE(get_stat(s, "nlsat icp bounds") == bounds);
+}
+
+// the bound of x is a derived unit clause when its atom exists before it is made here,
+// and the input of the icp tests has no other atom over x alone
+static bool has_icp_bound(nlsat::literal l, unsigned num_atoms) {
+    return l.var() < num_atoms;
+}
+
+static void tst13_bounds() {
+    // the value and the strictness of the derived bounds: x > 1, y > 2x give y > 2,
+    // and x >= 1, y >= 2x give y >= 2
+    for (bool strict : { true, false }) {
+        params_ref      ps;
+        ps.set_bool("icp", true);
+        reslimit        rlim;
+        nlsat::solver s(rlim, ps, false);
+        nlsat::pmanager & pm  = s.pm();
+        nlsat::var x = s.mk_var(false);
+        nlsat::var y = s.mk_var(false);
+        polynomial_ref _x(pm), _y(pm), p(pm);
+        _x = pm.mk_polynomial(x);
+        _y = pm.mk_polynomial(y);
+        nlsat::literal lits[1];
+        p = _x - 1;
+        lits[0] = strict ? mk_gt(s, p) : ~mk_lt(s, p);
+        s.mk_clause(1, lits, nullptr);
+        p = _y - 2*_x;
+        lits[0] = strict ? mk_gt(s, p) : ~mk_lt(s, p);
+        s.mk_clause(1, lits, nullptr);
+        ENSURE(s.check() == l_true);
+        ENSURE(get_stat(s, "nlsat icp bounds") == 1);
+        unsigned n = s.get_atoms().size();
+        p = _y - 2;
+        ENSURE(has_icp_bound(mk_gt(s, p), n) == strict);
+        ENSURE(has_icp_bound(mk_lt(s, p), n) == !strict);
+    }
+
+    // the bounds of an integer variable are rounded: x > 2y, y > 1/3 give x > 2/3, that is
+    // x >= 1, and x > y, y > 1 give x > 1, that is x >= 2
+    for (bool fractional : { true, false }) {
+        params_ref      ps;
+        ps.set_bool("icp", true);
+        reslimit        rlim;
+        nlsat::solver s(rlim, ps, false);
+        nlsat::pmanager & pm  = s.pm();
+        nlsat::var x = s.mk_var(true);
+        nlsat::var y = s.mk_var(false);
+        polynomial_ref _x(pm), _y(pm), p(pm);
+        _x = pm.mk_polynomial(x);
+        _y = pm.mk_polynomial(y);
+        nlsat::literal lits[1];
+        p = fractional ? 3*_y - 1 : _y - 1;
+        lits[0] = mk_gt(s, p);
+        s.mk_clause(1, lits, nullptr);
+        p = fractional ? _x - 2*_y : _x - _y;
+        lits[0] = mk_gt(s, p);
+        s.mk_clause(1, lits, nullptr);
+        ENSURE(s.check() == l_true);
+        ENSURE(get_stat(s, "nlsat icp bounds") == 1);
+        unsigned n = s.get_atoms().size();
+        p = fractional ? _x - 1 : _x - 2;
+        // x >= k is the negation of x < k
+        ENSURE(has_icp_bound(mk_lt(s, p), n));
+        ENSURE(!has_icp_bound(mk_gt(s, p), n));
+        p = fractional ? 3*_x - 2 : _x - 1;
+        ENSURE(!has_icp_bound(mk_gt(s, p), n));
+    }
+
+    // disjoint bounds: x > 1, y > x give y > 1, which contradicts y < -1, and the
+    // conflict is added as the clause (false) before the search
+    for (bool icp : { false, true }) {
+        params_ref      ps;
+        ps.set_bool("icp", icp);
+        reslimit        rlim;
+        nlsat::solver s(rlim, ps, false);
+        nlsat::pmanager & pm  = s.pm();
+        nlsat::var x = s.mk_var(false);
+        nlsat::var y = s.mk_var(false);
+        polynomial_ref _x(pm), _y(pm), p(pm);
+        _x = pm.mk_polynomial(x);
+        _y = pm.mk_polynomial(y);
+        nlsat::literal lits[1];
+        p = _x - 1;
+        lits[0] = mk_gt(s, p);
+        s.mk_clause(1, lits, nullptr);
+        p = _y - _x;
+        lits[0] = mk_gt(s, p);
+        s.mk_clause(1, lits, nullptr);
+        p = _y + 1;
+        lits[0] = mk_lt(s, p);
+        s.mk_clause(1, lits, nullptr);
+        ENSURE(s.check() == l_false);
+        std::cout << "icp " << icp << " bounds: " << get_stat(s, "nlsat icp bounds") << " conflicts: " << get_stat(s, "nlsat conflicts") << "\n";
+        // the one clause of the propagation is (false), not the bound y > 1
+        ENSURE(get_stat(s, "nlsat icp bounds") == (icp ? 1u : 0u));
+        unsigned n = s.get_atoms().size();
+        p = _y - 1;
+        ENSURE(!has_icp_bound(mk_gt(s, p), n));
+        // the search stops at the clause (false), its only conflict
+        ENSURE(icp ? get_stat(s, "nlsat conflicts") == 1 : get_stat(s, "nlsat conflicts") > 1);
+    }
+}
+
+static void tst14() {
+    // preprocessing: subsumption, elimination of unconstrained and defined variables, and model patching
+    params_ref      ps;
+    ps.set_bool("simplify", true);
+    reslimit        rlim;
+    {
+        // x - 1 > 0 subsumes x - 1 > 0 or y > 0, and simplifies x - 1 < 0 or y > 0 to y > 0
+        nlsat::solver s(rlim, ps, false);
+        nlsat::pmanager & pm  = s.pm();
+        nlsat::var x = s.mk_var(false);
+        nlsat::var y = s.mk_var(false);
+        polynomial_ref _x(pm), _y(pm), p(pm);
+        _x = pm.mk_polynomial(x);
+        _y = pm.mk_polynomial(y);
+        p = _x - 1;
+        nlsat::literal l1 = mk_gt(s, p), l2 = mk_lt(s, p), l3 = mk_gt(s, _y);
+        nlsat::literal c1[1] = { l1 }, c2[2] = { l1, l3 }, c3[2] = { l2, l3 };
+        s.mk_clause(1, c1, nullptr);
+        s.mk_clause(2, c2, nullptr);
+        s.mk_clause(2, c3, nullptr);
+        ENSURE(s.check() == l_true);
+        ENSURE(get_stat(s, "nlsat simplifications") >= 2);
+        ENSURE(s.am().is_pos(s.value(y)));
+    }
+    {
+        // y - 2x - 1 = 0 defines y, which is replaced in x y - 10 > 0 and y - 5 < 0,
+        // and patched back into the model
+        nlsat::solver s(rlim, ps, false);
+        anum_manager & am     = s.am();
+        nlsat::pmanager & pm  = s.pm();
+        nlsat::var x = s.mk_var(false);
+        nlsat::var y = s.mk_var(false);
+        polynomial_ref _x(pm), _y(pm), p(pm);
+        _x = pm.mk_polynomial(x);
+        _y = pm.mk_polynomial(y);
+        p = _y - 2*_x - 1;
+        nlsat::literal c[1] = { mk_eq(s, p) };
+        s.mk_clause(1, c, nullptr);
+        p = _x*_y - 10;
+        c[0] = mk_gt(s, p);
+        s.mk_clause(1, c, nullptr);
+        p = _y - 5;
+        c[0] = mk_lt(s, p);
+        s.mk_clause(1, c, nullptr);
+        ENSURE(s.check() == l_true);
+        ENSURE(get_stat(s, "nlsat simplifications") >= 1);
+        scoped_anum v(am), two(am), one(am), five(am), ten(am);
+        am.set(two, 2);
+        am.set(one, 1);
+        am.set(five, 5);
+        am.set(ten, 10);
+        am.mul(two, s.value(x), v);
+        am.add(v, one, v);
+        ENSURE(am.eq(v, s.value(y)));
+        am.mul(s.value(x), s.value(y), v);
+        ENSURE(am.gt(v, ten));
+        ENSURE(am.lt(s.value(y), five));
+    }
+    {
+        // z only occurs in z - x^2 = 0 or x - 5 > 0, the clause is removed and z := x^2
+        nlsat::solver s(rlim, ps, false);
+        anum_manager & am     = s.am();
+        nlsat::pmanager & pm  = s.pm();
+        nlsat::var x = s.mk_var(false);
+        nlsat::var z = s.mk_var(false);
+        polynomial_ref _x(pm), _z(pm), p(pm);
+        _x = pm.mk_polynomial(x);
+        _z = pm.mk_polynomial(z);
+        p = _x - 1;
+        nlsat::literal c1[1] = { mk_gt(s, p) };
+        s.mk_clause(1, c1, nullptr);
+        p = _z - _x*_x;
+        nlsat::literal l = mk_eq(s, p);
+        p = _x - 5;
+        nlsat::literal c2[2] = { l, mk_gt(s, p) };
+        s.mk_clause(2, c2, nullptr);
+        ENSURE(s.check() == l_true);
+        ENSURE(get_stat(s, "nlsat simplifications") >= 1);
+        scoped_anum v(am);
+        am.mul(s.value(x), s.value(x), v);
+        ENSURE(am.eq(v, s.value(z)));
+    }
+    {
+        // without variable elimination (incremental mode) the learned clauses are kept
+        nlsat::solver s(rlim, ps, true);
+        nlsat::pmanager & pm  = s.pm();
+        nlsat::var x = s.mk_var(false);
+        nlsat::var y = s.mk_var(false);
+        polynomial_ref _x(pm), _y(pm), p(pm);
+        _x = pm.mk_polynomial(x);
+        _y = pm.mk_polynomial(y);
+        p = _x*_x + _y*_y - 1;
+        nlsat::literal c[1] = { mk_lt(s, p) };
+        s.mk_clause(1, c, nullptr);
+        p = _x*_y - 1;
+        c[0] = mk_gt(s, p);
+        s.mk_clause(1, c, nullptr);
+        ENSURE(s.check() == l_false);
+        unsigned learned = s.num_learned_clauses();
+        std::cout << "learned: " << learned << "\n";
+        ENSURE(learned > 0);
+        ENSURE(s.check() == l_false);
+        ENSURE(s.num_learned_clauses() >= learned);
+    }
+}
+
+static void tst15() {
+    // repeated checks under assumptions, like the rounds of nlqsat:
+    // b <-> y^3 - x = 0 is satisfiable under b and under not b
+    params_ref      ps;
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps, true);
+    nlsat::pmanager & pm  = s.pm();
+    nlsat::var x = s.mk_var(false);
+    nlsat::var y = s.mk_var(false);
+    nlsat::bool_var b = s.mk_bool_var();
+    polynomial_ref _x(pm), _y(pm), p(pm);
+    _x = pm.mk_polynomial(x);
+    _y = pm.mk_polynomial(y);
+    p = (_y^3) - _x;
+    nlsat::literal e = mk_eq(s, p);
+    nlsat::literal c1[2] = { nlsat::literal(b, false), ~e };
+    nlsat::literal c2[2] = { nlsat::literal(b, true), e };
+    s.mk_clause(2, c1, nullptr);
+    s.mk_clause(2, c2, nullptr);
+    ENSURE(s.check() == l_true);
+    for (unsigned i = 0; i < 4; ++i) {
+        nlsat::literal_vector asms;
+        asms.push_back(nlsat::literal(b, i % 2 == 0));
+        lbool r = s.check(asms);
+        std::cout << "check " << i << ": " << r << "\n";
+        ENSURE(r == l_true);
+    }
+}
+
+static nlsat::bool_var mk_atom(nlsat::solver& s, nlsat::atom::kind k, nlsat::poly* p) {
+    nlsat::poly * _p[1] = { p };
+    bool is_even[1] = { false };
+    return s.mk_ineq_atom(k, 1, _p, is_even);
+}
+
+static unsigned family(nlsat::solver& s, nlsat::bool_var b) {
+    return nlsat::to_ineq_atom(s.bool_var2atom(b))->family();
+}
+
+static void tst17() {
+    // atoms over the same polynomial up to a positive content or the sign are merged,
+    // and the atoms p < 0, p = 0, p > 0 are in the same family
+    for (bool family_clauses : { false, true }) {
+        params_ref      ps;
+        ps.set_bool("family_clauses", family_clauses);
+        reslimit        rlim;
+        nlsat::solver s(rlim, ps, false);
+        nlsat::pmanager & pm  = s.pm();
+        nlsat::var x = s.mk_var(false);
+        nlsat::var y = s.mk_var(false);
+        polynomial_ref _x(pm), _y(pm), p(pm), q(pm);
+        _x = pm.mk_polynomial(x);
+        _y = pm.mk_polynomial(y);
+        p = _x - _y;
+        nlsat::bool_var b1 = mk_atom(s, nlsat::atom::GT, p);
+        p = 2*_x - 2*_y;
+        nlsat::bool_var b2 = mk_atom(s, nlsat::atom::GT, p);
+        p = _y - _x;
+        nlsat::bool_var b3 = mk_atom(s, nlsat::atom::LT, p);
+        ENSURE(b1 == b2 && b2 == b3);
+        ENSURE(get_stat(s, "nlsat atoms merged") == 1);
+        q = _x*_y - 1;
+        nlsat::bool_var lt = mk_atom(s, nlsat::atom::LT, q);
+        nlsat::bool_var eq = mk_atom(s, nlsat::atom::EQ, q);
+        nlsat::bool_var gt = mk_atom(s, nlsat::atom::GT, q);
+        ENSURE(family(s, lt) == family(s, eq) && family(s, eq) == family(s, gt));
+        ENSURE(family(s, lt) != family(s, b1));
+        nlsat::literal c1[3] = { nlsat::literal(lt, false), nlsat::literal(eq, false), nlsat::literal(gt, false) };
+        nlsat::literal c2[1] = { nlsat::literal(b1, false) };
+        s.mk_clause(3, c1, nullptr);
+        s.mk_clause(1, c2, nullptr);
+        ENSURE(s.check() == l_true);
+        // one binary clause for each pair of p < 0, p = 0, p > 0
+        unsigned added = get_stat(s, "nlsat family clauses");
+        std::cout << "family clauses: " << added << "\n";
+        ENSURE(added == (family_clauses ? 3u : 0u));
+    }
+}
+
+// closed interval [l, u], an infinite end is given by a zero denominator
+static nlsat::interval_set * mk_closed(nlsat::interval_set_manager & ism, anum_manager & am, int ln, int ld, int un, int ud, unsigned b) {
+    scoped_anum l(am), u(am);
+    scoped_mpq q(am.qm());
+    if (ld != 0) {
+        am.qm().set(q, ln, ld);
+        am.set(l, q);
+    }
+    if (ud != 0) {
+        am.qm().set(q, un, ud);
+        am.set(u, q);
+    }
+    return ism.mk(ld == 0, ld == 0, l, ud == 0, ud == 0, u, nlsat::literal(b, false), nullptr);
+}
+
+static void check_simplest(nlsat::interval_set_manager & ism, anum_manager & am, nlsat::interval_set_ref const & s, bool is_int, int n, int d) {
+    scoped_anum w(am), expected(am);
+    scoped_mpq q(am.qm());
+    am.qm().set(q, n, d);
+    am.set(expected, q);
+    ism.peek_simplest_in_complement(s, is_int, w);
+    std::cout << s << (is_int ? " int" : "") << ": " << w << "\n";
+    ENSURE(am.eq(w, expected));
+}
+
+static void tst19() {
+    // the simplest rational (smallest denominator, then bit-size) in the complement
+    reslimit rl;
+    unsynch_mpq_manager         qm;
+    anum_manager                am(rl, qm);
+    small_object_allocator      allocator;
+    nlsat::interval_set_manager ism(am, allocator);
+    nlsat::interval_set_ref s(ism), t(ism);
+    s = nullptr;
+    check_simplest(ism, am, s, false, 0, 1);
+    // (1/3, 1/2)
+    s = mk_closed(ism, am, 0, 0, 1, 3, 1);
+    t = mk_closed(ism, am, 1, 2, 0, 0, 2);
+    s = ism.mk_union(s, t);
+    check_simplest(ism, am, s, false, 2, 5);
+    check_simplest(ism, am, s, true, 2, 5);
+    // (-7/3, -2)
+    s = mk_closed(ism, am, 0, 0, -7, 3, 1);
+    t = mk_closed(ism, am, -2, 1, 0, 0, 2);
+    s = ism.mk_union(s, t);
+    check_simplest(ism, am, s, false, -9, 4);
+    // (0, 1/100) and (10, 200): 11 has fewer bits than 1/101
+    s = mk_closed(ism, am, 0, 0, 0, 1, 1);
+    t = mk_closed(ism, am, 1, 100, 10, 1, 2);
+    s = ism.mk_union(s, t);
+    t = mk_closed(ism, am, 200, 1, 0, 0, 3);
+    s = ism.mk_union(s, t);
+    check_simplest(ism, am, s, false, 11, 1);
+    // (1/3, 1/2) and (100, 200): an integer is preferred for an integer variable
+    s = mk_closed(ism, am, 0, 0, 1, 3, 1);
+    t = mk_closed(ism, am, 1, 2, 100, 1, 2);
+    s = ism.mk_union(s, t);
+    t = mk_closed(ism, am, 200, 1, 0, 0, 3);
+    s = ism.mk_union(s, t);
+    check_simplest(ism, am, s, false, 2, 5);
+    check_simplest(ism, am, s, true, 101, 1);
+    // only the point 3/2 is feasible
+    scoped_anum p(am);
+    scoped_mpq q(qm);
+    qm.set(q, 3, 2);
+    am.set(p, q);
+    s = ism.mk(true, true, p, true, false, p, nlsat::literal(1, false), nullptr);
+    t = ism.mk(true, false, p, true, true, p, nlsat::literal(2, false), nullptr);
+    s = ism.mk_union(s, t);
+    check_simplest(ism, am, s, false, 3, 2);
+}
+
+static void tst21() {
+    // the cell-jump local search finds a rational model of a satisfiable problem,
+    // and stops at the flip budget on an unsatisfiable one
+    params_ref      ps;
+    ps.set_uint("local_search.max_flips", 2000);
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps, false);
+    anum_manager & am = s.am();
+    nlsat::pmanager & pm = s.pm();
+    nlsat::var x = s.mk_var(false);
+    nlsat::var y = s.mk_var(false);
+    nlsat::bool_var b = s.mk_bool_var();
+    polynomial_ref _x(pm), _y(pm);
+    _x = pm.mk_polynomial(x);
+    _y = pm.mk_polynomial(y);
+    nlsat::clause_vector clauses;
+    auto add = [&](nlsat::literal l1, nlsat::literal l2) {
+        nlsat::literal ls[2] = { l1, l2 };
+        clauses.push_back(s.mk_clause(l2 == nlsat::null_literal ? 1 : 2, ls, false, nullptr));
+    };
+    // x y > 1, x^2 + y^2 < 9, (b or x < 0), (not b or y - x > 1)
+    add(mk_gt(s, _x*_y - 1), nlsat::null_literal);
+    add(mk_lt(s, (_x^2) + (_y^2) - 9), nlsat::null_literal);
+    add(nlsat::literal(b, false), mk_lt(s, _x));
+    add(nlsat::literal(b, true), mk_gt(s, _y - _x - 1));
+    {
+        nlsat::local_search ls(s, s.get_atoms(), clauses, ps);
+        ENSURE(ls() == l_true);
+        ENSURE(ls.is_sat());
+        vector<rational> values;
+        svector<lbool> bvalues;
+        VERIFY(ls.get_best(values, bvalues));
+        std::cout << "local search model: x = " << values[x] << ", y = " << values[y] << ", b = " << bvalues.get(b, l_undef) << "\n";
+        nlsat::assignment as(am);
+        scoped_anum v(am);
+        for (nlsat::var z : { x, y }) {
+            am.set(v, values[z].to_mpq());
+            as.set(z, v);
+        }
+        s.set_rvalues(as);
+        for (nlsat::clause * c : clauses) {
+            bool sat = false;
+            for (nlsat::literal l : *c) {
+                nlsat::atom * a = s.bool_var2atom(l.var());
+                sat |= a ? s.get_evaluator().eval(a, l.sign()) : bvalues.get(l.var(), l_undef) == (l.sign() ? l_false : l_true);
+            }
+            ENSURE(sat);
+        }
+    }
+    // x y > 1 and x^2 + y^2 < 1 is unsatisfiable
+    add(mk_lt(s, (_x^2) + (_y^2) - 1), nlsat::null_literal);
+    {
+        nlsat::local_search ls(s, s.get_atoms(), clauses, ps);
+        ENSURE(ls() == l_undef);
+        ENSURE(!ls.is_sat());
+        statistics st;
+        ls.collect_statistics(st);
+        ENSURE(get_stat(st, "nlsat local search flips") == 2000);
+    }
+    // the local search runs next to the search of the solver
+    for (bool unsat : { false, true }) {
+        params_ref p2;
+        p2.set_bool("local_search", true);
+        nlsat::solver s2(rlim, p2, false);
+        nlsat::pmanager & pm2 = s2.pm();
+        polynomial_ref x2(pm2), y2(pm2);
+        x2 = pm2.mk_polynomial(s2.mk_var(false));
+        y2 = pm2.mk_polynomial(s2.mk_var(false));
+        nlsat::literal l1 = mk_gt(s2, x2*y2 - 1), l2 = mk_lt(s2, (x2^2) + (y2^2) - (unsat ? 1 : 9));
+        s2.mk_clause(1, &l1, nullptr);
+        s2.mk_clause(1, &l2, nullptr);
+        ENSURE(s2.check() == (unsat ? l_false : l_true));
+    }
+}
+
+static unsigned isolate_roots_calls(nlsat::profiler const& prof) {
+    statistics st;
+    prof.collect_statistics(st);
+    return get_stat(st, "nlsat calls isolate roots");
+}
+
+static void tst20() {
+    // the literals of a clause share one sign table: the roots of a polynomial occurring in
+    // several literals are isolated once, and the infeasible sets are unchanged
+    params_ref      ps;
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps, false);
+    anum_manager & am = s.am();
+    nlsat::pmanager & pm = s.pm();
+    nlsat::assignment           as(am);
+    small_object_allocator      allocator;
+    nlsat::profiler             prof;
+    nlsat::evaluator            ev(s, as, pm, allocator, prof);
+    nlsat::interval_set_manager & ism = ev.ism();
+    nlsat::var x0 = s.mk_var(false);
+    nlsat::var x1 = s.mk_var(false);
+    polynomial_ref _x0(pm), _x1(pm), p(pm), q(pm);
+    _x0 = pm.mk_polynomial(x0);
+    _x1 = pm.mk_polynomial(x1);
+    p = (_x1^2) - _x0;
+    q = _x1 - 2*_x0;
+    scoped_anum two(am);
+    am.set(two, 2);
+    as.set(x0, two);
+    nlsat::literal lits[4] = { mk_gt(s, p), ~mk_eq(s, p), mk_eq(s, q), mk_lt(s, p) };
+    sbuffer<nlsat::interval_set*> sets;
+    unsigned before = isolate_roots_calls(prof);
+    ev.start_clause(x1);
+    for (nlsat::literal l : lits) {
+        nlsat::interval_set_ref r = ev.clause_infeasible_intervals(s.bool_var2atom(l.var()), l.sign(), nullptr);
+        ism.inc_ref(r);
+        sets.push_back(r);
+    }
+    unsigned calls = isolate_roots_calls(prof) - before;
+    std::cout << "isolate roots: " << calls << "\n";
+    ENSURE(calls == 2);
+    for (unsigned i = 0; i < 4; ++i) {
+        nlsat::interval_set_ref r = ev.infeasible_intervals(s.bool_var2atom(lits[i].var()), lits[i].sign(), nullptr, x1);
+        ism.display(std::cout, sets[i]) << " " << r << "\n";
+        ENSURE(ism.set_eq(sets[i], r));
+        ism.dec_ref(sets[i]);
+    }
+}
+
+static void check_core(nlsat::solver& s, unsigned n, nlsat::literal const* lits, unsigned m, nlsat::literal const* expected) {
+    nlsat::scoped_literal_vector core(s);
+    s.get_explain().minimize(n, lits, core);
+    s.display(std::cout << "core: ", core.size(), core.data()) << "\n";
+    ENSURE(core.size() == m);
+    for (unsigned i = 0; i < core.size(); ++i)
+        ENSURE(core[i] == expected[i]);
+}
+
+static void tst18() {
+    // QuickXplain keeps a minimal subset of the literals whose infeasible intervals cover the line
+    params_ref      ps;
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps, false);
+    nlsat::pmanager & pm  = s.pm();
+    nlsat::var x = s.mk_var(false);
+    polynomial_ref _x(pm);
+    _x = pm.mk_polynomial(x);
+    nlsat::literal gt0 = mk_gt(s, _x), lt3 = mk_lt(s, _x - 3), gt2 = mk_gt(s, _x - 2), lt1 = mk_lt(s, _x - 1);
+    nlsat::literal lits1[4] = { gt0, lt3, gt2, lt1 }, core1[2] = { gt2, lt1 };
+    check_core(s, 4, lits1, 2, core1);
+    // no subset of size 2 is infeasible
+    nlsat::literal lt5 = mk_lt(s, _x - 5), out1 = mk_gt(s, (_x^2) - 1), gtm7 = mk_gt(s, _x + 7), lt0 = mk_lt(s, _x), gtm1 = mk_gt(s, _x + 1);
+    nlsat::literal lits2[5] = { lt5, out1, gtm7, lt0, gtm1 }, core2[3] = { out1, lt0, gtm1 };
+    check_core(s, 5, lits2, 3, core2);
+    // the intervals do not cover the line, the literals are kept
+    check_core(s, 2, lits1, 2, lits1);
+}
+
+static lbool nlqsat_check(char const* fml, bool assumption_lemmas, unsigned& reused, unsigned& kept) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    cmd_context ctx(false, &m);
+    ctx.set_ignore_check(true);
+    std::istringstream is(std::string("(assert ") + fml + ")\n");
+    VERIFY(parse_smt2_commands(ctx, is));
+    params_ref p;
+    p.set_bool("assumption_lemmas", assumption_lemmas);
+    ref<solver> sol = mk_tactic2solver(m, mk_nlqsat_tactic(m, p), p);
+    for (expr* e : ctx.assertions())
+        sol->assert_expr(e);
+    lbool r = sol->check_sat(0, nullptr);
+    statistics st;
+    sol->collect_statistics(st);
+    reused += get_stat(st, "qsat reused lemmas");
+    kept   += get_stat(st, "nlsat assumption lemmas kept");
+    return r;
+}
+
+static void tst16() {
+    // quantified problems solved by nlqsat, which checks the shared nlsat solver
+    // under the assumptions of each round
+    std::pair<char const*, lbool> fmls[] = {
+        { "(forall ((x Real)) (exists ((y Real)) (= (* y y y) x)))", l_true },
+        { "(forall ((x Real)) (exists ((y Real)) (= (* y y) x)))", l_false },
+        { "(forall ((x Real)) (exists ((y Real)) (or (<= x 0.0) (= (* y y) x))))", l_true },
+        { "(forall ((x Real)) (exists ((y Real)) (and (> y 0.0) (= (* x y) 1.0))))", l_false },
+        { "(exists ((a Real)) (forall ((x Real)) (>= (+ (* x x) (* a x) 1.0) 0.0)))", l_true },
+        { "(exists ((a Real)) (forall ((x Real)) (>= (+ (* x x) (* a x) (- 1.0)) 0.0)))", l_false },
+    };
+    for (bool assumption_lemmas : { false, true }) {
+        unsigned reused = 0, kept = 0;
+        for (auto const& f : fmls) {
+            lbool r = nlqsat_check(f.first, assumption_lemmas, reused, kept);
+            std::cout << f.first << ": " << r << "\n";
+            ENSURE(r == f.second);
+        }
+        std::cout << "reused lemmas: " << reused << ", assumption lemmas kept: " << kept << "\n";
+        // the lemmas learned under assumptions are only kept across rounds when enabled
+        ENSURE(reused > 0);
+        ENSURE(assumption_lemmas == (kept > 0));
+    }
+}
+
+void tst_nlsat_replay(char ** argv, int argc, int & i) {
+    if (i + 1 >= argc) {
+        std::cout << "require nlsat trace file name\n";
+        return;
+    }
+    char const * file_name = argv[++i];
+    std::ifstream in(file_name, std::ios::in | std::ios::binary);
+    if (!in) {
+        std::cout << "could not open " << file_name << "\n";
+        return;
+    }
+    params_ref      ps;
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps, false);
+    statistics st;
+    s.replay(in, st);
+    st.display_smt2(std::cout);
+}
+
+static void tst22() {
+    // x + y > 2, x < 1, y < 1 is infeasible, the conflicts come from the linear
+    // relaxation where x*y is a fresh variable
+    params_ref      ps;
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps, false);
+    nra::relaxation relax(s, rlim);
+    s.set_linear_relaxation(&relax);
+    nlsat::pmanager & pm = s.pm();
+    nlsat::var x = s.mk_var(false);
+    nlsat::var y = s.mk_var(false);
+    polynomial_ref _x(pm), _y(pm), p(pm);
+    _x = pm.mk_polynomial(x);
+    _y = pm.mk_polynomial(y);
+    nlsat::literal lits[1];
+    p = _x*_y - 1;
+    lits[0] = mk_lt(s, p);
+    s.mk_clause(1, lits, nullptr);
+    p = _x + _y - 2;
+    lits[0] = mk_gt(s, p);
+    s.mk_clause(1, lits, nullptr);
+    p = _x - 1;
+    lits[0] = mk_lt(s, p);
+    s.mk_clause(1, lits, nullptr);
+    p = _y - 1;
+    lits[0] = mk_lt(s, p);
+    s.mk_clause(1, lits, nullptr);
+    ENSURE(s.check() == l_false);
+    unsigned conflicts = get_stat(s, "nlsat linear conflicts");
+    std::cout << "linear conflicts: " << conflicts << "\n";
+    ENSURE(conflicts > 0);
+}
+
+// allocate megabytes until the allocation of the process exceeds mb megabytes; the count
+// starts lower than the live memory when the earlier tests freed memory of other threads
+static void mk_memory_pad(svector<void*>& pad, unsigned mb) {
+    while (memory::get_allocation_size() < mb * 1024ull * 1024ull)
+        pad.push_back(memory::allocate(1024 * 1024));
+}
+
+static void del_memory_pad(svector<void*>& pad) {
+    for (void* p : pad)
+        memory::deallocate(p);
+    pad.reset();
+}
+
+static void tst23() {
+    // a soft memory limit below the current allocation reduces the lemmas to the binary
+    // ones at the next restart, and the answer is unchanged: the lemmas of a first check
+    // are kept in incremental mode, and reduced in the second check
+    params_ref      ps;
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps, true);
+    nlsat::pmanager & pm = s.pm();
+    nlsat::var x = s.mk_var(false);
+    nlsat::var y = s.mk_var(false);
+    nlsat::var z = s.mk_var(false);
+    polynomial_ref _x(pm), _y(pm), _z(pm), p(pm);
+    _x = pm.mk_polynomial(x);
+    _y = pm.mk_polynomial(y);
+    _z = pm.mk_polynomial(z);
+    nlsat::literal lits[2];
+    p = _x*_x + _y*_y + _z*_z - 1;
+    lits[0] = mk_lt(s, p);
+    s.mk_clause(1, lits, nullptr);
+    p = _x*_y + _y*_z + _x*_z - 1;
+    lits[0] = mk_gt(s, p);
+    s.mk_clause(1, lits, nullptr);
+    p = _x*_y*_z - 1;
+    lits[0] = mk_gt(s, p);
+    p = _x + _y + _z;
+    lits[1] = mk_lt(s, p);
+    s.mk_clause(2, lits, nullptr);
+    ENSURE(s.check() == l_false);
+    ENSURE(get_stat(s, "nlsat memory reductions") == 0);
+    unsigned learned = s.num_learned_clauses();
+    std::cout << "learned: " << learned << "\n";
+
+    ps.set_uint("soft_max_memory", 1);
+    s.updt_params(ps);
+    // the test allocates less than a megabyte
+    svector<void*> pad;
+    mk_memory_pad(pad, 2);
+    std::ostringstream out;
+    set_verbose_stream(out);
+    unsigned verbosity = get_verbosity_level();
+    set_verbosity_level(2);
+    lbool r = s.check();
+    set_verbosity_level(verbosity);
+    set_verbose_stream(std::cerr);
+    del_memory_pad(pad);
+    std::string log = out.str();
+    std::cout << log;
+    ENSURE(r == l_false);
+    unsigned reductions = get_stat(s, "nlsat memory reductions");
+    ENSURE(reductions > 0);
+    unsigned n = 0, deleted = 0;
+    for (size_t i = log.find("(nlsat-reduce-memory"); i != std::string::npos; i = log.find("(nlsat-reduce-memory", i + 1), ++n) {
+        deleted += atoi(log.c_str() + log.find(":deleted ", i) + strlen(":deleted "));
+        ENSURE(atoi(log.c_str() + log.find(":longest-kept ", i) + strlen(":longest-kept ")) <= 2);
+    }
+    ENSURE(n == reductions);
+    ENSURE(deleted > 0);
+
+    // the subsystems report their memory in megabytes
+    statistics st;
+    s.collect_statistics(st);
+    double lemmas = 0, polynomials = 0;
+    for (unsigned i = 0; i < st.size(); ++i) {
+        if (st.is_uint(i))
+            continue;
+        if (strcmp(st.get_key(i), "nlsat memory lemmas") == 0)
+            lemmas = st.get_double_value(i);
+        if (strcmp(st.get_key(i), "nlsat memory polynomials") == 0)
+            polynomials = st.get_double_value(i);
+    }
+    std::cout << "lemmas: " << lemmas << " MB, polynomials: " << polynomials << " MB\n";
+    ENSURE(lemmas > 0 && lemmas < 1);
+    ENSURE(polynomials > 0 && polynomials < 2);
+
+    // max_memory is in megabytes
+    ps.set_uint("max_memory", 1);
+    s.updt_params(ps);
+    mk_memory_pad(pad, 2);
+    bool exceeded = false;
+    try {
+        s.check();
+    }
+    catch (nlsat::solver_exception&) {
+        exceeded = true;
+    }
+    del_memory_pad(pad);
+    ENSURE(exceeded);
+    ps.set_uint("max_memory", 64);
+    s.updt_params(ps);
+    ENSURE(s.check() == l_false);
+}
+
+static lbool check_lookahead(params_ref const& ps, unsigned& calls, unsigned& switches, unsigned& conflicts) {
+    // x^2 > 1, y^2 < x, z^2 < x - y^2: the cell x < -1 blocks y
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps, false);
+    anum_manager & am = s.am();
+    nlsat::pmanager & pm = s.pm();
+    nlsat::var x = s.mk_var(false);
+    nlsat::var y = s.mk_var(false);
+    nlsat::var z = s.mk_var(false);
+    polynomial_ref _x(pm), _y(pm), _z(pm), p(pm);
+    _x = pm.mk_polynomial(x);
+    _y = pm.mk_polynomial(y);
+    _z = pm.mk_polynomial(z);
+    nlsat::literal lits[1];
+    p = _x*_x - 1;
+    lits[0] = mk_gt(s, p);
+    s.mk_clause(1, lits, nullptr);
+    p = _y*_y - _x;
+    lits[0] = mk_lt(s, p);
+    s.mk_clause(1, lits, nullptr);
+    p = _z*_z + _y*_y - _x;
+    lits[0] = mk_lt(s, p);
+    s.mk_clause(1, lits, nullptr);
+    lbool r = s.check();
+    if (r == l_true) {
+        scoped_anum one(am);
+        am.set(one, 1);
+        ENSURE(am.gt(s.value(x), one));
+    }
+    calls = get_stat(s, "nlsat lookahead calls");
+    switches = get_stat(s, "nlsat lookahead switches");
+    conflicts = get_stat(s, "nlsat conflicts");
+    std::cout << "lookahead calls: " << calls << " switches: " << switches << " conflicts: " << conflicts << "\n";
+    return r;
+}
+
+static void tst24() {
+    // the witness look-ahead scores the feasible cells of a variable by the clauses they
+    // block, and takes the cell x > 1 instead of the default one, which is a conflict
+    params_ref ps;
+    unsigned calls, switches, conflicts;
+    ENSURE(check_lookahead(ps, calls, switches, conflicts) == l_true);
+    ENSURE(calls == 0);
+    ENSURE(conflicts > 0);
+    ps.set_bool("lookahead", true);
+    ENSURE(check_lookahead(ps, calls, switches, conflicts) == l_true);
+    ENSURE(calls > 0);
+    ENSURE(switches > 0);
+    ENSURE(conflicts == 0);
+    // one cell leaves nothing to choose from
+    ps.set_uint("lookahead.max_cells", 1);
+    bool rejected = false;
+    try {
+        check_lookahead(ps, calls, switches, conflicts);
+    }
+    catch (nlsat::solver_exception&) {
+        rejected = true;
+    }
+    ENSURE(rejected);
+}
+
+// pigeons in holes, a pure Boolean problem with many conflicts
+static lbool check_pigeons(params_ref const& ps, unsigned pigeons, unsigned holes, unsigned& restarts, unsigned& blocked) {
+    reslimit        rlim;
+    nlsat::solver s(rlim, ps, false);
+    vector<nlsat::literal_vector> in(pigeons);
+    for (unsigned i = 0; i < pigeons; ++i)
+        for (unsigned j = 0; j < holes; ++j)
+            in[i].push_back(nlsat::literal(s.mk_bool_var(), false));
+    for (unsigned i = 0; i < pigeons; ++i)
+        s.mk_clause(holes, in[i].data(), nullptr);
+    for (unsigned j = 0; j < holes; ++j)
+        for (unsigned i = 0; i < pigeons; ++i)
+            for (unsigned k = i + 1; k < pigeons; ++k) {
+                nlsat::literal lits[2] = { ~in[i][j], ~in[k][j] };
+                s.mk_clause(2, lits, nullptr);
+            }
+    lbool r = s.check();
+    restarts = get_stat(s, "nlsat restarts");
+    blocked = get_stat(s, "nlsat blocked restarts");
+    std::cout << "conflicts: " << get_stat(s, "nlsat conflicts") << " restarts: " << restarts << " blocked: " << blocked << "\n";
+    return r;
+}
+
+static void tst25() {
+    // ema restarts: the search restarts when the fast average of the lemma lbd exceeds the
+    // slow one by restart.margin, and a restart is blocked after a conflict on a trail
+    // deeper than its average by restart.blocking
+    params_ref ps;
+    unsigned restarts, blocked;
+    ps.set_sym("restart", symbol("ema"));
+    ps.set_double("restart.margin", 0.5);
+    ps.set_double("restart.blocking", 1e9);
+    ENSURE(check_pigeons(ps, 6, 5, restarts, blocked) == l_false);
+    unsigned unblocked_restarts = restarts;
+    ENSURE(restarts > 0);
+    ENSURE(blocked == 0);
+    ps.set_double("restart.blocking", 0.0);
+    ENSURE(check_pigeons(ps, 6, 5, restarts, blocked) == l_false);
+    ENSURE(blocked > 0);
+    ENSURE(restarts < unblocked_restarts);
+    ps.set_double("restart.margin", 1e9);
+    ENSURE(check_pigeons(ps, 6, 5, restarts, blocked) == l_false);
+    ENSURE(restarts == 0);
+}
+
+// a small reader for the json of the profile trace, returns the end of the value
+// starting at i, or std::string::npos, and collects the "name" values
+static size_t skip_json(std::string const& s, size_t i, vector<std::string>& names);
+
+static size_t skip_json_ws(std::string const& s, size_t i) {
+    while (i < s.size() && isspace(static_cast<unsigned char>(s[i])))
+        ++i;
+    return i;
+}
+
+static size_t skip_json_string(std::string const& s, size_t i, std::string& r) {
+    if (i >= s.size() || s[i] != '"')
+        return std::string::npos;
+    for (++i; i < s.size() && s[i] != '"'; ++i) {
+        if (s[i] == '\\')
+            ++i;
+        if (i < s.size())
+            r.push_back(s[i]);
+    }
+    return i < s.size() ? i + 1 : std::string::npos;
+}
+
+static size_t skip_json(std::string const& s, size_t i, vector<std::string>& names) {
+    i = skip_json_ws(s, i);
+    if (i >= s.size())
+        return std::string::npos;
+    std::string str;
+    if (s[i] == '"')
+        return skip_json_string(s, i, str);
+    if (s[i] == '[' || s[i] == '{') {
+        char close = s[i] == '[' ? ']' : '}';
+        i = skip_json_ws(s, i + 1);
+        if (i < s.size() && s[i] == close)
+            return i + 1;
+        while (true) {
+            std::string key;
+            if (close == '}') {
+                i = skip_json_string(s, skip_json_ws(s, i), key);
+                if (i == std::string::npos)
+                    return i;
+                i = skip_json_ws(s, i);
+                if (i >= s.size() || s[i] != ':')
+                    return std::string::npos;
+                ++i;
+            }
+            size_t j = skip_json(s, i, names);
+            if (j == std::string::npos)
+                return j;
+            if (key == "name") {
+                std::string name;
+                if (skip_json_string(s, skip_json_ws(s, i), name) == std::string::npos)
+                    return std::string::npos;
+                names.push_back(name);
+            }
+            i = skip_json_ws(s, j);
+            if (i < s.size() && s[i] == close)
+                return i + 1;
+            if (i >= s.size() || s[i] != ',')
+                return std::string::npos;
+            ++i;
+        }
+    }
+    size_t j = i;
+    while (j < s.size() && (isdigit(static_cast<unsigned char>(s[j])) || strchr("+-.eE", s[j])))
+        ++j;
+    return j > i ? j : std::string::npos;
+}
+
+static void tst26() {
+    // the profiler counts the calls of the hot paths, times them, and writes the timed
+    // scopes to a Chrome trace, a json array of complete events named by their phase
+    char const* file_name = "nlsat_profile_trace.json";
+    params_ref      ps;
+    ps.set_bool("profile", true);
+    ps.set_sym("profile_trace_file", symbol(file_name));
+    statistics st;
+    {
+        reslimit        rlim;
+        nlsat::solver s(rlim, ps, false);
+        nlsat::pmanager & pm = s.pm();
+        nlsat::var x = s.mk_var(false);
+        nlsat::var y = s.mk_var(false);
+        polynomial_ref _x(pm), _y(pm), p(pm);
+        _x = pm.mk_polynomial(x);
+        _y = pm.mk_polynomial(y);
+        nlsat::literal lits[1];
+        p = _x*_x + _y*_y - 1;
+        lits[0] = mk_lt(s, p);
+        s.mk_clause(1, lits, nullptr);
+        p = _x*_y - 1;
+        lits[0] = mk_gt(s, p);
+        s.mk_clause(1, lits, nullptr);
+        ENSURE(s.check() == l_false);
+        s.collect_statistics(st);
+        // the trace is closed with the solver
+    }
+    char const* phases[4] = { "select var", "process arith", "resolve", "explain" };
+    for (char const* ph : phases) {
+        std::string calls = std::string("nlsat calls ") + ph, time = std::string("nlsat time ") + ph;
+        double seconds = 0;
+        for (unsigned i = 0; i < st.size(); ++i)
+            if (!st.is_uint(i) && time == st.get_key(i))
+                seconds = st.get_double_value(i);
+        std::cout << ph << " calls: " << get_stat(st, calls.c_str()) << " time: " << seconds << "\n";
+        ENSURE(get_stat(st, calls.c_str()) > 0);
+        ENSURE(seconds > 0);
+    }
+    std::ifstream in(file_name);
+    ENSURE(in);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    in.close();
+    std::remove(file_name);
+    std::string trace = buffer.str();
+    vector<std::string> names;
+    size_t end = skip_json(trace, 0, names);
+    ENSURE(end != std::string::npos);
+    ENSURE(skip_json_ws(trace, end) == trace.size());
+    ENSURE(trace[skip_json_ws(trace, 0)] == '[');
+    std::cout << "trace events: " << names.size() << "\n";
+    for (char const* ph : phases)
+        ENSURE(std::find(names.begin(), names.end(), std::string(ph)) != names.end());
+    char const* all_phases[8] = { "select var", "find clauses", "process arith", "resolve", "explain",
+                                  "infeasible intervals", "isolate roots", "psc chain" };
+    for (std::string const& n : names)
+        ENSURE(std::find(all_phases, all_phases + 8, n) != all_phases + 8);
+}
+
 void tst_nlsat() {
+    tst26();
+    std::cout << "------------------\n";
+    tst25();
+    std::cout << "------------------\n";
+    tst24();
+    std::cout << "------------------\n";
+    tst23();
+    std::cout << "------------------\n";
+    tst22();
+    std::cout << "------------------\n";
+    tst21();
+    std::cout << "------------------\n";
+    tst20();
+    std::cout << "------------------\n";
+    tst19();
+    std::cout << "------------------\n";
+    tst18();
+    std::cout << "------------------\n";
+    tst17();
+    std::cout << "------------------\n";
+    tst16();
+    std::cout << "------------------\n";
+    tst15();
+    std::cout << "------------------\n";
+    tst14();
+    std::cout << "------------------\n";
+    tst13();
+    tst13_bounds();
+    std::cout << "------------------\n";
+    tst12();
+    std::cout << "------------------\n";
     tst11();
     std::cout << "------------------\n";
     return;
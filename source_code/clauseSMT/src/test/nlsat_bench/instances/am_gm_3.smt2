@@ -0,0 +1,12 @@
+; AM-GM for three non-negative reals: no counterexample
+(set-logic QF_NRA)
+(set-info :status unsat)
+(declare-fun a () Real)
+(declare-fun b () Real)
+(declare-fun c () Real)
+(assert (>= a 0.0))
+(assert (>= b 0.0))
+(assert (>= c 0.0))
+(assert (< (* 27.0 a b c) (* (+ a b c) (+ a b c) (+ a b c))))
+(assert (> (* 27.0 a b c) (* (+ a b c) (+ a b c) (+ a b c))))
+(check-sat)
@@ -0,0 +1,9 @@
+; intersection of the unit circle with a parabola
+(set-logic QF_NRA)
+(set-info :status sat)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (= (+ (* x x) (* y y)) 1.0))
+(assert (= y (- (* x x) 0.5)))
+(assert (> x 0.0))
+(check-sat)
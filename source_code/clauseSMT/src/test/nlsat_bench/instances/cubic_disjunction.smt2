@@ -0,0 +1,12 @@
+; boolean structure over cubic constraints in three variables
+(set-logic QF_NRA)
+(set-info :status sat)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (or (< (- (* x x x) (* 2.0 y)) 0.0) (> (* x y z) 1.0)))
+(assert (or (= (+ (* y y) (* z z z)) 2.0) (< (* x z) (- 1.0))))
+(assert (or (> (+ x y z) 3.0) (< (- (* z z) x) 0.0)))
+(assert (< (* x x) 4.0))
+(assert (< (* y y) 4.0))
+(check-sat)
@@ -0,0 +1,16 @@
+; four unit circles touching a central unit circle, pairwise disjoint
+(set-logic QF_NRA)
+(set-info :status sat)
+(declare-fun x1 () Real)
+(declare-fun y1 () Real)
+(declare-fun x2 () Real)
+(declare-fun y2 () Real)
+(declare-fun x3 () Real)
+(declare-fun y3 () Real)
+(assert (= (+ (* x1 x1) (* y1 y1)) 4.0))
+(assert (= (+ (* x2 x2) (* y2 y2)) 4.0))
+(assert (= (+ (* x3 x3) (* y3 y3)) 4.0))
+(assert (>= (+ (* (- x1 x2) (- x1 x2)) (* (- y1 y2) (- y1 y2))) 4.0))
+(assert (>= (+ (* (- x1 x3) (- x1 x3)) (* (- y1 y3) (- y1 y3))) 4.0))
+(assert (>= (+ (* (- x2 x3) (- x2 x3)) (* (- y2 y3) (- y2 y3))) 4.0))
+(check-sat)
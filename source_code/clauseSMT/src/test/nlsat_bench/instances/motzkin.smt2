@@ -0,0 +1,7 @@
+; the Motzkin polynomial is non-negative (but not a sum of squares)
+(set-logic QF_NRA)
+(set-info :status unsat)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (< (+ (* x x x x y y) (* x x y y y y) (* (- 3.0) x x y y) 1.0) 0.0))
+(check-sat)
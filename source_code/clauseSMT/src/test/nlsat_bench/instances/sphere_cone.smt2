@@ -0,0 +1,11 @@
+; a point on the unit sphere strictly inside a cone and below a plane
+(set-logic QF_NRA)
+(set-info :status sat)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (= (+ (* x x) (* y y) (* z z)) 1.0))
+(assert (< (+ (* x x) (* y y)) (* z z 0.25)))
+(assert (> z 0.0))
+(assert (< (+ x y z) 1.0))
+(check-sat)
@@ -0,0 +1,10 @@
+; sqrt(2) is not a quotient of small positive reals with a rational gap
+(set-logic QF_NRA)
+(set-info :status unsat)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (= (* x x) 2.0))
+(assert (> x 0.0))
+(assert (= (* y y y) 3.0))
+(assert (< (+ x y) 2.8))
+(check-sat)
@@ -0,0 +1,731 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    nlsat_bench.cpp
+
+Abstract:
+
+    Timed microbenchmarks for the kernels of the nonlinear arithmetic engine:
+
+      - upolynomial_isolate   upolynomial::manager::isolate_roots
+      - psc_chain             polynomial::manager::psc_chain
+      - am_compare            algebraic_numbers::manager::compare
+      - am_eval_sign_at       algebraic_numbers::manager::eval_sign_at
+      - ism_union_subset      interval_set_manager::mk_union / subset
+      - solver_check          nlsat::solver::check on QF_NRA instance files
+      - parse_stream          SMT-LIB2 parsing of a generated file through std::istream
+      - parse_mapped          SMT-LIB2 parsing of the same file memory mapped
+
+    Every (kernel, instance) pair is run -r:N times and reported as one JSON
+    object per line on stdout:
+
+      {"kernel":"...","instance":"...","reps":N,"min":s,"median":s,"mean":s,"result":"..."}
+
+    Times are in seconds. Only the kernel itself is timed: the inputs are
+    rebuilt before every repetition (algebraic numbers cache refinements,
+    the solver learns lemmas), outside of the measured region.
+
+    Usage:
+
+      nlsat-bench [-r:reps] [-k:kernel]* [-s:mb] [key=value]* [file.smt2]*
+
+    Without file arguments solver_check runs the curated instances of
+    src/test/nlsat_bench/instances, which are looked up next to the source
+    file of the benchmark (the build directory for the Makefile build).
+    key=value pairs are global parameters (e.g. nlsat.seed=3).
+
+Revision History:
+
+--*/
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include "util/util.h"
+#include "util/rlimit.h"
+#include "util/gparams.h"
+#include "util/memory_manager.h"
+#include "util/small_object_allocator.h"
+#include "util/mapped_file.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/z3_exception.h"
+#include "util/mpbq.h"
+#include "math/polynomial/polynomial.h"
+#include "math/polynomial/upolynomial.h"
+#include "math/polynomial/algebraic_numbers.h"
+#include "math/polynomial/polynomial_var2value.h"
+#include "nlsat/nlsat_interval_set.h"
+#include "nlsat/nlsat_solver.h"
+#include "nlsat/tactic/goal2nlsat.h"
+#include "ast/expr2var.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "tactic/goal.h"
+#include "tactic/tactical.h"
+#include "tactic/core/simplify_tactic.h"
+#include "tactic/core/tseitin_cnf_tactic.h"
+#include "tactic/arith/purify_arith_tactic.h"
+
+typedef std::chrono::steady_clock bench_clock;
+
+static unsigned                 g_reps = 10;
+static unsigned                 g_parse_mb = 64;
+static std::vector<std::string> g_kernels;
+static std::vector<std::string> g_files;
+static bool                     g_failed = false;
+
+static void display_usage() {
+    std::cout << "nlsat microbenchmarks.\n";
+    std::cout << "Usage: nlsat-bench [options] [key=value]* [file.smt2]*\n";
+    std::cout << "Options:\n";
+    std::cout << "  -h        display this message.\n";
+    std::cout << "  -r:reps   repetitions of every benchmark (default 10).\n";
+    std::cout << "  -k:name   run only the given kernel (may be repeated):\n";
+    std::cout << "            upolynomial_isolate, psc_chain, am_compare, am_eval_sign_at,\n";
+    std::cout << "            poly_eval, ism_union_subset, solver_check, parse_stream, parse_mapped.\n";
+    std::cout << "            parse_stream and parse_mapped only run when given with -k.\n";
+    std::cout << "  -s:mb     size of the generated file of the parse benchmarks (default 64).\n";
+    std::cout << "  -v:level  verbosity level.\n";
+    std::cout << "solver_check runs nlsat::solver::check on every file.smt2 given,\n";
+    std::cout << "or on the curated instances when no file is given.\n";
+}
+
+static void error(char const * msg) {
+    std::cerr << "Error: " << msg << "\n";
+    std::cerr << "For usage information: nlsat-bench -h\n";
+    exit(1);
+}
+
+static bool parse_cmd_line_args(int argc, char ** argv) {
+    for (int i = 1; i < argc; i++) {
+        char * arg = argv[i];
+        char * eq_pos = nullptr;
+        if (arg[0] == '-') {
+            char * opt_name = arg + 1;
+            char * opt_arg  = nullptr;
+            char * colon    = strchr(arg, ':');
+            if (colon) {
+                opt_arg = colon + 1;
+                *colon  = 0;
+            }
+            if (strcmp(opt_name, "h") == 0 || strcmp(opt_name, "?") == 0) {
+                display_usage();
+                return false;
+            }
+            else if (strcmp(opt_name, "r") == 0) {
+                if (!opt_arg)
+                    error("option argument (-r:reps) is missing.");
+                g_reps = std::max(1l, strtol(opt_arg, nullptr, 10));
+            }
+            else if (strcmp(opt_name, "k") == 0) {
+                if (!opt_arg)
+                    error("option argument (-k:kernel) is missing.");
+                g_kernels.push_back(opt_arg);
+            }
+            else if (strcmp(opt_name, "s") == 0) {
+                if (!opt_arg)
+                    error("option argument (-s:mb) is missing.");
+                g_parse_mb = std::max(1l, strtol(opt_arg, nullptr, 10));
+            }
+            else if (strcmp(opt_name, "v") == 0) {
+                if (!opt_arg)
+                    error("option argument (-v:level) is missing.");
+                set_verbosity_level(strtol(opt_arg, nullptr, 10));
+            }
+            else {
+                error("unknown option.");
+            }
+        }
+        else if ((eq_pos = strchr(arg, '='))) {
+            char * key   = arg;
+            *eq_pos      = 0;
+            char * value = eq_pos + 1;
+            try {
+                gparams::set(key, value);
+            }
+            catch (z3_exception & ex) {
+                std::cerr << ex.msg() << "\n";
+            }
+        }
+        else {
+            g_files.push_back(arg);
+        }
+    }
+    return true;
+}
+
+static char const * g_curated[] = {
+    "am_gm_3.smt2",
+    "circle_parabola.smt2",
+    "cubic_disjunction.smt2",
+    "kissing_2d.smt2",
+    "motzkin.smt2",
+    "sphere_cone.smt2",
+    "sqrt2_irrational.smt2",
+};
+
+// the curated instances are in the instances directory next to this file
+static void add_curated_instances() {
+    std::string dir(__FILE__);
+    size_t slash = dir.find_last_of("/\\");
+    dir = slash == std::string::npos ? std::string() : dir.substr(0, slash + 1);
+    for (char const * f : g_curated)
+        g_files.push_back(dir + "instances/" + f);
+}
+
+static bool enabled(char const * kernel) {
+    return g_kernels.empty() || std::find(g_kernels.begin(), g_kernels.end(), kernel) != g_kernels.end();
+}
+
+// the parse benchmarks write a large file, they only run when requested with -k
+static bool requested(char const * kernel) {
+    return std::find(g_kernels.begin(), g_kernels.end(), kernel) != g_kernels.end();
+}
+
+static std::string escape(std::string const & s) {
+    std::string r;
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            r += '\\';
+        r += c;
+    }
+    return r;
+}
+
+/**
+   \brief Run body g_reps times, calling setup (untimed) before every repetition,
+   and print the JSON record of the benchmark. The result of the last repetition is reported.
+*/
+static void run(char const * kernel, std::string const & instance,
+                std::function<void()> const & setup, std::function<std::string()> const & body) {
+    std::vector<double> times;
+    std::string result;
+    try {
+        for (unsigned i = 0; i < g_reps; i++) {
+            setup();
+            bench_clock::time_point start = bench_clock::now();
+            result = body();
+            times.push_back(std::chrono::duration<double>(bench_clock::now() - start).count());
+        }
+    }
+    catch (z3_exception & ex) {
+        std::cerr << kernel << " " << instance << ": " << ex.msg() << "\n";
+        g_failed = true;
+        return;
+    }
+    std::sort(times.begin(), times.end());
+    double sum = 0;
+    for (double t : times)
+        sum += t;
+    unsigned n = times.size();
+    double median = n % 2 == 1 ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2;
+    std::cout << std::scientific << std::setprecision(6)
+              << "{\"kernel\":\"" << kernel << "\""
+              << ",\"instance\":\"" << escape(instance) << "\""
+              << ",\"reps\":" << n
+              << ",\"min\":" << times[0]
+              << ",\"median\":" << median
+              << ",\"mean\":" << sum / n
+              << ",\"result\":\"" << escape(result) << "\"}" << std::endl;
+}
+
+// -----------------------------------
+//
+// upolynomial root isolation
+//
+// -----------------------------------
+
+static void bench_isolate(upolynomial::manager & um, char const * name, polynomial_ref const & p) {
+    upolynomial::scoped_numeral_vector q(um);
+    um.to_numeral_vector(p, q);
+    mpbq_manager bqm(p.m().m());
+    scoped_mpbq_vector roots(bqm), lowers(bqm), uppers(bqm);
+    run("upolynomial_isolate", name,
+        [&]() { roots.reset(); lowers.reset(); uppers.reset(); },
+        [&]() {
+            um.isolate_roots(q.size(), q.data(), bqm, roots, lowers, uppers);
+            return std::to_string(roots.size() + lowers.size()) + " roots";
+        });
+}
+
+static void bench_upolynomial_isolate() {
+    reslimit rl;
+    polynomial::numeral_manager nm;
+    polynomial::manager pm(rl, nm);
+    upolynomial::manager um(rl, nm);
+    polynomial_ref x(pm), p(pm), t0(pm), t1(pm), t2(pm);
+    x = pm.mk_polynomial(pm.mk_var());
+
+    // Wilkinson: (x - 1)(x - 2)...(x - 20)
+    p = x - 1;
+    for (int i = 2; i <= 20; i++)
+        p = p * (x - i);
+    bench_isolate(um, "wilkinson_20", p);
+
+    // Chebyshev T_30: 30 real roots clustered at -1 and 1
+    t0 = pm.mk_const(rational(1));
+    t1 = x;
+    for (unsigned i = 2; i <= 30; i++) {
+        t2 = 2 * x * t1 - t0;
+        t0 = t1;
+        t1 = t2;
+    }
+    bench_isolate(um, "chebyshev_30", t1);
+
+    // x^40 - 2: two irrational roots very close to +-1
+    p = (x ^ 40) - 2;
+    bench_isolate(um, "x40_minus_2", p);
+
+    // Mignotte-like: x^20 - 2(50x - 1)^2, two roots very close to 1/50
+    p = (x ^ 20) - 2 * ((50 * x - 1) ^ 2);
+    bench_isolate(um, "mignotte_20", p);
+
+    // seeded dense polynomial of degree 40 with small coefficients
+    random_gen r(17);
+    p = pm.mk_const(rational(1));
+    for (unsigned i = 1; i <= 40; i++)
+        p = p + (static_cast<int>(r() % 201) - 100) * (x ^ i);
+    bench_isolate(um, "dense_40", p);
+}
+
+// -----------------------------------
+//
+// Principal subresultant coefficients
+//
+// -----------------------------------
+
+static void bench_psc(char const * name, polynomial_ref const & p, polynomial_ref const & q, polynomial::var x) {
+    polynomial::manager & pm = p.m();
+    polynomial_ref_vector S(pm);
+    run("psc_chain", name,
+        [&]() { S.reset(); },
+        [&]() {
+            pm.psc_chain(p, q, x, S);
+            return std::to_string(S.size()) + " coefficients";
+        });
+}
+
+static void bench_psc_chain() {
+    reslimit rl;
+    polynomial::numeral_manager nm;
+    polynomial::manager pm(rl, nm);
+    polynomial_ref x(pm), y(pm), z(pm), p(pm), q(pm);
+    x = pm.mk_polynomial(pm.mk_var());
+    y = pm.mk_polynomial(pm.mk_var());
+    z = pm.mk_polynomial(pm.mk_var());
+
+    // discriminant of a bivariate polynomial of degree 8 in the main variable
+    random_gen r(29);
+    p = (y ^ 8);
+    for (unsigned i = 0; i < 8; i++)
+        p = p + (static_cast<int>(r() % 21) - 10) * (x ^ (r() % 4)) * (y ^ i);
+    q = derivative(p, 1);
+    bench_psc("disc_xy_8", p, q, 1);
+
+    // resultant of two trivariate polynomials
+    p = (x ^ 4) + (y ^ 3) * z - x * y * z + 1;
+    q = (x ^ 3) * z - (y ^ 2) + 2 * x - z;
+    bench_psc("res_xyz_4_3", p, q, 0);
+
+    // cylinder/sphere intersection projected along z
+    p = (x ^ 2) + (y ^ 2) + (z ^ 2) - 1;
+    q = ((x - 1) ^ 2) + (z ^ 2) - (y ^ 3) - 2;
+    bench_psc("sphere_cubic_z", p, q, 2);
+}
+
+// -----------------------------------
+//
+// Algebraic numbers
+//
+// -----------------------------------
+
+static void bench_am_compare() {
+    reslimit rl;
+    unsynch_mpq_manager qm;
+    anum_manager am(rl, qm);
+    polynomial::manager pm(rl, qm);
+    polynomial_ref x(pm), p(pm);
+    x = pm.mk_polynomial(pm.mk_var());
+
+    // numbers that only separate after many refinement steps
+    scoped_anum_vector vs(am);
+    std::function<void()> mk_close = [&]() {
+        vs.reset();
+        scoped_anum v(am);
+        // sqrt(2) and sqrt(2 + 10^-k)
+        am.set(v, 2); am.root(v, 2, v); vs.push_back(v);
+        for (unsigned k = 4; k <= 20; k += 4) {
+            rational c = rational(2) + rational(1) / power(rational(10), k);
+            am.set(v, c.to_mpq()); am.root(v, 2, v); vs.push_back(v);
+        }
+        // cbrt(3) and the real root of 10^k x^3 - x - 3 10^k
+        am.set(v, 3); am.root(v, 3, v); vs.push_back(v);
+        for (unsigned k = 6; k <= 18; k += 6) {
+            rational c = power(rational(10), k);
+            p = c * (x ^ 3) - x - 3 * c;
+            am.mk_root(p, 1, v); vs.push_back(v);
+        }
+    };
+    run("am_compare", "close_irrationals", mk_close,
+        [&]() {
+            int acc = 0;
+            for (unsigned i = 0; i < vs.size(); i++)
+                for (unsigned j = 0; j < vs.size(); j++)
+                    acc += am.compare(vs[i], vs[j]);
+            return std::to_string(acc);
+        });
+
+    // all 20 roots of the Wilkinson polynomial perturbed by 2^-23 x^19
+    std::function<void()> mk_wilkinson = [&]() {
+        vs.reset();
+        p = x - 1;
+        for (int i = 2; i <= 20; i++)
+            p = p * (x - i);
+        p = rational(2).expt(23) * p + (x ^ 19);
+        scoped_anum_vector roots(am);
+        am.isolate_roots(p, roots);
+        for (unsigned i = 0; i < roots.size(); i++)
+            vs.push_back(roots[i]);
+    };
+    run("am_compare", "perturbed_wilkinson", mk_wilkinson,
+        [&]() {
+            int acc = 0;
+            for (unsigned i = 0; i < vs.size(); i++)
+                for (unsigned j = 0; j < vs.size(); j++)
+                    acc += am.compare(vs[i], vs[j]);
+            return std::to_string(acc) + " (" + std::to_string(vs.size()) + " roots)";
+        });
+}
+
+static void bench_am_eval_sign_at() {
+    reslimit rl;
+    unsynch_mpq_manager qm;
+    anum_manager am(rl, qm);
+    polynomial::manager pm(rl, qm);
+    polynomial_ref x0(pm), x1(pm), x2(pm), p(pm), q(pm), r(pm);
+    x0 = pm.mk_polynomial(pm.mk_var());
+    x1 = pm.mk_polynomial(pm.mk_var());
+    x2 = pm.mk_polynomial(pm.mk_var());
+    // vanishes at (sqrt 2, cbrt 3, sqrt 2 + cbrt 3)
+    p = ((x2 - x0) ^ 3) - 3;
+    q = (x0 ^ 2) * x1 - 2 * x1 + x2 * (x1 ^ 3) - 3 * x2;
+    // does not vanish, but is very small there
+    r = ((x2 - x0) ^ 3) - 3 + x0 * x1 - x1 * x0 + rational(1) / power(rational(10), 12);
+
+    scoped_anum v0(am), v1(am), v2(am);
+    scoped_ptr<polynomial::simple_var2value<anum_manager>> x2v;
+    std::function<void()> setup = [&]() {
+        scoped_anum t(am);
+        am.set(v0, 2); am.root(v0, 2, v0);
+        am.set(v1, 3); am.root(v1, 3, v1);
+        am.set(t, 3); am.root(t, 3, t);
+        am.add(v0, t, v2);
+        x2v = alloc(polynomial::simple_var2value<anum_manager>, am);
+        x2v->push_back(0, v0);
+        x2v->push_back(1, v1);
+        x2v->push_back(2, v2);
+    };
+    run("am_eval_sign_at", "zero_cubic", setup,
+        [&]() { return std::to_string(am.eval_sign_at(p, *x2v)); });
+    run("am_eval_sign_at", "zero_mixed", setup,
+        [&]() { return std::to_string(am.eval_sign_at(q, *x2v)); });
+    run("am_eval_sign_at", "tiny_nonzero", setup,
+        [&]() { return std::to_string(am.eval_sign_at(r, *x2v)); });
+}
+
+// -----------------------------------
+//
+// Polynomial evaluation at rational points
+//
+// -----------------------------------
+
+static void bench_poly_eval() {
+    reslimit rl;
+    unsynch_mpq_manager qm;
+    polynomial::manager pm(rl, qm);
+    unsigned const num_vars = 4, degree = 4, num_points = 256;
+    // dense: (1 + x0 + x1 + x2 + x3)^4 - x0*x1*x2*x3
+    polynomial_ref p(pm), s(pm), m(pm), x(pm);
+    s = pm.mk_const(rational(1));
+    m = pm.mk_const(rational(1));
+    for (unsigned i = 0; i < num_vars; i++) {
+        x = pm.mk_polynomial(pm.mk_var());
+        s = s + x;
+        m = m * x;
+    }
+    p = (s ^ degree) - m;
+
+    scoped_ptr_vector<polynomial::simple_var2value<unsynch_mpq_manager>> points;
+    ptr_vector<polynomial::var2mpq const> x2vs;
+    for (unsigned k = 0; k < num_points; k++) {
+        auto * x2v = alloc(polynomial::simple_var2value<unsynch_mpq_manager>, qm);
+        for (unsigned i = 0; i < num_vars; i++) {
+            scoped_mpq v(qm);
+            qm.set(v, static_cast<int>(k % 7) - 3 + static_cast<int>(i), static_cast<int>(k % 5) + 1);
+            x2v->push_back(i, v);
+        }
+        points.push_back(x2v);
+        x2vs.push_back(x2v);
+    }
+    scoped_mpq_vector rs(qm);
+    rs.resize(num_points);
+    auto sum = [&]() {
+        scoped_mpq acc(qm);
+        for (unsigned k = 0; k < num_points; k++)
+            qm.add(acc, rs[k], acc);
+        return qm.to_string(acc);
+    };
+    std::function<void()> setup = []() {};
+    run("poly_eval", "dense_deg4_single", setup, [&]() {
+        for (unsigned k = 0; k < num_points; k++)
+            pm.eval(p, *x2vs[k], rs[k]);
+        return sum();
+    });
+    run("poly_eval", "dense_deg4_batch", setup, [&]() {
+        pm.eval(p, num_points, x2vs.data(), rs.data());
+        return sum();
+    });
+}
+
+// -----------------------------------
+//
+// Interval sets
+//
+// -----------------------------------
+
+static void bench_ism_union_subset() {
+    reslimit rl;
+    unsynch_mpq_manager qm;
+    anum_manager am(rl, qm);
+    small_object_allocator allocator;
+    nlsat::interval_set_manager ism(am, allocator);
+
+    // n disjoint open intervals (2i, 2i+1) with rational or algebraic endpoints,
+    // merged in an interleaved order, plus subset checks against the running union.
+    auto bench = [&](char const * name, unsigned n, bool algebraic) {
+        scoped_anum_vector lows(am), highs(am);
+        scoped_anum l(am), h(am);
+        for (unsigned i = 0; i < n; i++) {
+            am.set(l, 2 * i);
+            am.set(h, 2 * i + 1);
+            if (algebraic) {
+                scoped_anum s(am);
+                am.set(s, 2 * (i + 1));
+                am.root(s, 2, s);
+                am.add(l, s, l);
+                am.add(h, s, h);
+            }
+            lows.push_back(l);
+            highs.push_back(h);
+        }
+        vector<nlsat::interval_set_ref> singles;
+        nlsat::interval_set_ref acc(ism);
+        run("ism_union_subset", name,
+            [&]() {
+                acc = nullptr;
+                singles.reset();
+                for (unsigned i = 0; i < n; i++) {
+                    unsigned j = (i * 7) % n;
+                    singles.push_back(nlsat::interval_set_ref(ism));
+                    singles.back() = ism.mk(true, false, lows[j], true, false, highs[j], nlsat::literal(j, false), nullptr);
+                }
+            },
+            [&]() {
+                unsigned num_subsets = 0;
+                for (unsigned i = 0; i < n; i++) {
+                    acc = ism.mk_union(acc, singles[i]);
+                    for (unsigned j = 0; j <= i; j += 4)
+                        num_subsets += ism.subset(singles[j], acc);
+                }
+                return std::to_string(ism.num_intervals(acc)) + " intervals, " + std::to_string(num_subsets) + " subsets";
+            });
+    };
+    bench("rational_128", 128, false);
+    bench("algebraic_64", 64, true);
+}
+
+// -----------------------------------
+//
+// nlsat::solver::check
+//
+// -----------------------------------
+
+/**
+   \brief Apply the part of qfnra-nlsat that is needed to put the goal in the form
+   accepted by goal2nlsat.
+*/
+static goal_ref preprocess(ast_manager & m, goal_ref const & g) {
+    params_ref main_p;
+    main_p.set_bool("elim_and", true);
+    main_p.set_bool("blast_distinct", true);
+    params_ref purify_p;
+    purify_p.set_bool("complete", false);
+    tactic_ref t = and_then(using_params(mk_simplify_tactic(m), main_p),
+                            using_params(mk_purify_arith_tactic(m), purify_p),
+                            mk_tseitin_cnf_core_tactic(m),
+                            using_params(mk_simplify_tactic(m), main_p));
+    goal_ref_buffer result;
+    exec(*t, g, result);
+    if (result.size() != 1)
+        throw default_exception("preprocessing did not produce a single goal");
+    return result[0];
+}
+
+static void bench_solver_check(char const * file_name) {
+    std::ifstream in(file_name);
+    if (in.bad() || in.fail()) {
+        std::cerr << "failed to open file: " << file_name << "\n";
+        g_failed = true;
+        return;
+    }
+    std::string name(file_name);
+    size_t slash = name.find_last_of("/\\");
+    if (slash != std::string::npos)
+        name = name.substr(slash + 1);
+
+    cmd_context ctx;
+    ctx.set_ignore_check(true);
+    goal_ref g;
+    try {
+        if (!parse_smt2_commands(ctx, in))
+            throw default_exception("parse error");
+        // the manager is created by the script, after its set-logic
+        ast_manager & m = ctx.m();
+        g = alloc(goal, m, false, false, false);
+        for (expr * a : ctx.assertions())
+            g->assert_expr(a);
+        g = preprocess(m, g);
+    }
+    catch (z3_exception & ex) {
+        std::cerr << file_name << ": " << ex.msg() << "\n";
+        g_failed = true;
+        return;
+    }
+
+    ast_manager & m = ctx.m();
+    params_ref p = gparams::get_module("nlsat");
+    scoped_ptr<nlsat::solver> s;
+    scoped_ptr<expr2var> a2b, t2x;
+    run("solver_check", name,
+        [&]() {
+            // the solver must be destroyed before the maps that hold references into m
+            s = nullptr;
+            a2b = alloc(expr2var, m);
+            t2x = alloc(expr2var, m);
+            s = alloc(nlsat::solver, m.limit(), p, false);
+            goal2nlsat g2nl;
+            g2nl(*g, p, *s, *a2b, *t2x);
+        },
+        [&]() {
+            if (g->inconsistent())
+                return std::string("unsat");
+            switch (s->check()) {
+            case l_true:  return std::string("sat");
+            case l_false: return std::string("unsat");
+            default:      return std::string("unknown");
+            }
+        });
+    s = nullptr;
+}
+
+// -----------------------------------
+//
+// SMT-LIB2 parsing
+//
+// -----------------------------------
+
+/**
+   \brief Write a QF_NRA file of about mb megabytes: random polynomial constraints
+   over 1000 real variables, with comments and indentation.
+*/
+static void mk_parse_file(char const * file_name, unsigned mb) {
+    std::ofstream out(file_name);
+    random_gen r(0);
+    unsigned const num_vars = 1000;
+    out << "(set-logic QF_NRA)\n";
+    for (unsigned i = 0; i < num_vars; i++)
+        out << "(declare-fun x" << i << " () Real)\n";
+    size_t target = static_cast<size_t>(mb) * 1024 * 1024;
+    for (unsigned k = 0; static_cast<size_t>(out.tellp()) < target; k++) {
+        if (k % 16 == 0)
+            out << "; constraint block " << k / 16 << "\n";
+        out << "(assert (or";
+        for (unsigned l = 0; l < 3; l++) {
+            out << "\n    (" << (r(2) ? "<" : ">=") << " (+";
+            for (unsigned m = 0; m < 4; m++) {
+                out << " (* " << r(1000) << "." << r(100) << " x" << r(num_vars);
+                if (r(2))
+                    out << " x" << r(num_vars);
+                out << ")";
+            }
+            out << ") " << r(1000000) << ")";
+        }
+        out << "))\n";
+    }
+    out << "(check-sat)\n";
+}
+
+static void bench_parse() {
+    char const * file_name = "nlsat-bench-parse.smt2";
+    mk_parse_file(file_name, g_parse_mb);
+    std::string name = std::to_string(g_parse_mb) + "MB";
+    scoped_ptr<cmd_context> ctx;
+    auto setup = [&]() {
+        ctx = nullptr;
+        ctx = alloc(cmd_context);
+        ctx->set_ignore_check(true);
+    };
+    auto result = [&](bool ok) {
+        if (!ok)
+            throw default_exception("parse error");
+        return std::to_string(ctx->assertions().size()) + " assertions";
+    };
+    if (requested("parse_stream"))
+        run("parse_stream", name, setup, [&]() {
+            std::ifstream in(file_name);
+            return result(parse_smt2_commands(*ctx, in));
+        });
+    if (requested("parse_mapped"))
+        run("parse_mapped", name, setup, [&]() {
+            mapped_file in;
+            if (!in.open(file_name))
+                throw default_exception("failed to map the file");
+            return result(parse_smt2_commands(*ctx, in.begin(), in.end()));
+        });
+    ctx = nullptr;
+    std::remove(file_name);
+}
+
+int main(int argc, char ** argv) {
+    memory::initialize(0);
+    if (!parse_cmd_line_args(argc, argv))
+        return 0;
+    if (g_files.empty())
+        add_curated_instances();
+    if (enabled("upolynomial_isolate"))
+        bench_upolynomial_isolate();
+    if (enabled("psc_chain"))
+        bench_psc_chain();
+    if (enabled("am_compare"))
+        bench_am_compare();
+    if (enabled("am_eval_sign_at"))
+        bench_am_eval_sign_at();
+    if (enabled("poly_eval"))
+        bench_poly_eval();
+    if (enabled("ism_union_subset"))
+        bench_ism_union_subset();
+    if (enabled("solver_check"))
+        for (std::string const & f : g_files)
+            bench_solver_check(f.c_str());
+    if (requested("parse_stream") || requested("parse_mapped"))
+        bench_parse();
+    return g_failed ? 1 : 0;
+}
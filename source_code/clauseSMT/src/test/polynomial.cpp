@@ -1352,6 +1352,13 @@ static void tst_eval(polynomial_ref const & p, polynomial::var x0, rational v0,
     scoped_mpq ex(qm);
     qm.set(ex, expected.to_mpq());
     ENSURE(qm.eq(r, ex));
+    // the batch evaluation runs the compiled program of p on several points
+    polynomial::var2mpq const * x2vs[3] = { &x2v, &x2v, &x2v };
+    scoped_mpq_vector rs(qm);
+    rs.resize(3);
+    p.m().eval(p, 3, x2vs, rs.data());
+    for (unsigned i = 0; i < 3; i++)
+        ENSURE(qm.eq(rs[i], ex));
 }
 
 static void tst_eval() {
@@ -1385,6 +1392,13 @@ static void tst_eval() {
     tst_eval((x0^5) + x0*x1 + 1, 0, rational(2), 1, rational(1), 2, rational(5), rational(35));
     tst_eval((x1^5) + x0*x1 + 1, 0, rational(2), 1, rational(1), 2, rational(5), rational(4));
     tst_eval((x1^5) + x0*(x1^2) + 1, 0, rational(2), 1, rational(-2), 2, rational(5), rational(-23));
+    // the program compiled by the evaluation is dropped when the variables are renamed
+    polynomial_ref p(m);
+    p = (x0^2) - 2*x1;
+    tst_eval(p, 0, rational(1), 1, rational(3), 2, rational(0), rational(-5));
+    polynomial::var new_order[3] = { 1, 0, 2 };
+    m.rename(3, new_order);
+    tst_eval(p, 0, rational(1), 1, rational(3), 2, rational(0), rational(7));
 }
 
 static void tst_mk_unique() {
@@ -0,0 +1,99 @@
+/*++
+Copyright (c) 2012 Microsoft Corporation
+
+Module Name:
+
+    smt2_nlsat.cpp
+
+Abstract:
+
+    The scripts loaded directly into nlsat have the answer of the regular
+    front-end, and the scripts it rejects (including malformed ones) are
+    left to it.
+
+--*/
+
+#include "util/rlimit.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "solver/solver.h"
+#include "nlsat/nlsat_solver.h"
+#include "nlsat/tactic/smt2_nlsat.h"
+
+static std::string regular_answer(char const * script) {
+    cmd_context ctx;
+    ctx.set_solver_factory(mk_smt_strategic_solver_factory());
+    std::ostringstream out;
+    ctx.set_regular_stream(out);
+    ctx.set_diagnostic_stream(out);
+    std::istringstream is(script);
+    parse_smt2_commands(ctx, is);
+    return out.str();
+}
+
+// empty if the script is rejected
+static std::string nlsat_answer(char const * script) {
+    cmd_context ctx;
+    params_ref p;
+    reslimit lim;
+    nlsat::solver s(lim, p, false);
+    std::string text(script);
+    if (!load_smt2_nlsat(ctx, text.c_str(), text.c_str() + text.size(), s, p))
+        return std::string();
+    switch (s.check()) {
+    case l_true:  return "sat\n";
+    case l_false: return "unsat\n";
+    default:      return "unknown\n";
+    }
+}
+
+#define NRA(decls, body) "(set-logic QF_NRA)\n" decls "(assert " body ")\n(check-sat)\n"
+#define XY "(declare-fun x () Real)\n(declare-const y Real)\n(declare-const b Bool)\n"
+
+static char const * loaded[] = {
+    NRA(XY, "(= (* x x) 2.0)"),
+    NRA(XY, "(and (> (* x y) 1) (< (+ (* x x) (* y y)) 1))"),
+    NRA(XY, "(or (> (* x x) 0) (< x 0) (= (* 2 x) (- y 1)))"),
+    NRA(XY, "(not (or (<= x 0) (>= (* x x x) (/ 1 8))))"),
+    NRA(XY, "(and (or b (> x 1)) (or (not b) (< x (- 1))) (= (* x x) 4))"),
+    NRA(XY, "(and (= (+ (* x x) (* (- 2) x) 1) 0) (> x 1))"),
+    NRA(XY, "(and (< (* 3 x) (/ 1 2)) (> (* 6 x) 1.0))"),
+};
+
+static char const * rejected[] = {
+    // malformed
+    NRA(XY, "(or)"),
+    NRA(XY, "(and)"),
+    NRA(XY, "(not b b)"),
+    NRA(XY, "(> z 0)"),
+    NRA("(declare-fun x () Real)\n(declare-fun x () Real)\n", "(> x 0)"),
+    "(set-logic QF_NRA)\n(declare-fun x () Real)\n(assert (> x 0)\n(check-sat)\n",
+    // not supported by the loader
+    NRA(XY, "(or b)"),
+    NRA(XY, "(> x)"),
+    NRA(XY, "(or (and (> x 0) (< x 0)) (= (* 2 x) (- y 1)))"),
+    NRA(XY, "(< x y 1)"),
+    NRA(XY, "(> (/ x 0) 1)"),
+    NRA(XY, "(ite b (> x 0) (< x 0))"),
+    NRA(XY, "(let ((z (* x x))) (> z 1))"),
+    "(set-logic QF_LRA)\n(declare-fun x () Real)\n(assert (> x 0))\n(check-sat)\n",
+    "(set-logic QF_NRA)\n(declare-fun x () Real)\n(assert (> x 0))\n",
+    "(set-logic QF_NRA)\n(declare-fun x () Real)\n(assert (> x 0))\n(check-sat)\n(get-model)\n",
+};
+
+void tst_smt2_nlsat() {
+    for (char const * script : loaded) {
+        std::string r1 = regular_answer(script), r2 = nlsat_answer(script);
+        std::cout << r1 << r2;
+        ENSURE(r1 == "sat\n" || r1 == "unsat\n");
+        ENSURE(r1 == r2);
+    }
+    for (char const * script : rejected) {
+        std::string r = regular_answer(script);
+        std::cout << r;
+        ENSURE(nlsat_answer(script).empty());
+    }
+    // the errors of the malformed scripts come from the regular front-end
+    for (unsigned i = 0; i < 6; ++i)
+        ENSURE(regular_answer(rejected[i]).find("(error") != std::string::npos);
+}
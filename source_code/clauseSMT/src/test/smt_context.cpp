@@ -4,9 +4,66 @@ Copyright (c) 2015 Microsoft Corporation
 
 --*/
 
+#include <thread>
 #include "smt/smt_context.h"
 #include "ast/reg_decl_plugins.h"
 
+// pigeons into holes, unsat when there are more pigeons
+static void mk_pigeonhole(ast_manager& m, unsigned pigeons, unsigned holes, expr_ref_vector& fmls) {
+    expr_ref_vector p(m);
+    for (unsigned i = 0; i < pigeons; ++i)
+        for (unsigned j = 0; j < holes; ++j)
+            p.push_back(m.mk_const(symbol(("p_" + std::to_string(i) + "_" + std::to_string(j)).c_str()), m.mk_bool_sort()));
+    for (unsigned i = 0; i < pigeons; ++i) {
+        expr_ref_vector in(m);
+        for (unsigned j = 0; j < holes; ++j)
+            in.push_back(p.get(i * holes + j));
+        fmls.push_back(m.mk_or(in));
+    }
+    for (unsigned j = 0; j < holes; ++j)
+        for (unsigned i = 0; i < pigeons; ++i)
+            for (unsigned k = i + 1; k < pigeons; ++k)
+                fmls.push_back(m.mk_or(m.mk_not(p.get(i * holes + j)), m.mk_not(p.get(k * holes + j))));
+}
+
+static unsigned get_stat(smt::context& ctx, char const* key) {
+    statistics st;
+    ctx.collect_statistics(st);
+    unsigned r = 0;
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            r += st.get_uint_value(i);
+    return r;
+}
+
+// threads that share their learned clauses (threads.share) keep the right answers.
+// The number of threads is capped by the hardware threads, on a single core
+// the check is sequential.
+static void tst_parallel_share() {
+    for (unsigned holes = 6; holes <= 7; ++holes) {
+        for (unsigned pigeons = holes; pigeons <= holes + 1; ++pigeons) {
+            smt_params params;
+            params.m_threads = 4;
+            params.m_threads_share = true;
+            // several threads also on a single core, so that the clauses are exchanged
+            params.m_threads_per_core = false;
+            ast_manager m;
+            reg_decl_plugins(m);
+            smt::context ctx(m, params);
+            expr_ref_vector fmls(m);
+            mk_pigeonhole(m, pigeons, holes, fmls);
+            for (expr* f : fmls)
+                ctx.assert_expr(f);
+            lbool r = ctx.check();
+            std::cout << "pigeons " << pigeons << " holes " << holes << ": " << r
+                      << " imported " << get_stat(ctx, "threads imported clauses") << "\n";
+            ENSURE(r == (pigeons > holes ? l_false : l_true));
+            if (pigeons > holes)
+                ENSURE(get_stat(ctx, "threads imported clauses") > 0);
+        }
+    }
+}
+
 void tst_smt_context()
 {
     smt_params params;
@@ -34,4 +91,6 @@ void tst_smt_context()
     }
 
     ctx.check();
+
+    tst_parallel_share();
 }
@@ -0,0 +1,76 @@
+/*++
+Copyright (c) 2015 Microsoft Corporation
+
+Module Name:
+
+    stage_tactic.cpp
+
+Abstract:
+
+    A stage is skipped when its goal is the one produced by the last run of
+    a stage with the same history, also after the pipeline is translated to
+    another manager, and the time of the short stages is reported.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "tactic/tactical.h"
+#include "tactic/core/simplify_tactic.h"
+
+static double get_stat(tactic & t, char const * key) {
+    statistics st;
+    t.collect_statistics(st);
+    double r = 0;
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (strcmp(st.get_key(i), key) == 0)
+            r += st.is_uint(i) ? st.get_uint_value(i) : st.get_double_value(i);
+    return r;
+}
+
+static goal_ref mk_goal(ast_manager & m, int k) {
+    arith_util a(m);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_real()), m);
+    expr_ref y(m.mk_const(symbol("y"), a.mk_real()), m);
+    goal_ref g = alloc(goal, m);
+    g->assert_expr(a.mk_gt(a.mk_add(x, a.mk_mul(x, y), a.mk_int(k)), a.mk_int(0)));
+    g->assert_expr(a.mk_le(a.mk_add(y, y), a.mk_int(3)));
+    return g;
+}
+
+// the two simplify stages share a history, the second one gets the goal of the first one
+static tactic * mk_pipeline(ast_manager & m) {
+    stage_history * h = alloc(stage_history, m, "simplify");
+    return and_then(stage_tactic(h, mk_simplify_tactic(m)), stage_tactic(h, mk_simplify_tactic(m)));
+}
+
+static void run(tactic & t, goal_ref const & g) {
+    goal_ref_buffer result;
+    t(g, result);
+    ENSURE(result.size() == 1);
+}
+
+void tst_stage_tactic() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    tactic_ref t = mk_pipeline(m);
+    run(*t, mk_goal(m, 1));
+    ENSURE(get_stat(*t, "simplify stage skipped") == 1);
+    ENSURE(get_stat(*t, "simplify stage input size") > 0);
+    // the stages take less than a millisecond, and their time is still reported
+    ENSURE(get_stat(*t, "simplify stage time") > 0);
+    run(*t, mk_goal(m, 2));
+    ENSURE(get_stat(*t, "simplify stage skipped") == 2);
+
+    // the translated stages share their history as well
+    ast_manager m2;
+    reg_decl_plugins(m2);
+    tactic_ref t2 = t->translate(m2);
+    run(*t2, mk_goal(m2, 1));
+    ENSURE(get_stat(*t2, "simplify stage skipped") == 1);
+    t2 = nullptr;
+
+    t->reset_statistics();
+    run(*t, mk_goal(m, 3));
+    ENSURE(get_stat(*t, "simplify stage skipped") == 1);
+}
@@ -0,0 +1,81 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    mapped_file.cpp
+
+Abstract:
+
+    Read-only view of the contents of a file.
+
+Revision History:
+
+--*/
+#include <fstream>
+#if !defined(_WINDOWS)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "util/mapped_file.h"
+
+static char const g_empty[1] = { 0 };
+
+mapped_file::mapped_file():
+    m_begin(g_empty),
+    m_size(0),
+    m_mapped(false) {
+}
+
+mapped_file::~mapped_file() {
+    close();
+}
+
+void mapped_file::close() {
+#if !defined(_WINDOWS)
+    if (m_mapped)
+        munmap(const_cast<char*>(m_begin), m_size);
+#endif
+    m_begin  = g_empty;
+    m_size   = 0;
+    m_mapped = false;
+    m_buffer.finalize();
+}
+
+bool mapped_file::open(char const * file_name) {
+    close();
+#if !defined(_WINDOWS)
+    int fd = ::open(file_name, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void * p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+#endif
+            ::close(fd);
+            m_begin  = static_cast<char const*>(p);
+            m_size   = static_cast<size_t>(st.st_size);
+            m_mapped = true;
+            return true;
+        }
+    }
+    ::close(fd);
+#endif
+    // empty files, pipes and platforms without mmap
+    std::ifstream in(file_name, std::ios::binary);
+    if (in.bad() || in.fail())
+        return false;
+    char buffer[1 << 16];
+    while (in) {
+        in.read(buffer, sizeof(buffer));
+        m_buffer.append(static_cast<unsigned>(in.gcount()), buffer);
+    }
+    m_begin = m_buffer.empty() ? g_empty : m_buffer.data();
+    m_size  = m_buffer.size();
+    return true;
+}
@@ -0,0 +1,39 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    mapped_file.h
+
+Abstract:
+
+    Read-only view of the contents of a file. The file is memory mapped
+    when the platform supports it, otherwise it is read into a buffer.
+
+Revision History:
+
+--*/
+#pragma once
+#include "util/vector.h"
+
+class mapped_file {
+    char const *  m_begin;
+    size_t        m_size;
+    bool          m_mapped;
+    svector<char> m_buffer;   // contents when the file could not be mapped
+public:
+    mapped_file();
+    ~mapped_file();
+
+    /**
+       \brief Map the file, return false if it cannot be opened.
+    */
+    bool open(char const * file_name);
+
+    void close();
+
+    char const * begin() const { return m_begin; }
+    char const * end() const { return m_begin + m_size; }
+    size_t size() const { return m_size; }
+    bool is_mapped() const { return m_mapped; }
+};